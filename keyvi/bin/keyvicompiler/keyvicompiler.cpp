@@ -38,6 +38,8 @@
 
 #include "keyvi/dictionary/dictionary_compiler.h"
 #include "keyvi/dictionary/dictionary_types.h"
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/qgram_index_compiler.h"
 #include "keyvi/util/configuration.h"
 
 void callback(size_t added, size_t overall, void*) {
@@ -205,6 +207,32 @@ void compile_json(const std::vector<std::string>& input, const std::string& outp
   compile_strings_inner(&compiler, input, output, manifest);
 }
 
+void compile_qgram_index(const std::string& output, const size_t q,
+                         const keyvi::util::parameters_t& value_store_params = keyvi::util::parameters_t()) {
+  keyvi::dictionary::fsa::automata_t fsa(new keyvi::dictionary::fsa::Automata(output));
+  keyvi::dictionary::QGramIndexCompiler compiler(fsa, q, value_store_params);
+
+  compiler.Compile();
+  compiler.WriteToFile(output + ".qgrams");
+}
+
+/** Upper bound for the size of the keys in uncompressed input files, used to size the generator for sorted input. */
+size_t get_expected_size_of_keys(const std::vector<std::string>& inputs) {
+  size_t size = 0;
+  for (auto input_as_string : inputs) {
+    auto input = boost::filesystem::path(input_as_string);
+
+    // compressed input or directories: no estimate, the compiler assumes the worst case
+    if (!boost::filesystem::is_regular_file(input) || input.extension() == ".gz") {
+      return static_cast<size_t>(UINT32_MAX) + 1;
+    }
+
+    size += boost::filesystem::file_size(input);
+  }
+
+  return size;
+}
+
 /** Extracts the parameters. */
 keyvi::util::parameters_t extract_parameters(const boost::program_options::variables_map& vm) {
   keyvi::util::parameters_t ret;
@@ -242,6 +270,12 @@ int main(int argc, char** argv) {
 
   description.add_options()("manifest", boost::program_options::value<std::string>()->default_value({}),
                             "manifest to be embedded");
+  description.add_options()("sorted-input", boost::program_options::bool_switch(),
+                            "input is sorted by key (byte order), stream it into the dictionary with constant memory "
+                            "instead of sorting, fails on unsorted input");
+  description.add_options()("qgram-index", boost::program_options::value<size_t>(),
+                            "build a q-gram index for fuzzy matching with the given q, written to "
+                            "<output-file>.qgrams");
 
   // Declare which options are positional
   boost::program_options::positional_options_description p;
@@ -279,6 +313,13 @@ int main(int argc, char** argv) {
       input_files = vm["input-file"].as<std::vector<std::string>>();
       output_file = vm["output-file"].as<std::string>();
 
+      if (vm["sorted-input"].as<bool>()) {
+        value_store_params[SORTED_INPUT_KEY] = "true";
+        if (value_store_params.count(EXPECTED_SIZE_OF_KEYS_KEY) == 0) {
+          value_store_params[EXPECTED_SIZE_OF_KEYS_KEY] = std::to_string(get_expected_size_of_keys(input_files));
+        }
+      }
+
       if (dictionary_type == "integer") {
         compile_integer(input_files, output_file, manifest, value_store_params);
       } else if (dictionary_type == "string") {
@@ -294,6 +335,10 @@ int main(int argc, char** argv) {
         std::cout << description;
         return 1;
       }
+
+      if (vm.count("qgram-index")) {
+        compile_qgram_index(output_file, vm["qgram-index"].as<size_t>(), value_store_params);
+      }
     } else {
       std::cout << "ERROR: arguments wrong or missing." << std::endl << std::endl;
       std::cout << description;
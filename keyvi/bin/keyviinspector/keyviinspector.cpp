@@ -22,11 +22,23 @@
  *  Created on: May 13, 2014
  *      Author: hendrik
  */
+#include <condition_variable>  // NOLINT
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <ios>
 #include <iostream>
+#include <mutex>  // NOLINT
+#include <sstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
 
 #include <boost/lexical_cast.hpp>
 #include <boost/program_options.hpp>
 
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/dictionary_cursor.h"
 #include "keyvi/dictionary/fsa/automata.h"
 #include "keyvi/dictionary/fsa/entry_iterator.h"
 
@@ -53,6 +65,131 @@ void dump(const std::string& input, const std::string& output, bool keys_only =
   out_stream.close();
 }
 
+// shards per thread, so that threads finishing early pick up remaining shards
+static const size_t SHARDS_PER_THREAD = 32;
+
+// shards per thread that may be dumped ahead of the output, bounds the memory for buffering shards
+static const size_t BUFFERED_SHARDS_PER_THREAD = 2;
+
+void dump_shard(const keyvi::dictionary::Dictionary& dictionary, const std::string& start_key,
+                const std::string& end_key, std::ostream& out_stream, bool keys_only) {
+  keyvi::dictionary::DictionaryCursor cursor = dictionary.GetCursor(end_key);
+  cursor.Seek(start_key);
+
+  for (; !cursor.AtEnd(); cursor.Next()) {
+    out_stream << cursor.GetKey();
+
+    if (!keys_only) {
+      std::string value = cursor.GetValueAsString();
+      if (value.size()) {
+        out_stream << "\t";
+        out_stream << value;
+      }
+    }
+    out_stream << "\n";
+  }
+}
+
+/**
+ * Dump shards of the key space in parallel, the shards are buffered in memory and written in order as soon as they are
+ * complete. Shards are balanced by the fanout of the automaton unless balance_by_key_counts is set, which requires a
+ * traversal of the whole automaton upfront.
+ */
+void dump_sharded(const std::string& input, const std::string& output, bool keys_only, size_t threads,
+                  bool balance_by_key_counts) {
+  keyvi::dictionary::Dictionary dictionary(input);
+
+  if (balance_by_key_counts) {
+    dictionary.ComputeKeyCounts();
+  }
+  const std::vector<std::string> boundaries = dictionary.GetShardBoundaries(threads * SHARDS_PER_THREAD);
+  const size_t max_buffered_shards = threads * BUFFERED_SHARDS_PER_THREAD;
+
+  std::vector<std::string> shards(boundaries.size());
+  std::vector<bool> shards_done(boundaries.size(), false);
+  size_t next_shard = 0;
+  size_t next_shard_to_write = 0;
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable shard_state_changed;
+
+  std::vector<std::thread> workers;
+  for (size_t t = 0; t < threads; ++t) {
+    workers.emplace_back([&]() {
+      try {
+        for (;;) {
+          size_t i;
+          {
+            std::unique_lock<std::mutex> lock(mutex);
+            shard_state_changed.wait(lock, [&]() {
+              return error || next_shard == boundaries.size() ||
+                     next_shard < next_shard_to_write + max_buffered_shards;
+            });
+            if (error || next_shard == boundaries.size()) {
+              return;
+            }
+            i = next_shard++;
+          }
+
+          std::ostringstream shard_stream;
+          dump_shard(dictionary, boundaries[i], i + 1 < boundaries.size() ? boundaries[i + 1] : std::string(),
+                     shard_stream, keys_only);
+
+          {
+            std::lock_guard<std::mutex> lock(mutex);
+            shards[i] = shard_stream.str();
+            shards_done[i] = true;
+          }
+          shard_state_changed.notify_all();
+        }
+      } catch (...) {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error) {
+            error = std::current_exception();
+          }
+        }
+        shard_state_changed.notify_all();
+      }
+    });
+  }
+
+  // write the shards in order while the workers proceed
+  std::ofstream out_stream(output);
+  while (next_shard_to_write < boundaries.size()) {
+    std::string shard;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      shard_state_changed.wait(lock, [&]() { return error || shards_done[next_shard_to_write]; });
+      if (error) {
+        break;
+      }
+      shard.swap(shards[next_shard_to_write++]);
+    }
+    shard_state_changed.notify_all();
+
+    out_stream << shard;
+    if (!out_stream.good()) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        error = std::make_exception_ptr(std::ios_base::failure("failed to write " + output));
+      }
+      shard_state_changed.notify_all();
+      break;
+    }
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  out_stream.close();
+  if (error) {
+    std::remove(output.c_str());
+    std::rethrow_exception(error);
+  }
+}
+
 void dump_with_attributes(const std::string& input, const std::string& output) {
   keyvi::dictionary::fsa::automata_t automata(new keyvi::dictionary::fsa::Automata(input.c_str()));
   keyvi::dictionary::fsa::EntryIterator it(automata);
@@ -86,7 +223,9 @@ int main(int argc, char** argv) {
   description.add_options()("help,h", "Display this help message")("version,v", "Display the version number")(
       "input-file,i", boost::program_options::value<std::string>(), "input file")(
       "output-file,o", boost::program_options::value<std::string>(), "output file")(
-      "keys-only,k", "dump only the keys")("statistics,s", "Show statistics of the file");
+      "keys-only,k", "dump only the keys")("statistics,s", "Show statistics of the file")(
+      "threads,t", boost::program_options::value<size_t>()->default_value(1), "number of threads for dumping")(
+      "balance-by-key-counts", "balance the threads by key counts, requires a traversal of the whole dictionary upfront");
 
   // Declare which options are positional
   boost::program_options::positional_options_description p;
@@ -114,7 +253,17 @@ int main(int argc, char** argv) {
     input_file = vm["input-file"].as<std::string>();
     output_file = vm["output-file"].as<std::string>();
 
-    dump(input_file, output_file, key_only);
+    const size_t threads = vm["threads"].as<size_t>();
+    if (threads > 1) {
+      try {
+        dump_sharded(input_file, output_file, key_only, threads, vm.count("balance-by-key-counts") > 0);
+      } catch (const std::exception& e) {
+        std::cout << "ERROR: " << e.what() << std::endl;
+        return 1;
+      }
+    } else {
+      dump(input_file, output_file, key_only);
+    }
     // dump_with_attributes (input_file, output_file);
     return 0;
   }
@@ -0,0 +1,146 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * completion_session.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_COMPLETION_COMPLETION_SESSION_H_
+#define KEYVI_DICTIONARY_COMPLETION_COMPLETION_SESSION_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "keyvi/dictionary/completion/prefix_completion.h"
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/match_iterator.h"
+#include "keyvi/dictionary/util/utf8_utils.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace completion {
+
+/**
+ * Incremental completion for type-ahead.
+ *
+ * The session keeps the state reached after every byte of the query, so appending a character costs a single
+ * transition and deleting characters costs nothing, instead of walking the whole query on every keystroke.
+ *
+ * Fuzzy completion is not offered, its state depends on every explored candidate, use PrefixCompletion instead.
+ */
+class CompletionSession final {
+ public:
+  explicit CompletionSession(dictionary_t d) : fsa_(d->GetFsa()), prefix_completion_(d) {
+    states_.push_back(fsa_->GetStartState());
+  }
+
+  /**
+   * Append text to the query.
+   *
+   * @param text the text to append
+   */
+  void Append(const std::string& text) {
+    for (const char c : text) {
+      const uint64_t state = states_.back();
+      states_.push_back(state ? fsa_->TryWalkTransition(state, c) : 0);
+      query_.push_back(c);
+    }
+
+    TRACE("query %s state %d", query_.c_str(), states_.back());
+  }
+
+  /**
+   * Remove the last code point from the query.
+   *
+   * @return false if the query was already empty
+   */
+  bool Backspace() {
+    if (query_.empty()) {
+      return false;
+    }
+
+    size_t length = query_.size() - 1;
+    while (length > 0 && !util::Utf8Utils::IsLeadByte(query_[length])) {
+      --length;
+    }
+
+    Truncate(length);
+    return true;
+  }
+
+  /**
+   * Set the query, only the part which differs from the current query is walked.
+   *
+   * @param query the new query
+   */
+  void SetQuery(const std::string& query) {
+    const size_t common_prefix =
+        std::mismatch(query_.begin(), query_.begin() + std::min(query_.size(), query.size()), query.begin()).first -
+        query_.begin();
+
+    Truncate(common_prefix);
+    Append(query.substr(common_prefix));
+  }
+
+  /**
+   * Reset the session to an empty query.
+   */
+  void Clear() { Truncate(0); }
+
+  const std::string& GetQuery() const { return query_; }
+
+  /**
+   * Whether the current query is a prefix of at least one key.
+   */
+  bool HasCompletions() const { return states_.back() != 0; }
+
+  /**
+   * Get completions for the current query.
+   *
+   * @param number_of_results the number of results
+   */
+  MatchIterator::MatchIteratorPair GetCompletions(size_t number_of_results = 10) {
+    return prefix_completion_.GetCompletionsFromState(query_, states_.back(), number_of_results);
+  }
+
+ private:
+  fsa::automata_t fsa_;
+  PrefixCompletion prefix_completion_;
+  std::string query_;
+  // state after every byte of the query, 0 if the query left the automaton
+  std::vector<uint64_t> states_;
+
+  void Truncate(const size_t length) {
+    query_.resize(length);
+    states_.resize(length + 1);
+  }
+};
+
+} /* namespace completion */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_COMPLETION_COMPLETION_SESSION_H_
@@ -37,6 +37,7 @@
 #include "keyvi/dictionary/fsa/codepoint_state_traverser.h"
 #include "keyvi/dictionary/fsa/traverser_types.h"
 #include "keyvi/dictionary/match_iterator.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 #include "keyvi/stringdistance/levenshtein.h"
 #include "utf8.h"
 
@@ -54,24 +55,39 @@ class PrefixCompletion final {
  public:
   explicit PrefixCompletion(dictionary_t d) : fsa_(d->GetFsa()) {}
 
-  MatchIterator::MatchIteratorPair GetCompletions(const std::string& query, size_t number_of_results = 10) {
+  MatchIterator::MatchIteratorPair GetCompletions(const std::string& query, size_t number_of_results = 10,
+                                                  const util::traversal_budget_t& budget = util::traversal_budget_t()) {
     uint64_t state = fsa_->GetStartState();
     const size_t query_length = query.size();
     size_t depth = 0;
 
-    std::vector<unsigned char> traversal_stack;
-
     while (state != 0 && depth != query_length) {
       state = fsa_->TryWalkTransition(state, query[depth]);
-      traversal_stack.push_back(query[depth]);
       ++depth;
     }
 
+    return GetCompletionsFromState(query, state, number_of_results, budget);
+  }
+
+  /**
+   * Get completions for a query, which has already been walked.
+   *
+   * @param query the query
+   * @param state the state after walking the query, 0 if the query does not match
+   * @param number_of_results the number of results
+   * @param budget optional budget to limit the traversal
+   */
+  MatchIterator::MatchIteratorPair GetCompletionsFromState(
+      const std::string& query, const uint64_t state, size_t number_of_results = 10,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) {
+    const size_t query_length = query.size();
+    std::vector<unsigned char> traversal_stack(query.begin(), query.end());
+
     TRACE("state %d", state);
 
     traversal_stack.reserve(1024);
 
-    if (depth == query_length) {
+    if (state != 0) {
       Match first_match;
       TRACE("matched prefix");
 
@@ -94,10 +110,15 @@ class PrefixCompletion final {
         first_match = Match(0, query_length, query, 0, fsa_, fsa_->GetStateValue(state));
       }
 
-      auto tfunc = [data, query_length]() {
+      auto tfunc = [data, query_length, budget]() {
         TRACE("prefix completion callback called");
 
         for (;;) {
+          if (budget && !budget->VisitState()) {
+            TRACE("budget exhausted, stop traversal");
+            return Match();
+          }
+
           if (data->traverser) {
             data->traversal_stack.resize(query_length + data->traverser.GetDepth() - 1);
             data->traversal_stack.push_back(data->traverser.GetStateLabel());
@@ -127,8 +148,9 @@ class PrefixCompletion final {
     return MatchIterator::EmptyIteratorPair();
   }
 
-  MatchIterator::MatchIteratorPair GetFuzzyCompletions(const std::string& query, const int32_t max_edit_distance,
-                                                       const size_t minimum_exact_prefix = 2) {
+  MatchIterator::MatchIteratorPair GetFuzzyCompletions(
+      const std::string& query, const int32_t max_edit_distance, const size_t minimum_exact_prefix = 2,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) {
     uint64_t state = fsa_->GetStartState();
     size_t depth = 0;
     std::vector<uint32_t> codepoints;
@@ -139,8 +161,6 @@ class PrefixCompletion final {
 
     TRACE("Query: [%s] length: %d", query.c_str(), query_length);
 
-    stringdistance::LevenshteinCompletion metric(codepoints, 20, max_edit_distance);
-
     size_t utf8_depth = 0;
     // match exact
     while (state != 0 && depth != exact_prefix) {
@@ -151,7 +171,6 @@ class PrefixCompletion final {
           break;
         }
       }
-      metric.Put(codepoints[depth], depth);
       ++depth;
     }
 
@@ -159,6 +178,35 @@ class PrefixCompletion final {
       return MatchIterator::EmptyIteratorPair();
     }
 
+    return GetFuzzyCompletionsFromState(query, state, max_edit_distance, exact_prefix, budget);
+  }
+
+ private:
+  fsa::automata_t fsa_;
+
+  /**
+   * Get fuzzy completions for a query, which has already been walked for the exact prefix.
+   *
+   * @param query the query
+   * @param state the state after walking the exact prefix
+   * @param max_edit_distance the maximum edit distance
+   * @param exact_prefix the length of the exact prefix in code points
+   * @param budget optional budget to limit the traversal
+   */
+  MatchIterator::MatchIteratorPair GetFuzzyCompletionsFromState(
+      const std::string& query, const uint64_t state, const int32_t max_edit_distance, const size_t exact_prefix,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) {
+    std::vector<uint32_t> codepoints;
+
+    utf8::unchecked::utf8to32(query.begin(), query.end(), back_inserter(codepoints));
+    const size_t query_length = codepoints.size();
+    const size_t depth = exact_prefix;
+
+    stringdistance::LevenshteinCompletion metric(codepoints, 20, max_edit_distance);
+    for (size_t i = 0; i < exact_prefix; ++i) {
+      metric.Put(codepoints[i], i);
+    }
+
     struct data_delegate_fuzzy {
       data_delegate_fuzzy(fsa::CodePointStateTraverser<fsa::WeightedStateTraverser>&& t,
                           stringdistance::LevenshteinCompletion&& m)
@@ -182,9 +230,14 @@ class PrefixCompletion final {
       first_match = Match(0, query_length, query, 0, fsa_, fsa_->GetStateValue(state));
     }
 
-    auto tfunc = [data, query_length, max_edit_distance, exact_prefix]() {
+    auto tfunc = [data, query_length, max_edit_distance, exact_prefix, budget]() {
       TRACE("prefix completion callback called");
       for (;;) {
+        if (budget && !budget->VisitState()) {
+          TRACE("budget exhausted, stop traversal");
+          return Match();
+        }
+
         if (data->traverser) {
           size_t depth = exact_prefix + data->traverser.GetDepth() - 1;
           TRACE("Current depth %d", depth);
@@ -221,9 +274,6 @@ class PrefixCompletion final {
 
     return MatchIterator::MakeIteratorPair(tfunc, first_match);
   }
-
- private:
-  fsa::automata_t fsa_;
 };
 
 } /* namespace completion */
@@ -31,6 +31,8 @@
 #include <utility>
 #include <vector>
 
+#include "keyvi/dictionary/dictionary_cursor.h"
+#include "keyvi/dictionary/dictionary_set_operation.h"
 #include "keyvi/dictionary/fsa/automata.h"
 #include "keyvi/dictionary/fsa/state_traverser.h"
 #include "keyvi/dictionary/fsa/traverser_types.h"
@@ -40,8 +42,13 @@
 #include "keyvi/dictionary/matching/fuzzy_multiword_completion_matching.h"
 #include "keyvi/dictionary/matching/multiword_completion_matching.h"
 #include "keyvi/dictionary/matching/near_matching.h"
+#include "keyvi/dictionary/matching/normalized_matching.h"
 #include "keyvi/dictionary/matching/prefix_completion_matching.h"
+#include "keyvi/dictionary/matching/regex_matching.h"
+#include "keyvi/dictionary/matching/text_matching.h"
 #include "keyvi/dictionary/util/bounded_priority_queue.h"
+#include "keyvi/dictionary/util/normalization_transducer.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 
 // #define ENABLE_TRACING
 #include "keyvi/dictionary/util/trace.h"
@@ -49,6 +56,10 @@
 namespace keyvi {
 namespace dictionary {
 
+// limits for choosing shard boundaries from the upper levels of the automaton
+static const size_t MAX_SHARD_PREFIX_DEPTH = 4;
+static const size_t SHARD_CANDIDATES_FACTOR = 16;
+
 class Dictionary final {
  public:
   /**
@@ -56,13 +67,40 @@ class Dictionary final {
    *
    * @param filename filename to load keyvi file from.
    * @param loading_strategy optional: Loading strategy to use.
+   * @param loading_parameters optional: parameters for the loading strategy
    */
   explicit Dictionary(const std::string& filename,
-                      loading_strategy_types loading_strategy = loading_strategy_types::lazy)
-      : fsa_(std::make_shared<fsa::Automata>(filename, loading_strategy)) {
+                      loading_strategy_types loading_strategy = loading_strategy_types::lazy,
+                      const keyvi::util::parameters_t& loading_parameters = keyvi::util::parameters_t())
+      : fsa_(std::make_shared<fsa::Automata>(filename, loading_strategy, loading_parameters)) {
     TRACE("Dictionary from file %s", filename.c_str());
   }
 
+  /**
+   * Initialize a dictionary from a buffer holding a complete keyvi file, the buffer is used without copying it.
+   *
+   * @param buffer the start of the keyvi file
+   * @param size the size of the buffer
+   * @param owner optional: an owner of the buffer, kept alive as long as the dictionary
+   */
+  Dictionary(const char* buffer, const size_t size,
+             const std::shared_ptr<const void>& owner = std::shared_ptr<const void>())
+      : fsa_(std::make_shared<fsa::Automata>(buffer, size, owner)) {
+    TRACE("Dictionary from buffer");
+  }
+
+  /**
+   * Initialize a dictionary from a file descriptor.
+   *
+   * @param fd the file descriptor, can be closed after construction
+   * @param offset the offset of the keyvi file
+   * @param size optional: the size of the keyvi file, by default the rest of the file
+   */
+  Dictionary(const int fd, const size_t offset, const size_t size = 0)
+      : fsa_(std::make_shared<fsa::Automata>(fd, offset, size)) {
+    TRACE("Dictionary from file descriptor %d", fd);
+  }
+
   explicit Dictionary(fsa::automata_t f) : fsa_(f) {}
 
   fsa::automata_t GetFsa() const { return fsa_; }
@@ -119,6 +157,121 @@ class Dictionary final {
     return Match(0, text_length, key, 0, fsa_, fsa_->GetStateValue(state));
   }
 
+  /**
+   * Compute the number of keys per state, required for CountPrefix, Rank and Select and used by GetShardBoundaries.
+   *
+   * This is not done implicitly, as it visits every state of the automaton on the calling thread, which takes time in
+   * the order of iterating all keys. The counts stay in memory: 1 bit per bucket of the sparse array plus 8 bytes per
+   * state. Thread-safe, calling it again does nothing.
+   */
+  void ComputeKeyCounts() const { fsa_->ComputeKeyCounts(); }
+
+  /**
+   * Count the keys starting with the given prefix.
+   *
+   * Requires ComputeKeyCounts, the cost is O(|prefix|).
+   *
+   * @param prefix the prefix
+   * @return the number of keys with this prefix
+   */
+  uint64_t CountPrefix(const std::string& prefix) const {
+    uint64_t state = fsa_->GetStartState();
+
+    for (size_t i = 0; i < prefix.size(); ++i) {
+      state = fsa_->TryWalkTransition(state, prefix[i]);
+
+      if (!state) {
+        return 0;
+      }
+    }
+
+    return fsa_->GetKeyCount(state);
+  }
+
+  /**
+   * Get the position of a key in lexicographic order.
+   *
+   * Requires ComputeKeyCounts, the cost is O(|key|) times the number of outgoing transitions per state.
+   *
+   * @param key the key
+   * @return the rank of the key (starting with 0) or -1 if the key is not in the dictionary
+   */
+  int64_t Rank(const std::string& key) const {
+    uint64_t state = fsa_->GetStartState();
+    uint64_t rank = 0;
+    fsa::traversal::TraversalState<> states;
+    fsa::traversal::TraversalPayload<> payload;
+
+    for (size_t i = 0; i < key.size(); ++i) {
+      const unsigned char label = key[i];
+
+      // the prefix itself and all keys starting with a smaller label are smaller
+      if (fsa_->IsFinalState(state)) {
+        ++rank;
+      }
+
+      fsa_->GetOutGoingTransitions(state, &states, &payload);
+      state = 0;
+      for (const auto& transition : states.traversal_state_payload.transitions) {
+        if (transition.label >= label) {
+          state = transition.label == label ? transition.state : 0;
+          break;
+        }
+        rank += fsa_->GetKeyCount(transition.state);
+      }
+
+      if (!state) {
+        return -1;
+      }
+    }
+
+    if (!fsa_->IsFinalState(state)) {
+      return -1;
+    }
+
+    return rank;
+  }
+
+  /**
+   * Get the key at the given position in lexicographic order.
+   *
+   * Requires ComputeKeyCounts, the cost is O(|key|) times the number of outgoing transitions per state.
+   *
+   * @param rank the position (starting with 0)
+   * @return the match or an empty match if rank is out of range
+   */
+  Match Select(uint64_t rank) const {
+    uint64_t state = fsa_->GetStartState();
+    std::string key;
+    fsa::traversal::TraversalState<> states;
+    fsa::traversal::TraversalPayload<> payload;
+
+    if (rank >= fsa_->GetKeyCount(state)) {
+      return Match();
+    }
+
+    for (;;) {
+      if (fsa_->IsFinalState(state)) {
+        if (rank == 0) {
+          return Match(0, key.size(), key, 0, fsa_, fsa_->GetStateValue(state));
+        }
+        --rank;
+      }
+
+      fsa_->GetOutGoingTransitions(state, &states, &payload);
+      for (const auto& transition : states.traversal_state_payload.transitions) {
+        const uint64_t count = fsa_->GetKeyCount(transition.state);
+
+        if (rank < count) {
+          key.push_back(static_cast<char>(transition.label));
+          state = transition.state;
+          break;
+        }
+        rank -= count;
+      }
+    }
+  }
+
   /**
    * Exact Match function.
    *
@@ -159,6 +312,112 @@ class Dictionary final {
     return MatchIterator::MakeIteratorPair(func);
   }
 
+  /**
+   * Get an ordered cursor over the keys, positioned at the first key.
+   *
+   * @param end_key optional: exclusive upper bound, empty for no bound
+   * @return the cursor
+   */
+  DictionaryCursor GetCursor(const std::string& end_key = std::string()) const {
+    return DictionaryCursor(fsa_, end_key);
+  }
+
+  /**
+   * All the items in the range [begin_key, end_key) in lexicographic order.
+   *
+   * @param begin_key the inclusive lower bound
+   * @param end_key the exclusive upper bound, empty for no bound
+   * @return a match iterator of the items in the range
+   */
+  MatchIterator::MatchIteratorPair GetRange(const std::string& begin_key,
+                                            const std::string& end_key = std::string()) const {
+    auto cursor = std::make_shared<DictionaryCursor>(fsa_, end_key);
+    cursor->Seek(begin_key);
+
+    auto func = [cursor]() {
+      cursor->Next();
+      return cursor->GetMatch();
+    };
+
+    return MatchIterator::MakeIteratorPair(func, cursor->GetMatch());
+  }
+
+  /**
+   * Split the key space into shards of similar size, e.g. for iterating in parallel.
+   *
+   * Shards are chosen from the fanout of the upper levels of the automaton, if key counts are available (see
+   * ComputeKeyCounts) they are used for balancing.
+   *
+   * @param number_of_shards the desired number of shards
+   * @return the (inclusive) start keys of the shards in order, shard i ends at the start of shard i + 1, the last shard
+   * is unbounded. Fewer shards than requested are returned for small dictionaries.
+   */
+  std::vector<std::string> GetShardBoundaries(const size_t number_of_shards) const {
+    struct Prefix {
+      std::string key;
+      uint64_t state;
+    };
+
+    const bool use_key_counts = fsa_->HasKeyCounts();
+    std::vector<Prefix> prefixes = {{std::string(), fsa_->GetStartState()}};
+    fsa::traversal::TraversalState<> states;
+    fsa::traversal::TraversalPayload<> payload;
+
+    // expand prefixes level by level until there are enough candidates for balancing
+    for (size_t depth = 0;
+         depth < MAX_SHARD_PREFIX_DEPTH && prefixes.size() < number_of_shards * SHARD_CANDIDATES_FACTOR; ++depth) {
+      std::vector<Prefix> next_prefixes;
+      for (const Prefix& prefix : prefixes) {
+        fsa_->GetOutGoingTransitions(prefix.state, &states, &payload);
+        for (const auto& transition : states.traversal_state_payload.transitions) {
+          next_prefixes.push_back({prefix.key + static_cast<char>(transition.label), transition.state});
+        }
+      }
+
+      if (next_prefixes.empty()) {
+        break;
+      }
+      prefixes.swap(next_prefixes);
+    }
+
+    std::vector<uint64_t> weights;
+    uint64_t total_weight = 0;
+    for (const Prefix& prefix : prefixes) {
+      weights.push_back(use_key_counts ? fsa_->GetKeyCount(prefix.state) : 1);
+      total_weight += weights.back();
+    }
+
+    std::vector<std::string> boundaries = {std::string()};
+    uint64_t weight = 0;
+    for (size_t i = 0; i < prefixes.size(); ++i) {
+      // start a new shard once the current one reached its share
+      if (weight * number_of_shards >= total_weight * boundaries.size() && boundaries.size() < number_of_shards &&
+          !prefixes[i].key.empty()) {
+        boundaries.push_back(prefixes[i].key);
+      }
+      weight += weights[i];
+    }
+
+    return boundaries;
+  }
+
+  /**
+   * All the items in the dictionary split into shards, which can be iterated independently, e.g. on different threads.
+   *
+   * @param number_of_shards the desired number of shards
+   * @return a match iterator per shard, shards are in key order
+   */
+  std::vector<MatchIterator::MatchIteratorPair> GetAllItemsSharded(const size_t number_of_shards) const {
+    const std::vector<std::string> boundaries = GetShardBoundaries(number_of_shards);
+    std::vector<MatchIterator::MatchIteratorPair> shards;
+
+    for (size_t i = 0; i < boundaries.size(); ++i) {
+      shards.push_back(GetRange(boundaries[i], i + 1 < boundaries.size() ? boundaries[i + 1] : std::string()));
+    }
+
+    return shards;
+  }
+
   /**
    * All the items in the dictionary.
    *
@@ -300,6 +559,27 @@ class Dictionary final {
     return MatchIterator::MakeIteratorPair(func);
   }
 
+  /**
+   * Lookup dictionary entries in a text, matches start and end at token boundaries (space).
+   *
+   * Candidate matches of all tokens advance together, candidates in the same state share their transitions and in
+   * leftmost-longest mode candidates within a found match stop early. In the worst case the cost is the same as for
+   * LookupText, see TextMatching.
+   *
+   * @param text the input
+   * @param leftmost_longest if true return non-overlapping leftmost longest matches, otherwise all matches ordered by
+   * end position
+   * @return a match iterator, matches carry their start and end offsets in the text
+   */
+  MatchIterator::MatchIteratorPair LookupTextStreaming(const std::string& text,
+                                                       const bool leftmost_longest = true) const {
+    auto data =
+        std::make_shared<matching::TextMatching>(matching::TextMatching::FromSingleFsa(fsa_, text, leftmost_longest));
+
+    auto func = [data]() { return data->NextMatch(); };
+    return MatchIterator::MakeIteratorPair(func);
+  }
+
   /**
    * Match a key near: Match as much as possible exact given the minimum prefix length and then return everything below.
    *
@@ -308,29 +588,128 @@ class Dictionary final {
    * @param key
    * @param minimum_prefix_length
    * @param greedy if true matches everything below minimum prefix
+   * @param budget optional budget to limit the traversal
    * @return
    */
-  MatchIterator::MatchIteratorPair GetNear(const std::string& key, const size_t minimum_prefix_length,
-                                           const bool greedy = false) const {
+  MatchIterator::MatchIteratorPair GetNear(
+      const std::string& key, const size_t minimum_prefix_length, const bool greedy = false,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
     auto data = std::make_shared<matching::NearMatching<>>(
         matching::NearMatching<>::FromSingleFsa(fsa_, key, minimum_prefix_length, greedy));
+    data->SetBudget(budget);
 
     auto func = [data]() { return data->NextMatch(); };
     return MatchIterator::MakeIteratorPair(func, data->FirstMatch());
   }
 
-  MatchIterator::MatchIteratorPair GetFuzzy(const std::string& query, const int32_t max_edit_distance,
-                                            const size_t minimum_exact_prefix = 2) const {
+  /**
+   * Match all keys within the given edit distance of the query.
+   *
+   * @param query the query
+   * @param max_edit_distance the maximum allowed edit distance
+   * @param minimum_exact_prefix the minimum exact prefix to match before matching approximate
+   * @param budget optional budget to limit the traversal, check it for truncation after iterating
+   * @return a match iterator
+   */
+  MatchIterator::MatchIteratorPair GetFuzzy(
+      const std::string& query, const int32_t max_edit_distance, const size_t minimum_exact_prefix = 2,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
     auto data = std::make_shared<matching::FuzzyMatching<>>(
         matching::FuzzyMatching<>::FromSingleFsa(fsa_, query, max_edit_distance, minimum_exact_prefix));
+    data->SetBudget(budget);
 
     auto func = [data]() { return data->NextMatch(); };
     return MatchIterator::MakeIteratorPair(func, data->FirstMatch());
   }
 
-  MatchIterator::MatchIteratorPair GetPrefixCompletion(const std::string& query) const {
+  /**
+   * Match all keys against a regular expression, the expression must match the complete key.
+   *
+   * Supports a restricted syntax: literals, '.', classes, groups, alternation and quantifiers, see
+   * util::PatternAutomaton.
+   *
+   * @param pattern the regular expression
+   * @param budget optional budget to limit the traversal
+   * @return a match iterator, matches are returned in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetRegex(
+      const std::string& pattern, const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
+    return GetPatternMatches(util::PatternAutomaton::FromRegex(pattern), budget);
+  }
+
+  /**
+   * Match all keys against a glob pattern, e.g. 'foo*bar', supporting '*', '?' and classes.
+   *
+   * @param pattern the glob pattern
+   * @param budget optional budget to limit the traversal
+   * @return a match iterator, matches are returned in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetGlob(
+      const std::string& pattern, const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
+    return GetPatternMatches(util::PatternAutomaton::FromGlob(pattern), budget);
+  }
+
+  /**
+   * Match keys through a normalization transducer, e.g. case-insensitive and/or ignoring diacritics.
+   *
+   * The normalization is applied while traversing, without materializing normalized variants of the keys.
+   *
+   * @param key the key, normalized with the same transducer
+   * @param normalization the normalization transducer
+   * @param budget optional budget to limit the traversal
+   * @return a match iterator over all keys with the same normalized form, in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetNormalized(
+      const std::string& key, const util::normalization_transducer_t& normalization,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
+    return GetNormalizedMatches(key, normalization, 0, false, budget);
+  }
+
+  /**
+   * Check whether the dictionary contains a key with the same normalized form.
+   *
+   * @param key the key, normalized with the same transducer
+   * @param normalization the normalization transducer
+   */
+  bool ContainsNormalized(const std::string& key, const util::normalization_transducer_t& normalization) const {
+    auto matches = GetNormalized(key, normalization);
+    return matches.begin() != matches.end();
+  }
+
+  /**
+   * Complete the given prefix through a normalization transducer.
+   *
+   * @param query the prefix, normalized with the same transducer
+   * @param normalization the normalization transducer
+   * @param budget optional budget to limit the traversal
+   * @return a match iterator over all keys whose normalized form starts with the normalized query
+   */
+  MatchIterator::MatchIteratorPair GetNormalizedPrefixCompletion(
+      const std::string& query, const util::normalization_transducer_t& normalization,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
+    return GetNormalizedMatches(query, normalization, 0, true, budget);
+  }
+
+  /**
+   * Match approximately through a normalization transducer, the edit distance is calculated on the normalized forms.
+   *
+   * @param query the query, normalized with the same transducer
+   * @param normalization the normalization transducer
+   * @param max_edit_distance the maximum allowed edit distance
+   * @param budget optional budget to limit the traversal
+   * @return a match iterator, matches are returned in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetNormalizedFuzzy(
+      const std::string& query, const util::normalization_transducer_t& normalization,
+      const int32_t max_edit_distance, const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
+    return GetNormalizedMatches(query, normalization, max_edit_distance, false, budget);
+  }
+
+  MatchIterator::MatchIteratorPair GetPrefixCompletion(
+      const std::string& query, const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
     auto data = std::make_shared<matching::PrefixCompletionMatching<>>(
         matching::PrefixCompletionMatching<>::FromSingleFsa(fsa_, query));
+    data->SetBudget(budget);
 
     auto func = [data]() { return data->NextMatch(); };
     return MatchIterator::MakeIteratorPair(
@@ -338,9 +717,12 @@ class Dictionary final {
         std::bind(&matching::PrefixCompletionMatching<>::SetMinWeight, &(*data), std::placeholders::_1));
   }
 
-  MatchIterator::MatchIteratorPair GetPrefixCompletion(const std::string& query, size_t top_n) const {
+  MatchIterator::MatchIteratorPair GetPrefixCompletion(
+      const std::string& query, size_t top_n,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
     auto data = std::make_shared<matching::PrefixCompletionMatching<>>(
         matching::PrefixCompletionMatching<>::FromSingleFsa(fsa_, query));
+    data->SetBudget(budget);
 
     auto best_weights = std::make_shared<util::BoundedPriorityQueue<uint32_t>>(top_n);
 
@@ -362,10 +744,12 @@ class Dictionary final {
         std::bind(&matching::PrefixCompletionMatching<>::SetMinWeight, &(*data), std::placeholders::_1));
   }
 
-  MatchIterator::MatchIteratorPair GetMultiwordCompletion(const std::string& query,
-                                                          const unsigned char multiword_separator = 0x1b) const {
+  MatchIterator::MatchIteratorPair GetMultiwordCompletion(
+      const std::string& query, const unsigned char multiword_separator = 0x1b,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
     auto data = std::make_shared<matching::MultiwordCompletionMatching<>>(
         matching::MultiwordCompletionMatching<>::FromSingleFsa(fsa_, query, multiword_separator));
+    data->SetBudget(budget);
 
     auto func = [data]() { return data->NextMatch(); };
     return MatchIterator::MakeIteratorPair(
@@ -373,10 +757,12 @@ class Dictionary final {
         std::bind(&matching::MultiwordCompletionMatching<>::SetMinWeight, &(*data), std::placeholders::_1));
   }
 
-  MatchIterator::MatchIteratorPair GetMultiwordCompletion(const std::string& query, size_t top_n,
-                                                          const unsigned char multiword_separator = 0x1b) const {
+  MatchIterator::MatchIteratorPair GetMultiwordCompletion(
+      const std::string& query, size_t top_n, const unsigned char multiword_separator = 0x1b,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
     auto data = std::make_shared<matching::MultiwordCompletionMatching<>>(
         matching::MultiwordCompletionMatching<>::FromSingleFsa(fsa_, query, multiword_separator));
+    data->SetBudget(budget);
 
     auto best_weights = std::make_shared<util::BoundedPriorityQueue<uint32_t>>(top_n);
 
@@ -398,13 +784,14 @@ class Dictionary final {
         std::bind(&matching::MultiwordCompletionMatching<>::SetMinWeight, &(*data), std::placeholders::_1));
   }
 
-  MatchIterator::MatchIteratorPair GetFuzzyMultiwordCompletion(const std::string& query,
-                                                               const int32_t max_edit_distance,
-                                                               const size_t minimum_exact_prefix = 0,
-                                                               const unsigned char multiword_separator = 0x1b) const {
+  MatchIterator::MatchIteratorPair GetFuzzyMultiwordCompletion(
+      const std::string& query, const int32_t max_edit_distance, const size_t minimum_exact_prefix = 0,
+      const unsigned char multiword_separator = 0x1b,
+      const util::traversal_budget_t& budget = util::traversal_budget_t()) const {
     auto data = std::make_shared<matching::FuzzyMultiwordCompletionMatching<>>(
         matching::FuzzyMultiwordCompletionMatching<>::FromSingleFsa(fsa_, query, max_edit_distance,
                                                                     minimum_exact_prefix, multiword_separator));
+    data->SetBudget(budget);
 
     auto func = [data]() { return data->NextMatch(); };
     return MatchIterator::MakeIteratorPair(
@@ -412,10 +799,80 @@ class Dictionary final {
         std::bind(&matching::FuzzyMultiwordCompletionMatching<>::SetMinWeight, &(*data), std::placeholders::_1));
   }
 
+  /**
+   * Get all keys which are in this and in the other dictionary, values are taken from this dictionary.
+   *
+   * Use DictionarySetOperation for access to the values of both dictionaries.
+   *
+   * @param other the other dictionary
+   * @return a match iterator, matches are returned in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetIntersection(const Dictionary& other) const {
+    return GetSetOperation(other, set_intersection);
+  }
+
+  /**
+   * Get all keys which are in this, but not in the other dictionary.
+   *
+   * @param other the other dictionary
+   * @return a match iterator, matches are returned in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetDifference(const Dictionary& other) const {
+    return GetSetOperation(other, set_difference);
+  }
+
+  /**
+   * Get all keys which are in this or in the other dictionary, for keys in both the value is taken from this
+   * dictionary.
+   *
+   * @param other the other dictionary
+   * @return a match iterator, matches are returned in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetUnion(const Dictionary& other) const {
+    return GetSetOperation(other, set_union);
+  }
+
   std::string GetManifest() const { return fsa_->GetManifest(); }
 
  private:
   fsa::automata_t fsa_;
+
+  MatchIterator::MatchIteratorPair GetSetOperation(const Dictionary& other, const set_operation_types operation) const {
+    auto data = std::make_shared<DictionarySetOperation>(fsa_, other.fsa_, operation);
+
+    auto func = [data]() {
+      if (data->AtEnd()) {
+        return Match();
+      }
+
+      Match m = data->GetMatch();
+      data->Next();
+      return m;
+    };
+    return MatchIterator::MakeIteratorPair(func);
+  }
+
+  MatchIterator::MatchIteratorPair GetNormalizedMatches(const std::string& query,
+                                                        const util::normalization_transducer_t& normalization,
+                                                        const int32_t max_edit_distance, const bool prefix_completion,
+                                                        const util::traversal_budget_t& budget) const {
+    auto data = std::make_shared<matching::NormalizedMatching<>>(matching::NormalizedMatching<>::FromSingleFsa(
+        fsa_, query, normalization, max_edit_distance, prefix_completion));
+    data->SetBudget(budget);
+
+    auto func = [data]() { return data->NextMatch(); };
+    return MatchIterator::MakeIteratorPair(func, data->FirstMatch());
+  }
+
+  MatchIterator::MatchIteratorPair GetPatternMatches(util::PatternAutomaton&& pattern,
+                                                     const util::traversal_budget_t& budget) const {
+    auto data = std::make_shared<matching::RegexMatching<>>(
+        matching::RegexMatching<>::FromSingleFsa(fsa_, std::move(pattern)));
+    data->SetBudget(budget);
+
+    auto func = [data]() { return data->NextMatch(); };
+    return MatchIterator::MakeIteratorPair(func, data->FirstMatch());
+  }
 };
 
 // shared pointer
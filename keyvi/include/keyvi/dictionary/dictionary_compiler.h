@@ -26,27 +26,26 @@
 #define KEYVI_DICTIONARY_DICTIONARY_COMPILER_H_
 
 #include <algorithm>
+#include <cstdint>
+#include <deque>
 #include <functional>
+#include <future>  // NOLINT
 #include <memory>
-#include <queue>
 #include <string>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
-#ifdef _MSC_VER
-// workaround for https://github.com/boostorg/sort/issues/43
-#include <ciso646>
-#endif
-#include <boost/sort/sort.hpp>
-
 #include "keyvi/dictionary/dictionary_compiler_common.h"
 #include "keyvi/dictionary/fsa/automata.h"
 #include "keyvi/dictionary/fsa/generator_adapter.h"
 #include "keyvi/dictionary/fsa/internal/constants.h"
 #include "keyvi/dictionary/fsa/internal/null_value_store.h"
-#include "keyvi/dictionary/fsa/segment_iterator.h"
+#include "keyvi/dictionary/fsa/internal/value_encoding_pool.h"
+#include "keyvi/dictionary/fsa/segment_loser_tree.h"
+#include "keyvi/dictionary/util/string_radix_sort.h"
 #include "keyvi/util/configuration.h"
-#include "keyvi/util/os_utils.h"
+#include "keyvi/util/file_output_stream.h"
 #include "keyvi/util/serialization_utils.h"
 
 // #define ENABLE_TRACING
@@ -95,10 +94,40 @@ class DictionaryCompiler final {
     parallel_sort_threshold_ =
         keyvi::util::mapGet(params_, PARALLEL_SORT_THRESHOLD_KEY, DEFAULT_PARALLEL_SORT_THRESHOLD);
 
+    // chunks built in the background keep their buffers until done and need a generator, so the memory limit is
+    // shared between the buffer for ingestion and for every build its buffer and its generator
+    parallel_chunk_builds_ = keyvi::util::mapGet(params_, PARALLEL_CHUNK_BUILDS_KEY, DEFAULT_PARALLEL_CHUNK_BUILDS);
+    chunk_memory_limit_ = memory_limit_ / (2 * parallel_chunk_builds_ + 1);
+
     value_store_ = new ValueStoreT(params_);
+
+    if constexpr (ValueStoreT::parallel_encoding) {
+      const size_t value_encoding_threads =
+          keyvi::util::mapGet(params_, VALUE_ENCODING_THREADS_KEY, DEFAULT_VALUE_ENCODING_THREADS);
+      if (value_encoding_threads > 0) {
+        value_encoding_pool_ =
+            std::make_unique<fsa::internal::ValueEncodingPool<ValueStoreT>>(value_store_, value_encoding_threads);
+      }
+    }
+
+    sorted_input_ = keyvi::util::mapGetBool(params_, SORTED_INPUT_KEY, false);
+    if (sorted_input_) {
+      // the size of the keys is unknown upfront, without a hint assume the worst case
+      const size_t expected_size_of_keys =
+          keyvi::util::mapGet<size_t>(params_, EXPECTED_SIZE_OF_KEYS_KEY, static_cast<size_t>(UINT32_MAX) + 1);
+
+      generator_ = GeneratorAdapter::template CreateGenerator<
+          keyvi::dictionary::fsa::internal::SparseArrayPersistence<uint16_t>>(expected_size_of_keys, params_,
+                                                                               value_store_);
+    }
   }
 
   ~DictionaryCompiler() {
+    // the builds write into the temporary directory, wait for them even if they failed
+    for (auto& chunk_build : chunk_builds_) {
+      chunk_build.wait();
+    }
+
     if (!generator_) {
       // if generator was not created we have to delete the value store
       // ourselves
@@ -113,15 +142,41 @@ class DictionaryCompiler final {
   DictionaryCompiler(const DictionaryCompiler& that) = delete;
 
   void Add(const std::string& input_key, typename ValueStoreT::value_t value = ValueStoreT::no_value) {
-    if (generator_) {
+    if (feeding_closed_) {
       throw compiler_exception("You're not supposed to add more data once compilation is done!");
     }
 
+    if (sorted_input_) {
+      // like the generator, ignore the empty key
+      if (input_key.size() == 0) {
+        return;
+      }
+
+      if (value_encoding_pool_) {
+        // check the order now, the key is added to the generator once its value is encoded
+        const std::string& last_key = pending_sorted_keys_.empty() ? last_key_ : pending_sorted_keys_.back();
+        if ((has_last_key_ || !pending_sorted_keys_.empty()) && last_key.compare(input_key) > 0) {
+          ThrowUnsortedInput(input_key, last_key);
+        }
+
+        pending_sorted_keys_.push_back(input_key);
+        AddPendingValue(value);
+      } else {
+        AddSorted(input_key, RegisterValue(value));
+      }
+      return;
+    }
+
     size_of_keys_ += input_key.size();
 
-    memory_estimate_ += EstimateMemory(input_key);
-    // no move, we have no ownership
-    key_values_.push_back(key_value_t(input_key, RegisterValue(value)));
+    memory_estimate_ += EstimateArenaMemory(input_key);
+    if (value_encoding_pool_) {
+      // the value handle gets set once the value is encoded
+      key_values_.push_back(arena_key_value_t{key_arena_.Append(input_key), fsa::ValueHandle()});
+      AddPendingValue(value);
+    } else {
+      key_values_.push_back(arena_key_value_t{key_arena_.Append(input_key), RegisterValue(value)});
+    }
     TriggerSortAndChunkGenerationIfNeeded();
   }
 
@@ -129,9 +184,16 @@ class DictionaryCompiler final {
    * Do the final compilation
    */
   void Compile(callback_t progress_callback = nullptr, void* user_data = nullptr) {
+    feeding_closed_ = true;
+    AddPendingValues();
     value_store_->CloseFeeding();
 
-    if (chunk_ == 0) {
+    if (sorted_input_) {
+      if (has_last_key_) {
+        generator_->Add(last_key_, last_value_);
+      }
+      generator_->CloseFeeding();
+    } else if (chunk_ == 0) {
       CompileSingleChunk(progress_callback, user_data);
     } else {
       CompileByMergingChunks(progress_callback, user_data);
@@ -156,7 +218,7 @@ class DictionaryCompiler final {
   }
 
   void Write(std::ostream& stream) {
-    if (!generator_) {
+    if (!feeding_closed_) {
       throw compiler_exception("not compiled yet");
     }
 
@@ -164,11 +226,11 @@ class DictionaryCompiler final {
   }
 
   void WriteToFile(const std::string& filename) {
-    if (!generator_) {
+    if (!feeding_closed_) {
       throw compiler_exception("not compiled yet");
     }
 
-    std::ofstream out_stream = keyvi::util::OsUtils::OpenOutFileStream(filename);
+    keyvi::util::FileOutputStream out_stream(filename);
 
     generator_->Write(out_stream);
     out_stream.close();
@@ -176,27 +238,131 @@ class DictionaryCompiler final {
 
  private:
   keyvi::util::parameters_t params_;
-  key_values_t key_values_;
+  util::KeyArena key_arena_;
+  arena_key_values_t key_values_;
   ValueStoreT* value_store_;
   typename GeneratorAdapter::AdapterPtr generator_;
   std::string manifest_;
   size_t memory_limit_;
+  size_t chunk_memory_limit_;
   size_t memory_estimate_ = 0;
   size_t chunk_ = 0;
   size_t size_of_keys_ = 0;
   size_t parallel_sort_threshold_;
+  size_t parallel_chunk_builds_;
+  std::vector<size_t> common_prefix_lengths_;
+  std::deque<std::future<void>> chunk_builds_;
+  bool feeding_closed_ = false;
+  bool sorted_input_ = false;
+  // in sorted input mode the last key is held back, a following duplicate replaces its value
+  std::string last_key_;
+  fsa::ValueHandle last_value_;
+  bool has_last_key_ = false;
+  std::unique_ptr<fsa::internal::ValueEncodingPool<ValueStoreT>> value_encoding_pool_;
+  // values (and in sorted input mode keys) waiting to be encoded by the pool
+  std::vector<typename ValueStoreT::value_t> pending_values_;
+  std::vector<std::string> pending_sorted_keys_;
   boost::filesystem::path temporary_directory_;
 
-  inline void Sort() {
-    if (key_values_.size() > parallel_sort_threshold_ && parallel_sort_threshold_ != 0) {
-      boost::sort::block_indirect_sort(key_values_.begin(), key_values_.end());
-    } else {
-      std::sort(key_values_.begin(), key_values_.end());
+  inline void AddSorted(const std::string& input_key, const fsa::ValueHandle& handle) {
+    if (has_last_key_) {
+      const int compare = last_key_.compare(input_key);
+
+      if (compare > 0) {
+        ThrowUnsortedInput(input_key, last_key_);
+      }
+
+      if (compare == 0) {
+        TRACE("duplicate key %s, last value wins", input_key.c_str());
+        last_value_ = handle;
+        return;
+      }
+
+      generator_->Add(last_key_, last_value_);
+    }
+
+    last_key_ = input_key;
+    last_value_ = handle;
+    has_last_key_ = true;
+  }
+
+  static void ThrowUnsortedInput(const std::string& input_key, const std::string& last_key) {
+    throw compiler_exception("input is not sorted: \"" + input_key + "\" after \"" + last_key + "\"");
+  }
+
+  inline void AddPendingValue(const typename ValueStoreT::value_t& value) {
+    pending_values_.push_back(value);
+
+    if (pending_values_.size() == VALUE_ENCODING_BATCH_SIZE) {
+      AddPendingValues();
+    }
+  }
+
+  /**
+   * Encode the pending values in parallel and resolve the value handles of their keys.
+   */
+  inline void AddPendingValues() {
+    if constexpr (ValueStoreT::parallel_encoding) {
+      if (pending_values_.empty()) {
+        return;
+      }
+
+      auto value_handle = [this](size_t i, uint64_t value_idx, bool no_minimization) {
+        return fsa::ValueHandle(value_idx, value_store_->GetWeightValue(pending_values_[i]), no_minimization, false);
+      };
+
+      // the pending values belong to the last keys
+      const size_t offset = sorted_input_ ? 0 : key_values_.size() - pending_values_.size();
+      size_t added = 0;
+
+      try {
+        if (sorted_input_) {
+          value_encoding_pool_->AddValues(pending_values_, [this, &value_handle, &added](size_t i, uint64_t value_idx,
+                                                                                         bool no_minimization) {
+            AddSorted(pending_sorted_keys_[i], value_handle(i, value_idx, no_minimization));
+            ++added;
+          });
+        } else {
+          value_encoding_pool_->AddValues(pending_values_, [this, &value_handle, offset, &added](
+                                                               size_t i, uint64_t value_idx, bool no_minimization) {
+            key_values_[offset + i].value = value_handle(i, value_idx, no_minimization);
+            ++added;
+          });
+        }
+      } catch (...) {
+        // drop the added values and the failed one, like with a failed Add it is not part of the dictionary
+        const size_t consumed = std::min(added + 1, pending_values_.size());
+        pending_values_.erase(pending_values_.begin(), pending_values_.begin() + consumed);
+        if (sorted_input_) {
+          pending_sorted_keys_.erase(pending_sorted_keys_.begin(), pending_sorted_keys_.begin() + consumed);
+        } else {
+          key_values_.erase(key_values_.begin() + offset + added);
+        }
+        throw;
+      }
+
+      pending_values_.clear();
+      pending_sorted_keys_.clear();
+    }
+  }
+
+  inline void Sort() { Sort(&key_values_, &common_prefix_lengths_, parallel_sort_threshold_); }
+
+  static void Sort(arena_key_values_t* key_values, std::vector<size_t>* common_prefix_lengths,
+                   const size_t parallel_sort_threshold) {
+    size_t threads = 1;
+    if (key_values->size() > parallel_sort_threshold && parallel_sort_threshold != 0) {
+      threads = std::max(1u, std::thread::hardware_concurrency());
     }
+
+    // the lcp array is passed to the generator, so it does not need to compare keys again
+    util::StringRadixSort::Sort(
+        key_values, [](const arena_key_value_t& key_value) { return util::KeyArena::GetKey(key_value.key); },
+        common_prefix_lengths, threads);
   }
 
   inline void TriggerSortAndChunkGenerationIfNeeded() {
-    if (memory_estimate_ < memory_limit_) {
+    if (memory_estimate_ < chunk_memory_limit_) {
       return;
     }
     CreateChunk();
@@ -204,34 +370,99 @@ class DictionaryCompiler final {
 
   inline void CreateChunk() {
     TRACE("create chunk %ul", key_values_.size());
+    AddPendingValues();
+
     if (chunk_ == 0) {
       boost::filesystem::create_directory(temporary_directory_);
     }
 
-    Sort();
+    boost::filesystem::path filename(temporary_directory_);
+    filename /= "fsa_";
+    filename += std::to_string(chunk_);
+
+    if (parallel_chunk_builds_ == 0) {
+      BuildChunk(params_, parallel_sort_threshold_, filename.string(), &key_values_, &key_arena_);
+    } else {
+      // limit the number of buffers in flight
+      if (chunk_builds_.size() == parallel_chunk_builds_) {
+        WaitForChunkBuild();
+      }
+
+      keyvi::util::parameters_t params = params_;
+      params[MEMORY_LIMIT_KEY] = std::to_string(chunk_memory_limit_);
+
+      // the buffers move to the build, ingestion continues with empty ones
+      chunk_builds_.push_back(std::async(
+          std::launch::async, [params = std::move(params), parallel_sort_threshold = parallel_sort_threshold_,
+                               filename = filename.string(), key_values = std::move(key_values_),
+                               key_arena = std::move(key_arena_)]() mutable {
+            BuildChunk(params, parallel_sort_threshold, filename, &key_values, &key_arena);
+          }));
+      key_values_.clear();
+    }
+
+    memory_estimate_ = 0;
+    ++chunk_;
+  }
+
+  static void BuildChunk(keyvi::util::parameters_t params, const size_t parallel_sort_threshold,
+                         const std::string& filename, arena_key_values_t* key_values, util::KeyArena* key_arena) {
+    std::vector<size_t> common_prefix_lengths;
+    Sort(key_values, &common_prefix_lengths, parallel_sort_threshold);
 
     // disable minimization for faster compile
-    keyvi::util::parameters_t params(params_);
     params[MINIMIZATION_KEY] = "off";
     fsa::Generator<keyvi::dictionary::fsa::internal::SparseArrayPersistence<uint16_t>, fsa::internal::NullValueStore,
                    uint32_t, int32_t>
         generator(params);
 
-    for (const key_value_t& key_value : key_values_) {
-      TRACE("adding to generator: %s", key_value.key.c_str());
-      generator.Add(key_value.key, key_value.value);
+    std::string key;
+    for (size_t i = 0; i < key_values->size(); ++i) {
+      if (SkipDuplicate(*key_values, &common_prefix_lengths, i)) {
+        continue;
+      }
+
+      key.assign(util::KeyArena::GetKey((*key_values)[i].key));
+      TRACE("adding to generator: %s", key.c_str());
+      generator.Add(key, (*key_values)[i].value, common_prefix_lengths[i]);
     }
 
-    key_values_.clear();
-    memory_estimate_ = 0;
+    key_values->clear();
+    key_arena->Clear();
     generator.CloseFeeding();
 
-    boost::filesystem::path filename(temporary_directory_);
-    filename /= "fsa_";
-    filename += std::to_string(chunk_);
-    TRACE("write chunk to %s", filename.string().c_str());
-    generator.WriteToFile(filename.string());
-    ++chunk_;
+    TRACE("write chunk to %s", filename.c_str());
+    generator.WriteToFile(filename);
+  }
+
+  /**
+   * Whether the key at position i is followed by the same key and should be skipped.
+   *
+   * The sort keeps equal keys in insertion order, skipping all but the last one lets the last value win, the same as
+   * for merging chunks and for sorted input. The common prefix length of a skipped key is passed on to the next key.
+   */
+  static inline bool SkipDuplicate(const arena_key_values_t& key_values, std::vector<size_t>* common_prefix_lengths,
+                                   const size_t i) {
+    if (i + 1 == key_values.size()) {
+      return false;
+    }
+
+    const size_t key_size = util::KeyArena::GetKey(key_values[i].key).size();
+    if ((*common_prefix_lengths)[i + 1] != key_size || util::KeyArena::GetKey(key_values[i + 1].key).size() != key_size) {
+      return false;
+    }
+
+    (*common_prefix_lengths)[i + 1] = (*common_prefix_lengths)[i];
+    return true;
+  }
+
+  /**
+   * Wait for the oldest chunk build, rethrows its exception if it failed.
+   */
+  inline void WaitForChunkBuild() {
+    std::future<void> chunk_build = std::move(chunk_builds_.front());
+    chunk_builds_.pop_front();
+    chunk_build.get();
   }
 
   inline void CompileSingleChunk(callback_t progress_callback = nullptr, void* user_data = nullptr) {
@@ -252,16 +483,23 @@ class DictionaryCompiler final {
         callback_trigger = 100000;
       }
 
-      for (const key_value_t& key_value : key_values_) {
-        TRACE("adding to generator: %s", key_value.key.c_str());
+      std::string key;
+      for (size_t i = 0; i < number_of_items; ++i) {
+        if (!SkipDuplicate(key_values_, &common_prefix_lengths_, i)) {
+          key.assign(util::KeyArena::GetKey(key_values_[i].key));
+          TRACE("adding to generator: %s", key.c_str());
+
+          generator_->Add(key, key_values_[i].value, common_prefix_lengths_[i]);
+        }
 
-        generator_->Add(key_value.key, key_value.value);
         ++added_key_values;
         if (progress_callback && (added_key_values % callback_trigger == 0)) {
           progress_callback(added_key_values, number_of_items, user_data);
         }
       }
       key_values_.clear();
+      common_prefix_lengths_.clear();
+      key_arena_.Clear();
     }
     generator_->CloseFeeding();
   }
@@ -276,10 +514,12 @@ class DictionaryCompiler final {
       CreateChunk();
     }
 
-    TRACE("merge chunks");
-    keyvi::util::parameters_t params;
+    while (!chunk_builds_.empty()) {
+      WaitForChunkBuild();
+    }
 
-    std::priority_queue<fsa::SegmentIterator> segments_pqueue;
+    TRACE("merge chunks");
+    std::vector<fsa::EntryIterator> segments;
 
     // add all chunks
     for (size_t i = 0; i < chunk_; ++i) {
@@ -291,10 +531,13 @@ class DictionaryCompiler final {
 
       // todo: make shared
       fsa::automata_t fsa(new fsa::Automata(filename.string()));
-      segments_pqueue.emplace(fsa::EntryIterator(fsa), segments_pqueue.size());
+      segments.emplace_back(fsa);
       number_of_items += fsa->GetNumberOfKeys();
     }
 
+    fsa::SegmentLoserTree segments_tree(segments);
+    segments.clear();
+
     callback_trigger = 1 + (number_of_items - 1) / 100;
 
     if (callback_trigger > 100000) {
@@ -306,45 +549,36 @@ class DictionaryCompiler final {
             size_of_keys_, params_, value_store_);
 
     std::string top_key;
-    while (!segments_pqueue.empty()) {
-      auto segment_it = segments_pqueue.top();
-      segments_pqueue.pop();
-
-      top_key = segment_it.entryIterator().GetKey();
-
-      // check for same keys and merge only the most recent one
-      while (!segments_pqueue.empty() && segments_pqueue.top().entryIterator().operator==(top_key)) {
-        auto to_inc = segments_pqueue.top();
-
-        segments_pqueue.pop();
-        if (++to_inc) {
-          TRACE("push iterator");
-          segments_pqueue.push(to_inc);
-        }
+    while (!segments_tree.Empty()) {
+      const fsa::EntryIterator& top = segments_tree.Top();
+      top_key.assign(top.GetKeyView());
 
-        ++added_key_values;
-        if (progress_callback && (added_key_values % callback_trigger == 0)) {
-          progress_callback(added_key_values, number_of_items, user_data);
-        }
-      }
       fsa::ValueHandle handle;
       handle.no_minimization_ = false;
 
       // get the weight value, for now simple: does not require access to the
       // value store itself
-      handle.weight_ = value_store_->GetMergeWeight(segment_it.entryIterator().GetValueId());
-      handle.value_idx_ = segment_it.entryIterator().GetValueId();
+      handle.weight_ = value_store_->GetMergeWeight(top.GetValueId());
+      handle.value_idx_ = top.GetValueId();
 
       TRACE("Add key: %s", top_key.c_str());
-      generator_->Add(std::move(top_key), handle);
+      generator_->Add(top_key, handle);
 
-      if (++segment_it) {
-        segments_pqueue.push(segment_it);
-      }
+      segments_tree.Next();
       ++added_key_values;
       if (progress_callback && (added_key_values % callback_trigger == 0)) {
         progress_callback(added_key_values, number_of_items, user_data);
       }
+
+      // the most recent chunk wins, skip the same key in older chunks
+      while (!segments_tree.Empty() && segments_tree.Top().GetKeyView() == top_key) {
+        segments_tree.Next();
+
+        ++added_key_values;
+        if (progress_callback && (added_key_values % callback_trigger == 0)) {
+          progress_callback(added_key_values, number_of_items, user_data);
+        }
+      }
     }
 
     // free up disk space as early as possible
@@ -23,6 +23,7 @@
 #include <vector>
 
 #include "keyvi/dictionary/fsa/generator.h"
+#include "keyvi/dictionary/util/key_arena.h"
 
 namespace keyvi {
 namespace dictionary {
@@ -53,6 +54,17 @@ struct key_value_pair {
 
 using key_value_t = key_value_pair<std::string, fsa::ValueHandle>;
 using key_values_t = std::vector<key_value_t>;
+
+/**
+ * structure for internal processing, the key is stored in a util::KeyArena
+ */
+struct arena_key_value {
+  const char* key;
+  fsa::ValueHandle value;
+};
+
+using arena_key_value_t = arena_key_value;
+using arena_key_values_t = std::vector<arena_key_value_t>;
 /**
  * Exception class for generator, thrown when generator is used in the wrong
  * order.
@@ -92,6 +104,16 @@ inline size_t EstimateMemory(const std::string& key) {
   return sizeof(key) + string_size + sizeof(fsa::ValueHandle) + sizeof(key_values_t);
 }
 
+inline size_t EstimateArenaMemory(const std::string& key) {
+  /* memory estimation explained:
+   *   - size of the key in the arena, including its length
+   *   - size for the bucket in the vector (key reference and value handle)
+   *   - size for the bucket in the scratch buffer of the radix sort
+   *   - size for the common prefix length, calculated when sorting
+   */
+  return util::KeyArena::GetEncodedSize(key) + 2 * sizeof(arena_key_value_t) + sizeof(size_t);
+}
+
 } /* namespace dictionary */
 } /* namespace keyvi */
 
@@ -0,0 +1,205 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * dictionary_cursor.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_DICTIONARY_CURSOR_H_
+#define KEYVI_DICTIONARY_DICTIONARY_CURSOR_H_
+
+#include <cstdint>
+#include <string>
+
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/fsa/traversal/traversal_base.h"
+#include "keyvi/dictionary/match.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+
+/**
+ * An ordered cursor over the keys of a dictionary.
+ *
+ * Keys are returned in lexicographic (byte) order. The cursor can be positioned at the first key greater or equal to a
+ * given key in O(|key|), iteration optionally stops at an exclusive end key.
+ */
+class DictionaryCursor final {
+ public:
+  /**
+   * Create a cursor positioned at the first key.
+   *
+   * @param fsa the fsa
+   * @param end_key optional: exclusive upper bound, empty for no bound
+   */
+  explicit DictionaryCursor(const fsa::automata_t& fsa, const std::string& end_key = std::string())
+      : fsa_(fsa), end_key_(end_key) {
+    Seek(std::string());
+  }
+
+  /**
+   * Position the cursor at the first key greater or equal to the given key.
+   *
+   * @param key the key to seek to
+   * @return true if the cursor points to a key, false if there is no such key (within the bound)
+   */
+  bool Seek(const std::string& key) {
+    TRACE("seek %s", key.c_str());
+    Reset();
+
+    for (size_t i = 0; i < key.size(); ++i) {
+      const unsigned char label = key[i];
+      fsa::traversal::TraversalState<>& states = stack_.GetStates();
+
+      // skip all transitions smaller than the label
+      while (states.GetNextState() && states.GetNextTransition() < label) {
+        states++;
+      }
+
+      if (states.GetNextState() == 0 || states.GetNextTransition() != label) {
+        // the key is not a prefix of any key, the next transition leads to the next bigger key
+        return FindNextKey();
+      }
+
+      Descend();
+    }
+
+    if (fsa_->IsFinalState(current_state_)) {
+      return CheckEndKey();
+    }
+
+    return FindNextKey();
+  }
+
+  /**
+   * Move the cursor to the next key.
+   *
+   * @return true if the cursor points to a key, false if the cursor is exhausted
+   */
+  bool Next() {
+    if (at_end_) {
+      return false;
+    }
+
+    return FindNextKey();
+  }
+
+  bool AtEnd() const { return at_end_; }
+
+  /**
+   * Set an exclusive upper bound, empty for no bound.
+   *
+   * Only applies to subsequent calls of Seek and Next.
+   */
+  void SetEndKey(const std::string& end_key) { end_key_ = end_key; }
+
+  const std::string& GetKey() const { return key_; }
+
+  uint64_t GetStateValue() const { return fsa_->GetStateValue(current_state_); }
+
+  std::string GetValueAsString() const { return fsa_->GetValueAsString(GetStateValue()); }
+
+  /**
+   * Get the current key as match.
+   */
+  Match GetMatch() const {
+    if (at_end_) {
+      return Match();
+    }
+
+    return Match(0, key_.size(), key_, 0, fsa_, GetStateValue());
+  }
+
+ private:
+  fsa::automata_t fsa_;
+  std::string end_key_;
+  fsa::traversal::TraversalStack<> stack_;
+  std::string key_;
+  uint64_t current_state_ = 0;
+  bool at_end_ = false;
+
+  void Reset() {
+    at_end_ = false;
+    key_.clear();
+    stack_.traversal_stack_payload.current_depth = 0;
+    current_state_ = fsa_->GetStartState();
+    fsa_->GetOutGoingTransitions(current_state_, &stack_.GetStates(), &stack_.traversal_stack_payload);
+  }
+
+  /**
+   * Follow the next transition at the current depth.
+   */
+  void Descend() {
+    fsa::traversal::TraversalState<>& states = stack_.GetStates();
+    current_state_ = states.GetNextState();
+    key_.push_back(static_cast<char>(states.GetNextTransition()));
+    states++;
+
+    stack_++;
+    fsa_->GetOutGoingTransitions(current_state_, &stack_.GetStates(), &stack_.traversal_stack_payload);
+  }
+
+  /**
+   * Find the next key in depth first order, starting from the current position of the stack.
+   */
+  bool FindNextKey() {
+    for (;;) {
+      if (stack_.GetStates().GetNextState()) {
+        Descend();
+
+        if (fsa_->IsFinalState(current_state_)) {
+          return CheckEndKey();
+        }
+        continue;
+      }
+
+      if (stack_.GetDepth() == 0) {
+        TRACE("cursor exhausted");
+        return SetAtEnd();
+      }
+
+      --stack_;
+      key_.resize(stack_.GetDepth());
+    }
+  }
+
+  bool CheckEndKey() {
+    if (!end_key_.empty() && key_.compare(end_key_) >= 0) {
+      return SetAtEnd();
+    }
+
+    return true;
+  }
+
+  bool SetAtEnd() {
+    at_end_ = true;
+    current_state_ = 0;
+    key_.clear();
+    return false;
+  }
+};
+
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_DICTIONARY_CURSOR_H_
@@ -41,7 +41,7 @@
 #include "keyvi/dictionary/fsa/generator_adapter.h"
 #include "keyvi/dictionary/fsa/internal/constants.h"
 #include "keyvi/util/configuration.h"
-#include "keyvi/util/os_utils.h"
+#include "keyvi/util/file_output_stream.h"
 #include "keyvi/util/serialization_utils.h"
 
 // #define ENABLE_TRACING
@@ -198,7 +198,7 @@ class DictionaryIndexCompiler final {
       throw compiler_exception("not compiled yet");
     }
 
-    std::ofstream out_stream = keyvi::util::OsUtils::OpenOutFileStream(filename);
+    keyvi::util::FileOutputStream out_stream(filename);
 
     generator_->Write(out_stream);
     out_stream.close();
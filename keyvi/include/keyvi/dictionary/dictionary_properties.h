@@ -28,9 +28,11 @@
 #include <cstddef>
 #include <cstdint>
 #include <fstream>
+#include <istream>
 #include <memory>
 #include <string>
 
+#include <boost/interprocess/streams/bufferstream.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "rapidjson/document.h"
@@ -104,14 +106,16 @@ class DictionaryProperties {
       throw std::invalid_argument("dictionary file not found");
     }
 
-    char magic[KEYVI_FILE_MAGIC_LEN];
-    file_stream.read(magic, KEYVI_FILE_MAGIC_LEN);
+    return FromStream(file_name, file_stream);
+  }
 
-    // check magic
-    if (std::strncmp(magic, KEYVI_FILE_MAGIC, KEYVI_FILE_MAGIC_LEN) == 0) {
-      return ReadJsonFormat(file_name, file_stream);
-    }
-    throw std::invalid_argument("not a keyvi file");
+  /**
+   * Read the properties from a buffer holding a complete keyvi file, offsets are relative to the start of the buffer.
+   */
+  static DictionaryProperties FromBuffer(const char* buffer, const size_t size) {
+    boost::interprocess::ibufferstream buffer_stream(buffer, size);
+
+    return FromStream("", buffer_stream);
   }
 
   const std::string& GetFileName() const { return file_name_; }
@@ -233,7 +237,18 @@ class DictionaryProperties {
   fsa::internal::ValueStoreProperties value_store_properties_;
   std::string manifest_;
 
-  static DictionaryProperties ReadJsonFormat(const std::string& file_name, std::ifstream& file_stream) {
+  static DictionaryProperties FromStream(const std::string& file_name, std::istream& stream) {
+    char magic[KEYVI_FILE_MAGIC_LEN] = {};
+    stream.read(magic, KEYVI_FILE_MAGIC_LEN);
+
+    // check magic
+    if (std::strncmp(magic, KEYVI_FILE_MAGIC, KEYVI_FILE_MAGIC_LEN) == 0) {
+      return ReadJsonFormat(file_name, stream);
+    }
+    throw std::invalid_argument("not a keyvi file");
+  }
+
+  static DictionaryProperties ReadJsonFormat(const std::string& file_name, std::istream& file_stream) {
     rapidjson::Document automata_properties;
 
     keyvi::util::SerializationUtils::ReadLengthPrefixedJsonRecord(file_stream, &automata_properties);
@@ -0,0 +1,250 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * dictionary_set_operation.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_DICTIONARY_SET_OPERATION_H_
+#define KEYVI_DICTIONARY_DICTIONARY_SET_OPERATION_H_
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/fsa/traversal/traversal_base.h"
+#include "keyvi/dictionary/match.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+
+enum set_operation_types {
+  set_intersection,  // keys in A and B
+  set_difference,    // keys in A, but not in B
+  set_union,         // keys in A or B
+};
+
+/**
+ * A set operation between the keys of 2 dictionaries, streamed in lexicographic (byte) order.
+ *
+ * Both automata are traversed in lockstep, merging their sorted outgoing transitions. Subtrees that can not contribute
+ * to the result are skipped: for intersection every label missing on one side, for difference every label missing in
+ * A. As the result is ordered, it can be fed directly into a generator without sorting.
+ */
+class DictionarySetOperation final {
+ public:
+  /**
+   * Create a set operation positioned at the first key of the result.
+   *
+   * @param fsa_a the first fsa
+   * @param fsa_b the second fsa
+   * @param operation the set operation
+   */
+  DictionarySetOperation(const fsa::automata_t& fsa_a, const fsa::automata_t& fsa_b,
+                         const set_operation_types operation)
+      : fsa_a_(fsa_a), fsa_b_(fsa_b), operation_(operation) {
+    Push(fsa_a_->GetStartState(), fsa_b_->GetStartState());
+
+    // the empty key is not supported by the automaton, start with the children of the start state
+    Next();
+  }
+
+  /**
+   * Move to the next key of the result.
+   *
+   * @return true if there is a key, false if the result is exhausted
+   */
+  bool Next() {
+    while (depth_ > 0) {
+      Frame& frame = stack_[depth_ - 1];
+
+      if (frame.position == frame.transitions.size()) {
+        --depth_;
+        if (!key_.empty()) {
+          key_.pop_back();
+        }
+        continue;
+      }
+
+      const MergedTransition& transition = frame.transitions[frame.position++];
+      key_.push_back(static_cast<char>(transition.label));
+      state_a_ = transition.state_a;
+      state_b_ = transition.state_b;
+
+      const bool final_a = state_a_ && fsa_a_->IsFinalState(state_a_);
+      const bool final_b = state_b_ && fsa_b_->IsFinalState(state_b_);
+
+      Push(state_a_, state_b_);
+
+      if (IsInResult(final_a, final_b)) {
+        in_a_ = final_a;
+        in_b_ = final_b;
+        return true;
+      }
+    }
+
+    TRACE("set operation exhausted");
+    at_end_ = true;
+    in_a_ = false;
+    in_b_ = false;
+    return false;
+  }
+
+  bool AtEnd() const { return at_end_; }
+
+  const std::string& GetKey() const { return key_; }
+
+  /**
+   * Whether the current key is in A.
+   */
+  bool InA() const { return in_a_; }
+
+  /**
+   * Whether the current key is in B.
+   */
+  bool InB() const { return in_b_; }
+
+  /**
+   * Get the current key as match of A, empty if the key is not in A.
+   */
+  Match GetMatchA() const {
+    if (!in_a_) {
+      return Match();
+    }
+
+    return Match(0, key_.size(), key_, 0, fsa_a_, fsa_a_->GetStateValue(state_a_));
+  }
+
+  /**
+   * Get the current key as match of B, empty if the key is not in B.
+   */
+  Match GetMatchB() const {
+    if (!in_b_) {
+      return Match();
+    }
+
+    return Match(0, key_.size(), key_, 0, fsa_b_, fsa_b_->GetStateValue(state_b_));
+  }
+
+  /**
+   * Get the current key as match, with the value of A if the key is in A, otherwise of B.
+   */
+  Match GetMatch() const { return in_a_ ? GetMatchA() : GetMatchB(); }
+
+ private:
+  struct MergedTransition {
+    unsigned char label;
+    uint64_t state_a;
+    uint64_t state_b;
+  };
+
+  struct Frame {
+    std::vector<MergedTransition> transitions;
+    size_t position = 0;
+  };
+
+  const fsa::automata_t fsa_a_;
+  const fsa::automata_t fsa_b_;
+  const set_operation_types operation_;
+  // frames are reused to keep the allocated transitions
+  std::vector<Frame> stack_;
+  size_t depth_ = 0;
+  std::string key_;
+  uint64_t state_a_ = 0;
+  uint64_t state_b_ = 0;
+  bool in_a_ = false;
+  bool in_b_ = false;
+  bool at_end_ = false;
+
+  fsa::traversal::TraversalState<> states_a_;
+  fsa::traversal::TraversalState<> states_b_;
+  fsa::traversal::TraversalPayload<> payload_;
+
+  bool IsInResult(const bool final_a, const bool final_b) const {
+    switch (operation_) {
+      case set_intersection:
+        return final_a && final_b;
+      case set_difference:
+        return final_a && !final_b;
+      case set_union:
+      default:
+        return final_a || final_b;
+    }
+  }
+
+  /**
+   * Push the merged outgoing transitions of the given state pair, skipping labels that can not contribute.
+   */
+  void Push(const uint64_t state_a, const uint64_t state_b) {
+    if (depth_ == stack_.size()) {
+      stack_.emplace_back();
+    }
+
+    Frame& frame = stack_[depth_++];
+    frame.transitions.clear();
+    frame.position = 0;
+
+    // same automaton and state: equal subtrees, nothing can differ
+    if (operation_ == set_difference && state_a == state_b && fsa_a_ == fsa_b_) {
+      return;
+    }
+
+    states_a_.Clear();
+    states_b_.Clear();
+    if (state_a) {
+      fsa_a_->GetOutGoingTransitions(state_a, &states_a_, &payload_);
+    }
+    if (state_b) {
+      fsa_b_->GetOutGoingTransitions(state_b, &states_b_, &payload_);
+    }
+
+    const auto& transitions_a = states_a_.traversal_state_payload.transitions;
+    const auto& transitions_b = states_b_.traversal_state_payload.transitions;
+    size_t i = 0;
+    size_t j = 0;
+
+    while (i < transitions_a.size() || j < transitions_b.size()) {
+      if (j == transitions_b.size() || (i < transitions_a.size() && transitions_a[i].label < transitions_b[j].label)) {
+        if (operation_ != set_intersection) {
+          frame.transitions.push_back({transitions_a[i].label, transitions_a[i].state, 0});
+        }
+        ++i;
+      } else if (i == transitions_a.size() || transitions_b[j].label < transitions_a[i].label) {
+        if (operation_ == set_union) {
+          frame.transitions.push_back({transitions_b[j].label, 0, transitions_b[j].state});
+        }
+        ++j;
+      } else {
+        frame.transitions.push_back({transitions_a[i].label, transitions_a[i].state, transitions_b[j].state});
+        ++i;
+        ++j;
+      }
+    }
+  }
+};
+
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_DICTIONARY_SET_OPERATION_H_
@@ -25,8 +25,20 @@
 #ifndef KEYVI_DICTIONARY_FSA_AUTOMATA_H_
 #define KEYVI_DICTIONARY_FSA_AUTOMATA_H_
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>  // NOLINT
 #include <memory>
+#include <mutex>  // NOLINT
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <boost/interprocess/file_mapping.hpp>
@@ -34,12 +46,18 @@
 
 #include "keyvi/dictionary/dictionary_merger_fwd.h"
 #include "keyvi/dictionary/dictionary_properties.h"
+#include "keyvi/dictionary/fsa/internal/anonymous_memory_region.h"
+#include "keyvi/dictionary/fsa/internal/background_prefaulter.h"
 #include "keyvi/dictionary/fsa/internal/constants.h"
 #include "keyvi/dictionary/fsa/internal/intrinsics.h"
+#include "keyvi/dictionary/fsa/internal/key_counts.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_flags.h"
+#include "keyvi/dictionary/fsa/internal/page_access_profile.h"
+#include "keyvi/dictionary/fsa/internal/page_cache.h"
 #include "keyvi/dictionary/fsa/internal/value_store_factory.h"
 #include "keyvi/dictionary/fsa/traversal/traversal_base.h"
 #include "keyvi/dictionary/fsa/traversal/weighted_traversal.h"
+#include "keyvi/util/configuration.h"
 
 // #define ENABLE_TRACING
 #include "keyvi/dictionary/util/trace.h"
@@ -72,43 +90,115 @@ static unsigned char OUTGOING_TRANSITIONS_MASK[256] = {
 /// TODO: refactor (split) class Automata, so there is no need for param "loadVS" and friend classes
 class Automata final {
  public:
+  /**
+   * Load an automaton from a file.
+   *
+   * @param file_name the file name of the keyvi file
+   * @param loading_strategy the loading strategy to use
+   * @param loading_parameters optional: parameters for the loading strategy, e.g. the number of threads to use for
+   * populate_background
+   */
   explicit Automata(const std::string& file_name,
-                    loading_strategy_types loading_strategy = loading_strategy_types::lazy)
+                    loading_strategy_types loading_strategy = loading_strategy_types::lazy,
+                    const keyvi::util::parameters_t& loading_parameters = keyvi::util::parameters_t())
       : Automata(std::make_shared<DictionaryProperties>(DictionaryProperties::FromFile(file_name)), loading_strategy,
-                 true) {}
+                 true, loading_parameters) {}
+
+  /**
+   * Load an automaton from a buffer holding a complete keyvi file, e.g. a dictionary received into memory or embedded
+   * into a binary. The buffer is used in place without copying it.
+   *
+   * @param buffer the start of the keyvi file
+   * @param size the size of the buffer
+   * @param owner optional: an owner of the buffer, kept alive as long as the automaton
+   */
+  Automata(const char* buffer, const size_t size,
+           const std::shared_ptr<const void>& owner = std::shared_ptr<const void>())
+      : Automata(Buffer{buffer, size, owner}) {}
+
+  /**
+   * Load an automaton from a file descriptor, e.g. a memfd or a file with several dictionaries packed into it. The
+   * file descriptor can be closed after construction.
+   *
+   * @param fd the file descriptor
+   * @param offset the offset of the keyvi file
+   * @param size optional: the size of the keyvi file, by default the rest of the file, required if other data follows
+   */
+  Automata(const int fd, const size_t offset, const size_t size = 0) : Automata(MapFileDescriptor(fd, offset, size)) {}
 
  private:
+  struct Buffer {
+    const char* address;
+    size_t size;
+    std::shared_ptr<const void> owner;
+  };
+
+  explicit Automata(const Buffer& buffer)
+      : dictionary_properties_(
+            std::make_shared<DictionaryProperties>(DictionaryProperties::FromBuffer(buffer.address, buffer.size))),
+        buffer_owner_(buffer.owner) {
+    const internal::ValueStoreProperties& value_store_properties = dictionary_properties_->GetValueStoreProperties();
+    if (value_store_properties.GetOffset() + value_store_properties.GetSize() > buffer.size) {
+      throw std::invalid_argument("file is corrupt(truncated)");
+    }
+
+    // the buffer is never written to
+    labels_ = reinterpret_cast<unsigned char*>(
+        const_cast<char*>(buffer.address + dictionary_properties_->GetPersistenceOffset()));
+    transitions_compact_ = reinterpret_cast<uint16_t*>(
+        const_cast<char*>(buffer.address + dictionary_properties_->GetTransitionsOffset()));
+
+    value_store_reader_.reset(internal::ValueStoreFactory::MakeReader(dictionary_properties_->GetValueStoreType(),
+                                                                      buffer.address, value_store_properties));
+  }
+
   explicit Automata(const dictionary_properties_t& dictionary_properties, loading_strategy_types loading_strategy,
-                    const bool load_value_store)
+                    const bool load_value_store,
+                    const keyvi::util::parameters_t& loading_parameters = keyvi::util::parameters_t())
       : dictionary_properties_(dictionary_properties) {
     file_mapping_ = boost::interprocess::file_mapping(dictionary_properties_->GetFileName().c_str(),
                                                       boost::interprocess::read_only);
 
-    const boost::interprocess::map_options_t map_options =
-        internal::MemoryMapFlags::FSAGetMemoryMapOptions(loading_strategy);
-
-    TRACE("labels start offset: %d", dictionary_properties_.GetPersistenceOffset());
-    labels_region_ = boost::interprocess::mapped_region(file_mapping_, boost::interprocess::read_only,
-                                                        dictionary_properties_->GetPersistenceOffset(),
-                                                        dictionary_properties_->GetSparseArraySize(), 0, map_options);
-
-    TRACE("transitions start offset: %d", dictionary_properties_.GetTransitionsOffset());
-    transitions_region_ = boost::interprocess::mapped_region(
-        file_mapping_, boost::interprocess::read_only, dictionary_properties_->GetTransitionsOffset(),
-        dictionary_properties_->GetTransitionsSize(), 0, map_options);
-
-    const auto advise = internal::MemoryMapFlags::FSAGetMemoryMapAdvices(loading_strategy);
-
-    labels_region_.advise(advise);
-    transitions_region_.advise(advise);
+    if (loading_strategy == loading_strategy_types::pread ||
+        loading_strategy == loading_strategy_types::pread_value_part) {
+      page_cache_ = std::make_shared<internal::PageCache>(
+          dictionary_properties_->GetFileName(),
+          keyvi::util::mapGetMemory(loading_parameters, PAGE_CACHE_SIZE_KEY, DEFAULT_PAGE_CACHE_SIZE),
+          keyvi::util::mapGetBool(loading_parameters, PAGE_CACHE_DIRECT_IO_KEY, false));
+    }
 
-    labels_ = static_cast<unsigned char*>(labels_region_.get_address());
-    transitions_compact_ = static_cast<uint16_t*>(transitions_region_.get_address());
+    if (loading_strategy == loading_strategy_types::pread) {
+      ReadKeyPart();
+    } else {
+      MapKeyPart(loading_strategy);
+    }
 
     if (load_value_store) {
-      value_store_reader_.reset(
-          internal::ValueStoreFactory::MakeReader(dictionary_properties_->GetValueStoreType(), &file_mapping_,
-                                                  dictionary_properties_->GetValueStoreProperties(), loading_strategy));
+      value_store_reader_.reset(internal::ValueStoreFactory::MakeReader(
+          dictionary_properties_->GetValueStoreType(), &file_mapping_,
+          dictionary_properties_->GetValueStoreProperties(), loading_strategy, page_cache_));
+    }
+
+    switch (loading_strategy) {
+      case loading_strategy_types::lazy_access_profile:
+        ReplayPageAccessProfile();
+        break;
+      case loading_strategy_types::populate_background:
+        StartBackgroundPrefault(loading_parameters);
+        break;
+      case loading_strategy_types::populate_key_part_locked:
+        LockKeyPart();
+        break;
+      case loading_strategy_types::populate_locked:
+        LockKeyPart();
+        LockValuePart();
+        break;
+      case loading_strategy_types::anonymous_key_part:
+        CopyKeyPartToAnonymousMemory(
+            keyvi::util::mapGet<int>(loading_parameters, NUMA_NODE_KEY, internal::NUMA_NODE_ALL));
+        break;
+      default:
+        break;
     }
   }
 
@@ -365,6 +455,45 @@ class Automata final {
     return (transitions_compact_[state + INNER_WEIGHT_TRANSITION_COMPACT]);
   }
 
+  /**
+   * Compute the number of keys reachable from every state, required by GetKeyCount.
+   *
+   * This traverses all states of the automaton twice on the calling thread. The counts take 1 bit per bucket of the
+   * sparse array plus 8 bytes per state, see KeyCounts. Calling it again once the counts exist does nothing.
+   */
+  void ComputeKeyCounts() const {
+    std::call_once(key_counts_computed_, [this]() {
+      std::unique_ptr<internal::KeyCounts> key_counts(new internal::KeyCounts(SparseArraySize()));
+      AddStates(key_counts.get());
+      key_counts->Seal();
+      CountKeys(key_counts.get());
+
+      TRACE("computed key counts for %d states", key_counts->GetNumberOfStates());
+      key_counts_ = std::move(key_counts);
+      has_key_counts_ = true;
+    });
+  }
+
+  /**
+   * Get the number of keys reachable from the given state, including the state itself if it is final.
+   *
+   * Requires ComputeKeyCounts to be called before.
+   *
+   * @param state the state
+   * @return the number of keys
+   */
+  uint64_t GetKeyCount(uint64_t state) const {
+    if (!has_key_counts_) {
+      throw std::logic_error("key counts not available, call ComputeKeyCounts first");
+    }
+    return key_counts_->Get(state);
+  }
+
+  /**
+   * Whether key counts have been computed, so GetKeyCount can be used.
+   */
+  bool HasKeyCounts() const { return has_key_counts_; }
+
   uint32_t GetWeight(uint64_t state) const {
     assert(value_store_reader_);
     return value_store_reader_->GetWeight(state);
@@ -393,6 +522,48 @@ class Automata final {
     return dictionary_properties_->GetManifest();
   }
 
+  /**
+   * Get a future that becomes ready once the automaton is fully loaded.
+   *
+   * For the populate_background loading strategy the future gets ready after the background threads populated key
+   * and value part, for all other loading strategies it is ready immediately.
+   *
+   * @return a shared future
+   */
+  std::shared_future<void> GetLoadingFuture() const {
+    if (prefaulter_) {
+      return prefaulter_->GetFuture();
+    }
+
+    std::promise<void> loaded;
+    loaded.set_value();
+    return loaded.get_future().share();
+  }
+
+  bool IsFullyLoaded() const { return !prefaulter_ || prefaulter_->IsDone(); }
+
+  /**
+   * Sample the pages of this automaton that are currently resident in memory and add them to the given profile.
+   *
+   * Sampling several times over the lifetime of a dictionary accumulates the pages in use, the result can be stored
+   * using PageAccessProfile::GetProfileFileName and gets replayed by the lazy_access_profile loading strategy.
+   *
+   * @param profile the profile to add the sample to
+   */
+  void SamplePageAccessProfile(internal::PageAccessProfile* profile) const {
+    profile->Sample(labels_region_.get_address(), labels_region_.get_size(),
+                    dictionary_properties_->GetPersistenceOffset());
+    profile->Sample(transitions_region_.get_address(), transitions_region_.get_size(),
+                    dictionary_properties_->GetTransitionsOffset());
+
+    const boost::interprocess::mapped_region* values_region =
+        value_store_reader_ ? value_store_reader_->GetMappedRegion() : nullptr;
+    if (values_region) {
+      profile->Sample(values_region->get_address(), values_region->get_size(),
+                      dictionary_properties_->GetValueStoreProperties().GetOffset());
+    }
+  }
+
  private:
   dictionary_properties_t dictionary_properties_;
   std::unique_ptr<internal::IValueStoreReader> value_store_reader_;
@@ -401,6 +572,14 @@ class Automata final {
   boost::interprocess::mapped_region transitions_region_;
   unsigned char* labels_;
   uint16_t* transitions_compact_;
+  std::unique_ptr<internal::AnonymousMemoryRegion> key_part_memory_;
+  std::shared_ptr<internal::PageCache> page_cache_;
+  std::shared_ptr<const void> buffer_owner_;
+  mutable std::once_flag key_counts_computed_;
+  mutable std::unique_ptr<internal::KeyCounts> key_counts_;
+  mutable std::atomic<bool> has_key_counts_{false};
+  // must be declared last, so that threads are stopped before the regions get unmapped
+  std::unique_ptr<internal::BackgroundPrefaulter> prefaulter_;
 
   template <keyvi::dictionary::fsa::internal::value_store_t>
   friend class keyvi::dictionary::DictionaryMerger;
@@ -410,6 +589,225 @@ class Automata final {
     return value_store_reader_.get();
   }
 
+  /**
+   * Add all states reachable from the start state.
+   */
+  void AddStates(internal::KeyCounts* key_counts) const {
+    std::vector<uint64_t> states_to_visit = {GetStartState()};
+    traversal::TraversalStack<> stack;
+
+    key_counts->AddState(GetStartState());
+
+    while (!states_to_visit.empty()) {
+      const uint64_t state = states_to_visit.back();
+      states_to_visit.pop_back();
+
+      GetOutGoingTransitions(state, &stack.GetStates(), &stack.traversal_stack_payload);
+      for (const auto& transition : stack.GetStates().traversal_state_payload.transitions) {
+        if (key_counts->AddState(transition.state)) {
+          states_to_visit.push_back(transition.state);
+        }
+      }
+    }
+  }
+
+  void CountKeys(internal::KeyCounts* key_counts) const {
+    traversal::TraversalStack<> stack;
+    std::vector<uint64_t> path = {GetStartState()};
+
+    GetOutGoingTransitions(GetStartState(), &stack.GetStates(), &stack.traversal_stack_payload);
+
+    // post order traversal, every state is visited once
+    for (;;) {
+      traversal::TraversalState<>& states = stack.GetStates();
+      const uint64_t child = states.GetNextState();
+
+      if (child) {
+        states++;
+        if (!key_counts->IsSet(child)) {
+          path.push_back(child);
+          stack++;
+          GetOutGoingTransitions(child, &stack.GetStates(), &stack.traversal_stack_payload);
+        }
+        continue;
+      }
+
+      uint64_t count = IsFinalState(path.back()) ? 1 : 0;
+      for (const auto& transition : states.traversal_state_payload.transitions) {
+        count += key_counts->Get(transition.state);
+      }
+      key_counts->Set(path.back(), count);
+      path.pop_back();
+
+      if (stack.GetDepth() == 0) {
+        break;
+      }
+      --stack;
+    }
+  }
+
+  static Buffer MapFileDescriptor(const int fd, const size_t offset, size_t size) {
+#if defined(_WIN32)
+    throw std::invalid_argument("loading from a file descriptor is not supported on this platform");
+#else
+    if (size == 0) {
+      struct stat file_stat;
+      if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) <= offset) {
+        throw std::invalid_argument("invalid file descriptor or offset");
+      }
+      size = file_stat.st_size - offset;
+    }
+
+    // mmap requires a page aligned offset
+    const size_t page_size = boost::interprocess::mapped_region::get_page_size();
+    const size_t aligned_offset = offset - (offset % page_size);
+    const size_t mapping_size = size + offset - aligned_offset;
+
+    void* address = mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, fd, aligned_offset);
+    if (address == MAP_FAILED) {
+      throw std::invalid_argument("failed to map file descriptor");
+    }
+
+    std::shared_ptr<const void> mapping(
+        address, [mapping_size](const void* address) { munmap(const_cast<void*>(address), mapping_size); });
+
+    return Buffer{static_cast<const char*>(address) + (offset - aligned_offset), size, mapping};
+#endif
+  }
+
+  void MapKeyPart(loading_strategy_types loading_strategy) {
+    const boost::interprocess::map_options_t map_options =
+        internal::MemoryMapFlags::FSAGetMemoryMapOptions(loading_strategy);
+
+    TRACE("labels start offset: %d", dictionary_properties_.GetPersistenceOffset());
+    labels_region_ = boost::interprocess::mapped_region(file_mapping_, boost::interprocess::read_only,
+                                                        dictionary_properties_->GetPersistenceOffset(),
+                                                        dictionary_properties_->GetSparseArraySize(), 0, map_options);
+
+    TRACE("transitions start offset: %d", dictionary_properties_.GetTransitionsOffset());
+    transitions_region_ = boost::interprocess::mapped_region(
+        file_mapping_, boost::interprocess::read_only, dictionary_properties_->GetTransitionsOffset(),
+        dictionary_properties_->GetTransitionsSize(), 0, map_options);
+
+    const auto advise = internal::MemoryMapFlags::FSAGetMemoryMapAdvices(loading_strategy);
+
+    labels_region_.advise(advise);
+    transitions_region_.advise(advise);
+
+    labels_ = static_cast<unsigned char*>(labels_region_.get_address());
+    transitions_compact_ = static_cast<uint16_t*>(transitions_region_.get_address());
+  }
+
+  /**
+   * Read the key part into anonymous memory using the page cache, bypassing the cache itself.
+   */
+  void ReadKeyPart() {
+    const size_t labels_size = dictionary_properties_->GetSparseArraySize();
+    const size_t transitions_offset = (labels_size + 63) & ~static_cast<size_t>(63);
+    const size_t transitions_size = dictionary_properties_->GetTransitionsSize();
+
+    key_part_memory_.reset(new internal::AnonymousMemoryRegion(transitions_offset + transitions_size));
+
+    char* key_part = static_cast<char*>(key_part_memory_->get_address());
+    page_cache_->ReadUncached(dictionary_properties_->GetPersistenceOffset(), labels_size, key_part);
+    page_cache_->ReadUncached(dictionary_properties_->GetTransitionsOffset(), transitions_size,
+                              key_part + transitions_offset);
+
+    labels_ = reinterpret_cast<unsigned char*>(key_part);
+    transitions_compact_ = reinterpret_cast<uint16_t*>(key_part + transitions_offset);
+  }
+
+  static void LockMemory(const void* address, const size_t size) {
+#if !defined(_WIN32)
+    if (size > 0 && mlock(address, size) != 0) {
+      throw std::runtime_error("failed to lock dictionary in memory, check the limit for locked memory(ulimit -l)");
+    }
+#endif
+  }
+
+  void LockKeyPart() const {
+    LockMemory(labels_region_.get_address(), labels_region_.get_size());
+    LockMemory(transitions_region_.get_address(), transitions_region_.get_size());
+  }
+
+  void LockValuePart() const {
+    const boost::interprocess::mapped_region* values_region =
+        value_store_reader_ ? value_store_reader_->GetMappedRegion() : nullptr;
+    if (values_region) {
+      LockMemory(values_region->get_address(), values_region->get_size());
+    }
+  }
+
+  void CopyKeyPartToAnonymousMemory(const int numa_node) {
+    const size_t labels_size = labels_region_.get_size();
+    // keep the transitions aligned
+    const size_t transitions_offset = (labels_size + 63) & ~static_cast<size_t>(63);
+
+    key_part_memory_.reset(
+        new internal::AnonymousMemoryRegion(transitions_offset + transitions_region_.get_size(), numa_node));
+
+    char* key_part = static_cast<char*>(key_part_memory_->get_address());
+    std::memcpy(key_part, labels_region_.get_address(), labels_size);
+    std::memcpy(key_part + transitions_offset, transitions_region_.get_address(), transitions_region_.get_size());
+
+    labels_ = reinterpret_cast<unsigned char*>(key_part);
+    transitions_compact_ = reinterpret_cast<uint16_t*>(key_part + transitions_offset);
+
+    // the file mapping of the key part is not needed anymore
+    labels_region_ = boost::interprocess::mapped_region();
+    transitions_region_ = boost::interprocess::mapped_region();
+  }
+
+  void StartBackgroundPrefault(const keyvi::util::parameters_t& loading_parameters) {
+    std::vector<internal::BackgroundPrefaulter::Region> regions = {
+        {labels_region_.get_address(), labels_region_.get_size()},
+        {transitions_region_.get_address(), transitions_region_.get_size()}};
+
+    const boost::interprocess::mapped_region* values_region =
+        value_store_reader_ ? value_store_reader_->GetMappedRegion() : nullptr;
+    if (values_region) {
+      regions.push_back({values_region->get_address(), values_region->get_size()});
+    }
+
+    prefaulter_.reset(new internal::BackgroundPrefaulter(
+        regions, keyvi::util::mapGet<size_t>(loading_parameters, PREFAULT_THREADS_KEY, DEFAULT_PREFAULT_THREADS),
+        keyvi::util::mapGet<std::string>(loading_parameters, PREFAULT_IO_PRIORITY_KEY,
+                                         internal::PREFAULT_IO_PRIORITY_DEFAULT)));
+  }
+
+  void ReplayPageAccessProfile() const {
+    const std::string profile_file_name =
+        internal::PageAccessProfile::GetProfileFileName(dictionary_properties_->GetFileName());
+
+    boost::system::error_code error_code;
+    if (!boost::filesystem::exists(profile_file_name, error_code)) {
+      TRACE("no page access profile found, loading lazy");
+      return;
+    }
+
+    // the profile is only a hint, a damaged profile must not prevent loading
+    internal::PageAccessProfile profile;
+    try {
+      const size_t file_size = boost::filesystem::file_size(dictionary_properties_->GetFileName());
+      profile = internal::PageAccessProfile::FromFile(profile_file_name, file_size);
+    } catch (const std::exception& e) {
+      TRACE("failed to read page access profile, loading lazy: %s", e.what());
+      return;
+    }
+
+    profile.Replay(labels_region_.get_address(), labels_region_.get_size(),
+                   dictionary_properties_->GetPersistenceOffset());
+    profile.Replay(transitions_region_.get_address(), transitions_region_.get_size(),
+                   dictionary_properties_->GetTransitionsOffset());
+
+    const boost::interprocess::mapped_region* values_region =
+        value_store_reader_ ? value_store_reader_->GetMappedRegion() : nullptr;
+    if (values_region) {
+      profile.Replay(values_region->get_address(), values_region->get_size(),
+                     dictionary_properties_->GetValueStoreProperties().GetOffset());
+    }
+  }
+
   inline uint64_t ResolvePointer(uint64_t starting_state, unsigned char c) const {
     uint16_t pt = le16toh(transitions_compact_[starting_state + c]);
     uint64_t resolved_ptr;
@@ -29,6 +29,7 @@
 #include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "keyvi/dictionary/fsa/automata.h"
@@ -64,6 +65,13 @@ class EntryIterator final {
     return std::string((const char*)traversal_stack_.data(), GetDepth());
   }
 
+  /**
+   * Get the key without copying it, the view is only valid until the iterator gets advanced.
+   */
+  std::string_view GetKeyView() const {
+    return std::string_view(reinterpret_cast<const char*>(traversal_stack_.data()), GetDepth());
+  }
+
   void WriteKey(std::ostream& stream) const { stream.write((const char*)traversal_stack_.data(), GetDepth()); }
 
   uint64_t GetValueId() const { return current_value_; }
@@ -35,7 +35,7 @@
 #include "keyvi/dictionary/fsa/internal/unpacked_state.h"
 #include "keyvi/dictionary/fsa/internal/unpacked_state_stack.h"
 #include "keyvi/util/configuration.h"
-#include "keyvi/util/os_utils.h"
+#include "keyvi/util/file_output_stream.h"
 #include "keyvi/util/serialization_utils.h"
 
 // #define ENABLE_TRACING
@@ -218,12 +218,21 @@ class Generator final {
    * @param ValueHandle A handle returned by a previous call to RegisterValue
    */
   void Add(const std::string& input_key, const ValueHandle& handle) {
+    Add(input_key, handle, get_common_prefix_length(last_key_, input_key));
+  }
+
+  /**
+   * Add a key and previously inserted value to the generator, with the length of the common prefix with the previous
+   * key already known, e.g. from sorting.
+   * @param input_key The input key.
+   * @param ValueHandle A handle returned by a previous call to RegisterValue
+   * @param commonPrefixLength The length of the longest common prefix of the previous key and the input key.
+   */
+  void Add(const std::string& input_key, const ValueHandle& handle, const size_t commonPrefixLength) {
     if (state_ != generator_state::FEEDING) {
       throw generator_exception("not in feeding state");
     }
 
-    const size_t commonPrefixLength = get_common_prefix_length(last_key_, input_key);
-
     // keys are equal, just return
     if (commonPrefixLength == input_key.size() && last_key_.size() == input_key.size()) {
       return;
@@ -308,7 +317,7 @@ class Generator final {
   }
 
   void WriteToFile(const std::string& filename) {
-    std::ofstream out_stream = keyvi::util::OsUtils::OpenOutFileStream(filename);
+    keyvi::util::FileOutputStream out_stream(filename);
 
     Write(out_stream);
     out_stream.close();
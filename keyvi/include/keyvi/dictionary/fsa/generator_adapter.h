@@ -52,6 +52,7 @@ class GeneratorAdapterInterface {
 
   virtual void Add(const std::string& input_key, ValueT value) {}
   virtual void Add(const std::string& input_key, const fsa::ValueHandle& value) {}
+  virtual void Add(const std::string& input_key, const fsa::ValueHandle& value, size_t common_prefix_length) {}
 
   virtual size_t GetFsaSize() const { return 0; }
   virtual void CloseFeeding() {}
@@ -75,6 +76,10 @@ class GeneratorAdapter final : public GeneratorAdapterInterface<typename ValueSt
 
   void Add(const std::string& input_key, const fsa::ValueHandle& value) { generator_.Add(std::move(input_key), value); }
 
+  void Add(const std::string& input_key, const fsa::ValueHandle& value, size_t common_prefix_length) {
+    generator_.Add(input_key, value, common_prefix_length);
+  }
+
   size_t GetFsaSize() const { return generator_.GetFsaSize(); }
 
   void CloseFeeding() { generator_.CloseFeeding(); }
@@ -0,0 +1,184 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * anonymous_memory_region.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_INTERNAL_ANONYMOUS_MEMORY_REGION_H_
+#define KEYVI_DICTIONARY_FSA_INTERNAL_ANONYMOUS_MEMORY_REGION_H_
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+// use all nodes (interleaved placement)
+static const int NUMA_NODE_ALL = -1;
+
+/**
+ * A region of anonymous memory, optionally placed on a numa node or interleaved across all numa nodes.
+ *
+ * Numa placement is best effort: on systems without numa support or if the system forbids changing the memory policy,
+ * the memory is placed by the OS.
+ */
+class AnonymousMemoryRegion final {
+ public:
+  /**
+   * @param size the size of the region
+   * @param numa_node the node to bind the memory to or NUMA_NODE_ALL for interleaving across all nodes
+   */
+  explicit AnonymousMemoryRegion(const size_t size, const int numa_node = NUMA_NODE_ALL) : size_(size) {
+#if defined(_WIN32)
+    buffer_.resize(size);
+    address_ = buffer_.data();
+#else
+    if (size_ == 0) {
+      return;
+    }
+
+    address_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (address_ == MAP_FAILED) {
+      address_ = nullptr;
+      throw std::runtime_error("failed to allocate anonymous memory");
+    }
+
+    // must happen before the pages get touched
+    try {
+      SetNumaPolicy(numa_node);
+    } catch (const std::invalid_argument&) {
+      munmap(address_, size_);
+      address_ = nullptr;
+      throw;
+    }
+#endif
+  }
+
+  ~AnonymousMemoryRegion() {
+#if !defined(_WIN32)
+    if (address_) {
+      munmap(address_, size_);
+    }
+#endif
+  }
+
+  AnonymousMemoryRegion& operator=(AnonymousMemoryRegion const&) = delete;
+  AnonymousMemoryRegion(const AnonymousMemoryRegion& that) = delete;
+
+  void* get_address() const { return address_; }
+
+  size_t get_size() const { return size_; }
+
+  /**
+   * Get the numa nodes with memory, empty if the system has no numa support.
+   */
+  static std::vector<int> GetNumaNodes() {
+    std::vector<int> nodes;
+#if defined(__linux__)
+    const boost::filesystem::path node_path("/sys/devices/system/node");
+    boost::system::error_code error_code;
+
+    if (!boost::filesystem::is_directory(node_path, error_code)) {
+      return nodes;
+    }
+
+    for (boost::filesystem::directory_iterator it(node_path, error_code), end; it != end; it.increment(error_code)) {
+      const std::string name = it->path().filename().string();
+      if (name.size() > 4 && name.compare(0, 4, "node") == 0 &&
+          name.find_first_not_of("0123456789", 4) == std::string::npos) {
+        nodes.push_back(std::stoi(name.substr(4)));
+      }
+    }
+#endif
+    return nodes;
+  }
+
+ private:
+  void* address_ = nullptr;
+  size_t size_;
+#if defined(_WIN32)
+  std::vector<char> buffer_;
+#endif
+
+  void SetNumaPolicy(const int numa_node) {
+#if defined(__linux__) && defined(SYS_mbind)
+    // constants from numaif.h, which is part of libnuma and therefore not always available
+    static const int mpol_bind = 2;
+    static const int mpol_interleave = 3;
+    static const size_t bits_per_mask = 8 * sizeof(unsigned long);  // NOLINT
+
+    const std::vector<int> nodes = GetNumaNodes();
+    if (nodes.size() < 2) {
+      TRACE("no numa system, skip setting a memory policy");
+      return;
+    }
+
+    int max_node = 0;
+    for (const int node : nodes) {
+      max_node = std::max(max_node, node);
+    }
+
+    if (numa_node != NUMA_NODE_ALL && (numa_node < 0 || numa_node > max_node)) {
+      throw std::invalid_argument("invalid numa node: " + std::to_string(numa_node));
+    }
+
+    std::vector<unsigned long> node_mask((max_node / bits_per_mask) + 1, 0);  // NOLINT
+    if (numa_node == NUMA_NODE_ALL) {
+      for (const int node : nodes) {
+        node_mask[node / bits_per_mask] |= 1UL << (node % bits_per_mask);
+      }
+    } else {
+      node_mask[numa_node / bits_per_mask] |= 1UL << (numa_node % bits_per_mask);
+    }
+
+    const int mode = numa_node == NUMA_NODE_ALL ? mpol_interleave : mpol_bind;
+    if (syscall(SYS_mbind, address_, size_, mode, node_mask.data(), node_mask.size() * bits_per_mask + 1, 0) != 0) {
+      TRACE("mbind failed, memory is placed by the OS");
+    }
+#endif
+  }
+};
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_INTERNAL_ANONYMOUS_MEMORY_REGION_H_
@@ -0,0 +1,199 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * background_prefaulter.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_INTERNAL_BACKGROUND_PREFAULTER_H_
+#define KEYVI_DICTIONARY_FSA_INTERNAL_BACKGROUND_PREFAULTER_H_
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <future>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+static const char PREFAULT_IO_PRIORITY_DEFAULT[] = "default";
+static const char PREFAULT_IO_PRIORITY_LOW[] = "low";
+static const char PREFAULT_IO_PRIORITY_IDLE[] = "idle";
+
+// granularity of work items for the prefault threads
+static const size_t PREFAULT_CHUNK_SIZE = 2 * 1024 * 1024;
+
+/**
+ * Prefaults memory mapped regions on background threads.
+ *
+ * Regions are split into chunks which are processed by a configurable number of threads, the completion can be
+ * observed with a future. Destroying the prefaulter stops the threads after the chunks in progress, so it must be
+ * destroyed before the regions get unmapped.
+ */
+class BackgroundPrefaulter final {
+ public:
+  struct Region {
+    const void* address;
+    size_t size;
+  };
+
+  /**
+   * @param regions the regions to prefault
+   * @param number_of_threads the number of threads to use
+   * @param io_priority the io priority for the threads: "default", "low" or "idle"(linux only, ignored elsewhere)
+   */
+  BackgroundPrefaulter(const std::vector<Region>& regions, const size_t number_of_threads,
+                       const std::string& io_priority = PREFAULT_IO_PRIORITY_DEFAULT)
+      : page_size_(boost::interprocess::mapped_region::get_page_size()),
+        future_(promise_.get_future().share()),
+        io_priority_(io_priority) {
+    for (const Region& region : regions) {
+      if (region.size == 0) {
+        continue;
+      }
+
+      // align to page boundaries, as required by madvise
+      const uintptr_t start = reinterpret_cast<uintptr_t>(region.address);
+      const uintptr_t aligned_start = start - (start % page_size_);
+      const uintptr_t end = start + region.size;
+
+      for (uintptr_t chunk_start = aligned_start; chunk_start < end; chunk_start += PREFAULT_CHUNK_SIZE) {
+        chunks_.push_back(Region{reinterpret_cast<const void*>(chunk_start),
+                                 std::min<size_t>(PREFAULT_CHUNK_SIZE, end - chunk_start)});
+      }
+    }
+
+    const size_t threads = std::max<size_t>(1, std::min(number_of_threads, chunks_.size()));
+    running_threads_ = threads;
+    TRACE("prefault %d chunks using %d threads", chunks_.size(), threads);
+
+    for (size_t i = 0; i < threads; ++i) {
+      workers_.emplace_back(&BackgroundPrefaulter::Run, this);
+    }
+  }
+
+  ~BackgroundPrefaulter() {
+    stop_ = true;
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  BackgroundPrefaulter& operator=(BackgroundPrefaulter const&) = delete;
+  BackgroundPrefaulter(const BackgroundPrefaulter& that) = delete;
+
+  /**
+   * Get a future which becomes ready once all regions are resident.
+   */
+  std::shared_future<void> GetFuture() const { return future_; }
+
+  bool IsDone() const { return future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+ private:
+  const size_t page_size_;
+  std::vector<Region> chunks_;
+  std::atomic<size_t> next_chunk_{0};
+  std::atomic<size_t> running_threads_{0};
+  std::atomic<bool> stop_{false};
+  std::promise<void> promise_;
+  std::shared_future<void> future_;
+  std::string io_priority_;
+  std::vector<std::thread> workers_;
+
+  void Run() {
+    SetIoPriority();
+
+    for (size_t i = next_chunk_++; i < chunks_.size() && !stop_; i = next_chunk_++) {
+      Prefault(chunks_[i]);
+    }
+
+    // the last thread finishing signals completion
+    if (--running_threads_ == 0) {
+      promise_.set_value();
+    }
+  }
+
+  void Prefault(const Region& chunk) const {
+#if defined(MADV_POPULATE_READ)
+    if (madvise(const_cast<void*>(chunk.address), chunk.size, MADV_POPULATE_READ) == 0) {
+      return;
+    }
+#endif
+
+    // fallback: touch every page
+    const volatile char* address = static_cast<const volatile char*>(chunk.address);
+    char sink = 0;
+    for (size_t offset = 0; offset < chunk.size; offset += page_size_) {
+      sink ^= address[offset];
+    }
+    (void)sink;
+  }
+
+  void SetIoPriority() const {
+#if defined(__linux__) && defined(SYS_ioprio_set)
+    // constants from linux/ioprio.h, which is not available everywhere
+    static const int ioprio_class_shift = 13;
+    static const int ioprio_class_be = 2;
+    static const int ioprio_class_idle = 3;
+    static const int ioprio_who_process = 1;
+
+    int ioprio = 0;
+    if (io_priority_ == PREFAULT_IO_PRIORITY_LOW) {
+      ioprio = (ioprio_class_be << ioprio_class_shift) | 7;
+    } else if (io_priority_ == PREFAULT_IO_PRIORITY_IDLE) {
+      ioprio = ioprio_class_idle << ioprio_class_shift;
+    } else {
+      return;
+    }
+
+    // who = 0 refers to the calling thread
+    if (syscall(SYS_ioprio_set, ioprio_who_process, 0, ioprio) != 0) {
+      TRACE("failed to set io priority");
+    }
+#endif
+  }
+};
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_INTERNAL_BACKGROUND_PREFAULTER_H_
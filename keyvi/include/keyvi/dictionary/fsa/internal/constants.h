@@ -70,19 +70,44 @@ static const size_t DEFAULT_MEMORY_LIMIT_VALUE_STORE = 500 * 1024 * 1024;
 
 static const size_t DEFAULT_PARALLEL_SORT_THRESHOLD = 10000;
 
+// default number of chunks the compiler builds in the background while ingesting, 0 builds them synchronously
+static const size_t DEFAULT_PARALLEL_CHUNK_BUILDS = 0;
+
+// default number of threads for encoding values, 0 encodes on the calling thread
+static const size_t DEFAULT_VALUE_ENCODING_THREADS = 0;
+
+// number of values the compiler collects before encoding them in parallel
+static const size_t VALUE_ENCODING_BATCH_SIZE = 4096;
+
 // default for vector values
 static const size_t DEFAULT_VECTOR_SIZE = 10;
 
+// default number of threads for prefaulting in the background
+static const size_t DEFAULT_PREFAULT_THREADS = 2;
+
+// 64MB default size of the page cache for pread based loading
+static const size_t DEFAULT_PAGE_CACHE_SIZE = 64 * 1024 * 1024;
+
 // option key names
 static const char MEMORY_LIMIT_KEY[] = "memory_limit";
+static const char DEDUP_MEMORY_LIMIT_KEY[] = "dedup_memory_limit";
 static const char TEMPORARY_PATH_KEY[] = "temporary_path";
 static const char COMPRESSION_KEY[] = "compression";
 static const char COMPRESSION_THRESHOLD_KEY[] = "compression_threshold";
 static const char MINIMIZATION_KEY[] = "minimization";
 static const char SINGLE_PRECISION_FLOAT_KEY[] = "floating_point_precision";
 static const char PARALLEL_SORT_THRESHOLD_KEY[] = "parallel_sort_threshold";
+static const char PARALLEL_CHUNK_BUILDS_KEY[] = "parallel_chunk_builds";
+static const char VALUE_ENCODING_THREADS_KEY[] = "value_encoding_threads";
 static const char VECTOR_SIZE_KEY[] = "vector_size";
 static const char MERGE_MODE[] = "merge_mode";
 static const char MERGE_APPEND[] = "append";
+static const char PREFAULT_THREADS_KEY[] = "prefault_threads";
+static const char PREFAULT_IO_PRIORITY_KEY[] = "prefault_io_priority";
+static const char NUMA_NODE_KEY[] = "numa_node";
+static const char PAGE_CACHE_SIZE_KEY[] = "page_cache_size";
+static const char PAGE_CACHE_DIRECT_IO_KEY[] = "page_cache_direct_io";
+static const char SORTED_INPUT_KEY[] = "sorted_input";
+static const char EXPECTED_SIZE_OF_KEYS_KEY[] = "expected_size_of_keys";
 
 #endif  // KEYVI_DICTIONARY_FSA_INTERNAL_CONSTANTS_H_
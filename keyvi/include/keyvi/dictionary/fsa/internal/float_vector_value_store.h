@@ -29,6 +29,7 @@
 #include "keyvi/dictionary/fsa/internal/lru_generation_cache.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_flags.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_manager.h"
+#include "keyvi/dictionary/fsa/internal/page_cache.h"
 #include "keyvi/dictionary/fsa/internal/value_store_persistence.h"
 #include "keyvi/dictionary/fsa/internal/value_store_properties.h"
 #include "keyvi/dictionary/fsa/internal/value_store_types.h"
@@ -51,6 +52,7 @@ class FloatVectorValueStoreBase {
  public:
   using value_t = std::vector<float>;
   static const bool inner_weight = false;
+  static const bool parallel_encoding = true;
 
   FloatVectorValueStoreBase() {}
 
@@ -108,6 +110,42 @@ class FloatVectorValueStoreMinimizationBase : public FloatVectorValueStoreBase {
   LeastRecentlyUsedGenerationsCache<RawPointer<>> hash_;
 };
 
+/**
+ * Encodes float vectors: little endian and compression.
+ */
+class FloatVectorValueEncoder final {
+ public:
+  explicit FloatVectorValueEncoder(const keyvi::util::parameters_t& parameters)
+      : size_(keyvi::util::mapGet(parameters, VECTOR_SIZE_KEY, DEFAULT_VECTOR_SIZE)),
+        float_mapped_to_uint32_buffer_(size_) {
+    std::string compressor = keyvi::util::mapGet<std::string>(parameters, COMPRESSION_KEY, {});
+
+    compressor_.reset(compression::compression_strategy(compressor));
+    compress_ = std::bind(static_cast<compression::compress_mem_fn_t>(&compression::CompressionStrategy::Compress),
+                          compressor_.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
+  }
+
+  FloatVectorValueEncoder& operator=(FloatVectorValueEncoder const&) = delete;
+  FloatVectorValueEncoder(const FloatVectorValueEncoder& that) = delete;
+
+  void Encode(const std::vector<float>& value, compression::buffer_t* buffer) {
+    if (value.size() != size_) {
+      throw std::invalid_argument("value must have " + std::to_string(size_) + " dimensions, configure it using the " +
+                                  VECTOR_SIZE_KEY + " parameter");
+    }
+
+    keyvi::util::EncodeFloatVector(compress_, &float_mapped_to_uint32_buffer_, buffer, value);
+  }
+
+  std::string GetCompressorName() const { return compressor_->name(); }
+
+ private:
+  const size_t size_;
+  std::unique_ptr<compression::CompressionStrategy> compressor_;
+  std::function<void(compression::buffer_t*, const char*, size_t)> compress_;
+  std::vector<uint32_t> float_mapped_to_uint32_buffer_;
+};
+
 class FloatVectorValueStore final : public FloatVectorValueStoreMinimizationBase {
  public:
   using typename FloatVectorValueStoreBase::value_t;
@@ -122,33 +160,38 @@ class FloatVectorValueStore final : public FloatVectorValueStoreMinimizationBase
 
  public:
   explicit FloatVectorValueStore(const keyvi::util::parameters_t& parameters = keyvi::util::parameters_t())
-      : FloatVectorValueStoreMinimizationBase(parameters), float_mapped_to_uint32_buffer_(size_) {
-    compression_threshold_ = keyvi::util::mapGet(parameters, COMPRESSION_THRESHOLD_KEY, 32);
-    std::string compressor = keyvi::util::mapGet<std::string>(parameters, COMPRESSION_KEY, {});
+      : FloatVectorValueStoreMinimizationBase(parameters), parameters_(parameters), encoder_(parameters) {
     minimize_ = keyvi::util::mapGetBool(parameters, MINIMIZATION_KEY, true);
-
-    compressor_.reset(compression::compression_strategy(compressor));
-    compress_ = std::bind(static_cast<compression::compress_mem_fn_t>(&compression::CompressionStrategy::Compress),
-                          compressor_.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
   }
 
   uint64_t AddValue(const value_t& value, bool* no_minimization) {
-    if (value.size() != size_) {
-      throw std::invalid_argument("value must have " + std::to_string(size_) + " dimensions, configure it using the " +
-                                  VECTOR_SIZE_KEY + " parameter");
-    }
+    encoder_.Encode(value, &compression_buffer_);
 
-    keyvi::util::EncodeFloatVector(compress_, &float_mapped_to_uint32_buffer_, &compression_buffer_, value);
+    return AddEncodedValue(compression_buffer_.data(), compression_buffer_.size(),
+                           GetValueHashcode(compression_buffer_.data(), compression_buffer_.size()), no_minimization);
+  }
 
+  /**
+   * Create an encoder for encoding values on another thread, see ValueEncodingPool.
+   */
+  std::unique_ptr<FloatVectorValueEncoder> CreateEncoder() const {
+    return std::make_unique<FloatVectorValueEncoder>(parameters_);
+  }
+
+  /**
+   * Add a value encoded by an encoder from CreateEncoder.
+   */
+  uint64_t AddEncodedValue(const char* encoded_value, const size_t encoded_value_size, const int32_t hashcode,
+                           bool* no_minimization) {
     ++number_of_values_;
 
     if (!minimize_) {
       TRACE("Minimization is turned off.");
       *no_minimization = true;
-      return CreateNewValue();
+      return CreateNewValue(encoded_value, encoded_value_size);
     }
 
-    const RawPointerForCompare<MemoryMapManager> stp(compression_buffer_.data(), compression_buffer_.size(),
+    const RawPointerForCompare<MemoryMapManager> stp(encoded_value, encoded_value_size, hashcode,
                                                      values_extern_.get());
     const RawPointer<> p = hash_.Get(stp);
 
@@ -162,17 +205,17 @@ class FloatVectorValueStore final : public FloatVectorValueStoreMinimizationBase
     TRACE("New unique value");
     ++number_of_unique_values_;
 
-    uint64_t pt = CreateNewValue();
+    uint64_t pt = CreateNewValue(encoded_value, encoded_value_size);
 
-    TRACE("add value to hash at %d, length %d", pt, compression_buffer_.size());
-    hash_.Add(RawPointer<>(pt, stp.GetHashcode(), compression_buffer_.size()));
+    TRACE("add value to hash at %d, length %d", pt, encoded_value_size);
+    hash_.Add(RawPointer<>(pt, stp.GetHashcode(), encoded_value_size));
 
     return pt;
   }
 
   void Write(std::ostream& stream) {
     ValueStoreProperties properties(0, values_buffer_size_, number_of_values_, number_of_unique_values_,
-                                    compressor_->name());
+                                    encoder_.GetCompressorName());
 
     properties.WriteAsJsonV2(stream);
     TRACE("Wrote JSON header, stream at %d", stream.tellp());
@@ -181,21 +224,19 @@ class FloatVectorValueStore final : public FloatVectorValueStoreMinimizationBase
   }
 
  private:
-  std::unique_ptr<compression::CompressionStrategy> compressor_;
-  std::function<void(compression::buffer_t*, const char*, size_t)> compress_;
-  size_t compression_threshold_;
+  keyvi::util::parameters_t parameters_;
+  FloatVectorValueEncoder encoder_;
   bool minimize_ = true;
-  std::vector<uint32_t> float_mapped_to_uint32_buffer_;
   compression::buffer_t compression_buffer_;
 
-  uint64_t CreateNewValue() {
+  uint64_t CreateNewValue(const char* encoded_value, const size_t encoded_value_size) {
     uint64_t pt = static_cast<uint64_t>(values_buffer_size_);
     size_t length;
 
-    keyvi::util::encodeVarInt(compression_buffer_.size(), values_extern_.get(), &length);
+    keyvi::util::encodeVarInt(encoded_value_size, values_extern_.get(), &length);
     values_buffer_size_ += length;
-    values_extern_->Append(reinterpret_cast<const void*>(compression_buffer_.data()), compression_buffer_.size());
-    values_buffer_size_ += compression_buffer_.size();
+    values_extern_->Append(reinterpret_cast<const void*>(encoded_value), encoded_value_size);
+    values_buffer_size_ += encoded_value_size;
 
     return pt;
   }
@@ -343,8 +384,14 @@ class FloatVectorValueStoreReader final : public IValueStoreReader {
   using IValueStoreReader::IValueStoreReader;
 
   FloatVectorValueStoreReader(boost::interprocess::file_mapping* file_mapping, const ValueStoreProperties& properties,
-                              loading_strategy_types loading_strategy = loading_strategy_types::lazy)
-      : IValueStoreReader(file_mapping, properties) {
+                              loading_strategy_types loading_strategy = loading_strategy_types::lazy,
+                              const std::shared_ptr<PageCache>& page_cache = std::shared_ptr<PageCache>())
+      : IValueStoreReader(file_mapping, properties), page_cache_(page_cache), values_offset_(properties.GetOffset()) {
+    if (page_cache_) {
+      // values are read through the page cache, no need to map them
+      return;
+    }
+
     const boost::interprocess::map_options_t map_options =
         internal::MemoryMapFlags::ValuesGetMemoryMapOptions(loading_strategy);
 
@@ -358,6 +405,11 @@ class FloatVectorValueStoreReader final : public IValueStoreReader {
     strings_ = (const char*)strings_region_->get_address();
   }
 
+  FloatVectorValueStoreReader(const char* buffer, const ValueStoreProperties& properties)
+      : IValueStoreReader(buffer, properties),
+        strings_(buffer + properties.GetOffset()),
+        values_offset_(properties.GetOffset()) {}
+
   ~FloatVectorValueStoreReader() { delete strings_region_; }
 
   value_store_t GetValueStoreType() const override { return value_store_t::FLOAT_VECTOR; }
@@ -365,19 +417,19 @@ class FloatVectorValueStoreReader final : public IValueStoreReader {
   attributes_t GetValueAsAttributeVector(uint64_t fsa_value) const override {
     attributes_t attributes(new attributes_raw_t());
 
-    std::string raw_value = keyvi::util::decodeVarIntString(strings_ + fsa_value);
+    std::string raw_value = GetPackedValue(fsa_value);
 
     (*attributes)["value"] = raw_value;
     return attributes;
   }
 
   std::string GetRawValueAsString(uint64_t fsa_value) const override {
-    return keyvi::util::decodeVarIntString(strings_ + fsa_value);
+    return GetPackedValue(fsa_value);
   }
 
   std::string GetValueAsString(uint64_t fsa_value) const override {
     TRACE("FloatVectorValueStoreReader GetValueAsString");
-    std::string packed_string = keyvi::util::decodeVarIntString(strings_ + fsa_value);
+    std::string packed_string = GetPackedValue(fsa_value);
 
     return keyvi::util::FloatVectorAsString(keyvi::util::DecodeFloatVector(packed_string), ", ");
   }
@@ -388,11 +440,11 @@ class FloatVectorValueStoreReader final : public IValueStoreReader {
     }
 
     // compare the dimensions of the 1st vector of each value store
-    std::string packed_string = keyvi::util::decodeVarIntString(strings_);
+    std::string packed_string = GetPackedValue(0);
     std::vector<float> v = keyvi::util::DecodeFloatVector(packed_string);
 
     std::string other_packed_string =
-        keyvi::util::decodeVarIntString(dynamic_cast<const FloatVectorValueStoreReader*>(&other)->strings_);
+        dynamic_cast<const FloatVectorValueStoreReader*>(&other)->GetPackedValue(0);
     std::vector<float> other_v = keyvi::util::DecodeFloatVector(other_packed_string);
 
     if (v.size() != other_v.size()) {
@@ -400,9 +452,20 @@ class FloatVectorValueStoreReader final : public IValueStoreReader {
     }
   }
 
+  const boost::interprocess::mapped_region* GetMappedRegion() const override { return strings_region_; }
+
  private:
-  boost::interprocess::mapped_region* strings_region_;
-  const char* strings_;
+  boost::interprocess::mapped_region* strings_region_ = nullptr;
+  const char* strings_ = nullptr;
+  std::shared_ptr<PageCache> page_cache_;
+  size_t values_offset_;
+
+  std::string GetPackedValue(uint64_t fsa_value) const {
+    if (page_cache_) {
+      return page_cache_->ReadVarIntString(values_offset_ + fsa_value);
+    }
+    return keyvi::util::decodeVarIntString(strings_ + fsa_value);
+  }
 
   const char* GetValueStorePayload() const override { return strings_; }
 };
@@ -43,6 +43,7 @@ class IntInnerWeightsValueStoreBase {
  public:
   typedef uint64_t value_t;
   static const bool inner_weight = true;
+  static const bool parallel_encoding = false;
 
   IntInnerWeightsValueStoreBase() {}
 
@@ -43,6 +43,7 @@ class IntValueStoreBase {
  public:
   typedef uint64_t value_t;
   static const bool inner_weight = false;
+  static const bool parallel_encoding = false;
 
   IntValueStoreBase() {}
 
@@ -93,6 +93,14 @@ class IValueStoreReader {
    */
   IValueStoreReader(boost::interprocess::file_mapping* file_mapping, const ValueStoreProperties& properties) {}
 
+  /**
+   * Constructor for reading from a buffer holding the complete keyvi file.
+   *
+   * @param buffer The start of the keyvi file, value store offsets are relative to it
+   * @param properties The dictionary properties
+   */
+  IValueStoreReader(const char* buffer, const ValueStoreProperties& properties) {}
+
   virtual ~IValueStoreReader() {}
 
   virtual value_store_t GetValueStoreType() const = 0;
@@ -150,6 +158,15 @@ class IValueStoreReader {
     }
   }
 
+  /**
+   * Get the memory mapped region of the value store, e.g. for sampling or prefetching pages.
+   *
+   * Value stores without payload return nullptr.
+   *
+   * @return the mapped region or nullptr
+   */
+  virtual const boost::interprocess::mapped_region* GetMappedRegion() const { return nullptr; }
+
  private:
   template <keyvi::dictionary::fsa::internal::value_store_t>
   friend class keyvi::dictionary::DictionaryMerger;
@@ -42,9 +42,10 @@
 #include "keyvi/dictionary/dictionary_properties.h"
 #include "keyvi/dictionary/fsa/internal/constants.h"
 #include "keyvi/dictionary/fsa/internal/ivalue_store.h"
-#include "keyvi/dictionary/fsa/internal/lru_generation_cache.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_flags.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_manager.h"
+#include "keyvi/dictionary/fsa/internal/page_cache.h"
+#include "keyvi/dictionary/fsa/internal/value_deduplication_cache.h"
 #include "keyvi/dictionary/fsa/internal/value_store_persistence.h"
 #include "keyvi/dictionary/fsa/internal/value_store_properties.h"
 #include "keyvi/dictionary/fsa/internal/value_store_types.h"
@@ -65,6 +66,7 @@ class JsonValueStoreBase {
   using value_t = std::string;
   static const std::string no_value;
   static const bool inner_weight = false;
+  static const bool parallel_encoding = true;
 
   JsonValueStoreBase() {}
 
@@ -88,7 +90,7 @@ class JsonValueStoreBase {
 class JsonValueStoreMinimizationBase : public JsonValueStoreBase {
  public:
   explicit JsonValueStoreMinimizationBase(const keyvi::util::parameters_t& parameters)
-      : hash_(keyvi::util::mapGetMemory(parameters, MEMORY_LIMIT_KEY, DEFAULT_MEMORY_LIMIT_VALUE_STORE)) {
+      : hash_(parameters) {
     temporary_directory_ = keyvi::util::mapGetTemporaryPath(parameters);
 
     temporary_directory_ /= boost::filesystem::unique_path("dictionary-fsa-json_value_store-%%%%-%%%%-%%%%-%%%%");
@@ -114,22 +116,25 @@ class JsonValueStoreMinimizationBase : public JsonValueStoreBase {
     hash_.Clear();
   }
 
+  /**
+   * Lookups and hits of the value deduplication.
+   */
+  ValueDeduplicationStatistics GetDeduplicationStatistics() const { return hash_.GetStatistics(); }
+
  protected:
   boost::filesystem::path temporary_directory_;
   std::unique_ptr<MemoryMapManager> values_extern_;
-  LeastRecentlyUsedGenerationsCache<RawPointer<>> hash_;
+  ValueDeduplicationCache hash_;
 };
 
 /**
- * Value store where the value is a json object.
+ * Encodes json values: msgpack and compression.
  */
-class JsonValueStore final : public JsonValueStoreMinimizationBase {
+class JsonValueEncoder final {
  public:
-  explicit JsonValueStore(const keyvi::util::parameters_t& parameters = keyvi::util::parameters_t())
-      : JsonValueStoreMinimizationBase(parameters) {
+  explicit JsonValueEncoder(const keyvi::util::parameters_t& parameters) {
     compression_threshold_ = keyvi::util::mapGet(parameters, COMPRESSION_THRESHOLD_KEY, 32);
     std::string compressor = keyvi::util::mapGet<std::string>(parameters, COMPRESSION_KEY, {});
-    minimize_ = keyvi::util::mapGetBool(parameters, MINIMIZATION_KEY, true);
     std::string float_mode = keyvi::util::mapGet<std::string>(parameters, SINGLE_PRECISION_FLOAT_KEY, {});
 
     if (float_mode == "single") {
@@ -146,23 +151,71 @@ class JsonValueStore final : public JsonValueStoreMinimizationBase {
                   raw_compressor_.get(), std::placeholders::_1, std::placeholders::_2, std::placeholders::_3);
   }
 
+  JsonValueEncoder& operator=(JsonValueEncoder const&) = delete;
+  JsonValueEncoder(const JsonValueEncoder& that) = delete;
+
+  void Encode(const std::string& value, compression::buffer_t* buffer) {
+    keyvi::util::EncodeJsonValue(long_compress_, short_compress_, &msgpack_buffer_, buffer, value,
+                                 single_precision_float_, compression_threshold_);
+  }
+
+  std::string GetCompressorName() const { return compressor_->name(); }
+
+ private:
+  /*
+   * Compressors & the associated compression functions. Ugly, but
+   * needed for EncodeJsonValue.
+   */
+  std::unique_ptr<compression::CompressionStrategy> compressor_;
+  std::unique_ptr<compression::CompressionStrategy> raw_compressor_;
+  std::function<void(compression::buffer_t*, const char*, size_t)> long_compress_;
+  std::function<void(compression::buffer_t*, const char*, size_t)> short_compress_;
+  bool single_precision_float_ = false;
+  size_t compression_threshold_;
+
+  msgpack::sbuffer msgpack_buffer_;
+};
+
+/**
+ * Value store where the value is a json object.
+ */
+class JsonValueStore final : public JsonValueStoreMinimizationBase {
+ public:
+  explicit JsonValueStore(const keyvi::util::parameters_t& parameters = keyvi::util::parameters_t())
+      : JsonValueStoreMinimizationBase(parameters), parameters_(parameters), encoder_(parameters) {
+    minimize_ = keyvi::util::mapGetBool(parameters, MINIMIZATION_KEY, true);
+  }
+
   /**
    * Simple implementation of a value store for json values:
    * todo: performance improvements?
    */
   uint64_t AddValue(const value_t& value, bool* no_minimization) {
-    keyvi::util::EncodeJsonValue(long_compress_, short_compress_, &msgpack_buffer_, &string_buffer_, value,
-                                 single_precision_float_, compression_threshold_);
+    encoder_.Encode(value, &string_buffer_);
+
+    return AddEncodedValue(string_buffer_.data(), string_buffer_.size(),
+                           GetValueHashcode(string_buffer_.data(), string_buffer_.size()), no_minimization);
+  }
+
+  /**
+   * Create an encoder for encoding values on another thread, see ValueEncodingPool.
+   */
+  std::unique_ptr<JsonValueEncoder> CreateEncoder() const { return std::make_unique<JsonValueEncoder>(parameters_); }
 
+  /**
+   * Add a value encoded by an encoder from CreateEncoder.
+   */
+  uint64_t AddEncodedValue(const char* encoded_value, const size_t encoded_value_size, const int32_t hashcode,
+                           bool* no_minimization) {
     ++number_of_values_;
 
     if (!minimize_) {
       TRACE("Minimization is turned off.");
       *no_minimization = true;
-      return CreateNewValue();
+      return CreateNewValue(encoded_value, encoded_value_size);
     }
 
-    const RawPointerForCompare<MemoryMapManager> stp(string_buffer_.data(), string_buffer_.size(),
+    const RawPointerForCompare<MemoryMapManager> stp(encoded_value, encoded_value_size, hashcode,
                                                      values_extern_.get());
     const RawPointer<> p = hash_.Get(stp);
 
@@ -176,17 +229,17 @@ class JsonValueStore final : public JsonValueStoreMinimizationBase {
     TRACE("New unique value");
     ++number_of_unique_values_;
 
-    uint64_t pt = CreateNewValue();
+    uint64_t pt = CreateNewValue(encoded_value, encoded_value_size);
 
-    TRACE("add value to hash at %d, length %d", pt, string_buffer_.size());
-    hash_.Add(RawPointer<>(pt, stp.GetHashcode(), string_buffer_.size()));
+    TRACE("add value to hash at %d, length %d", pt, encoded_value_size);
+    hash_.Add(RawPointer<>(pt, stp.GetHashcode(), encoded_value_size));
 
     return pt;
   }
 
   void Write(std::ostream& stream) {
     ValueStoreProperties properties(0, values_buffer_size_, number_of_values_, number_of_unique_values_,
-                                    compressor_->name());
+                                    encoder_.GetCompressorName());
 
     properties.WriteAsJsonV2(stream);
     TRACE("Wrote JSON header, stream at %d", stream.tellp());
@@ -195,30 +248,21 @@ class JsonValueStore final : public JsonValueStoreMinimizationBase {
   }
 
  private:
-  /*
-   * Compressors & the associated compression functions. Ugly, but
-   * needed for EncodeJsonValue.
-   */
-  std::unique_ptr<compression::CompressionStrategy> compressor_;
-  std::unique_ptr<compression::CompressionStrategy> raw_compressor_;
-  std::function<void(compression::buffer_t*, const char*, size_t)> long_compress_;
-  std::function<void(compression::buffer_t*, const char*, size_t)> short_compress_;
-  bool single_precision_float_ = false;
-  size_t compression_threshold_;
+  keyvi::util::parameters_t parameters_;
+  JsonValueEncoder encoder_;
   bool minimize_ = true;
 
   compression::buffer_t string_buffer_;
-  msgpack::sbuffer msgpack_buffer_;
 
  private:
-  uint64_t CreateNewValue() {
+  uint64_t CreateNewValue(const char* encoded_value, const size_t encoded_value_size) {
     uint64_t pt = static_cast<uint64_t>(values_buffer_size_);
     size_t length;
 
-    keyvi::util::encodeVarInt(string_buffer_.size(), values_extern_.get(), &length);
+    keyvi::util::encodeVarInt(encoded_value_size, values_extern_.get(), &length);
     values_buffer_size_ += length;
-    values_extern_->Append(reinterpret_cast<const void*>(string_buffer_.data()), string_buffer_.size());
-    values_buffer_size_ += string_buffer_.size();
+    values_extern_->Append(reinterpret_cast<const void*>(encoded_value), encoded_value_size);
+    values_buffer_size_ += encoded_value_size;
 
     return pt;
   }
@@ -316,10 +360,16 @@ class JsonValueStoreReader final : public IValueStoreReader {
   using IValueStoreReader::IValueStoreReader;
 
   JsonValueStoreReader(boost::interprocess::file_mapping* file_mapping, const ValueStoreProperties& properties,
-                       loading_strategy_types loading_strategy = loading_strategy_types::lazy)
-      : IValueStoreReader(file_mapping, properties) {
+                       loading_strategy_types loading_strategy = loading_strategy_types::lazy,
+                       const std::shared_ptr<PageCache>& page_cache = std::shared_ptr<PageCache>())
+      : IValueStoreReader(file_mapping, properties), page_cache_(page_cache), values_offset_(properties.GetOffset()) {
     TRACE("JsonValueStoreReader construct");
 
+    if (page_cache_) {
+      // values are read through the page cache, no need to map them
+      return;
+    }
+
     const boost::interprocess::map_options_t map_options =
         internal::MemoryMapFlags::ValuesGetMemoryMapOptions(loading_strategy);
 
@@ -333,6 +383,11 @@ class JsonValueStoreReader final : public IValueStoreReader {
     strings_ = (const char*)strings_region_->get_address();
   }
 
+  JsonValueStoreReader(const char* buffer, const ValueStoreProperties& properties)
+      : IValueStoreReader(buffer, properties),
+        strings_(buffer + properties.GetOffset()),
+        values_offset_(properties.GetOffset()) {}
+
   ~JsonValueStoreReader() { delete strings_region_; }
 
   value_store_t GetValueStoreType() const override { return value_store_t::JSON; }
@@ -340,7 +395,7 @@ class JsonValueStoreReader final : public IValueStoreReader {
   attributes_t GetValueAsAttributeVector(uint64_t fsa_value) const override {
     attributes_t attributes(new attributes_raw_t());
 
-    std::string raw_value = keyvi::util::decodeVarIntString(strings_ + fsa_value);
+    std::string raw_value = GetPackedValue(fsa_value);
 
     // auto length = keyvi::util::decodeVarint((uint8_t*) strings_ + fsa_value);
     // std::string raw_value(strings_ + fsa_value, length);
@@ -350,19 +405,30 @@ class JsonValueStoreReader final : public IValueStoreReader {
   }
 
   std::string GetRawValueAsString(uint64_t fsa_value) const override {
-    return keyvi::util::decodeVarIntString(strings_ + fsa_value);
+    return GetPackedValue(fsa_value);
   }
 
   std::string GetValueAsString(uint64_t fsa_value) const override {
     TRACE("JsonValueStoreReader GetValueAsString");
-    std::string packed_string = keyvi::util::decodeVarIntString(strings_ + fsa_value);
+    std::string packed_string = GetPackedValue(fsa_value);
 
     return keyvi::util::DecodeJsonValue(packed_string);
   }
 
+  const boost::interprocess::mapped_region* GetMappedRegion() const override { return strings_region_; }
+
  private:
-  boost::interprocess::mapped_region* strings_region_;
-  const char* strings_;
+  boost::interprocess::mapped_region* strings_region_ = nullptr;
+  const char* strings_ = nullptr;
+  std::shared_ptr<PageCache> page_cache_;
+  size_t values_offset_;
+
+  std::string GetPackedValue(uint64_t fsa_value) const {
+    if (page_cache_) {
+      return page_cache_->ReadVarIntString(values_offset_ + fsa_value);
+    }
+    return keyvi::util::decodeVarIntString(strings_ + fsa_value);
+  }
 
   const char* GetValueStorePayload() const override { return strings_; }
 };
@@ -0,0 +1,142 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * key_counts.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_INTERNAL_KEY_COUNTS_H_
+#define KEYVI_DICTIONARY_FSA_INTERNAL_KEY_COUNTS_H_
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+/**
+ * Number of keys reachable from a state (including the state itself if it is final).
+ *
+ * As the number only depends on the right language of a state, it is well defined for the minimized automaton. States
+ * are positions in the sparse array, a bit vector over the sparse array with a rank directory numbers them densely, so
+ * the count of a state is found in constant time. This takes 1 bit per bucket of the sparse array, 8 bytes per 512
+ * buckets for the rank directory and 8 bytes per state.
+ */
+class KeyCounts final {
+ public:
+  /**
+   * @param sparse_array_size the size of the sparse array of the automaton
+   */
+  explicit KeyCounts(const size_t sparse_array_size) : states_((sparse_array_size + 63) / 64, 0) {}
+
+  KeyCounts& operator=(KeyCounts const&) = delete;
+  KeyCounts(const KeyCounts& that) = delete;
+
+  /**
+   * Register a state, all states must be added before Seal.
+   *
+   * @return false if the state has been added already
+   */
+  bool AddState(const uint64_t state) {
+    uint64_t& word = states_[state / 64];
+    const uint64_t bit = 1ULL << (state % 64);
+
+    if (word & bit) {
+      return false;
+    }
+
+    word |= bit;
+    return true;
+  }
+
+  /**
+   * Build the rank directory after all states have been added, counts are unset afterwards.
+   */
+  void Seal() {
+    ranks_.reserve(states_.size() / WORDS_PER_RANK + 1);
+
+    uint64_t rank = 0;
+    for (size_t i = 0; i < states_.size(); ++i) {
+      if (i % WORDS_PER_RANK == 0) {
+        ranks_.push_back(rank);
+      }
+      rank += __builtin_popcountll(states_[i]);
+    }
+
+    counts_.assign(rank, UNSET);
+  }
+
+  /**
+   * Get the number of keys reachable from the given state.
+   *
+   * @param state a state of the automaton
+   * @return the number of keys, 0 if the count has not been set yet
+   */
+  uint64_t Get(const uint64_t state) const {
+    const uint64_t count = counts_[Index(state)];
+    return count == UNSET ? 0 : count;
+  }
+
+  /**
+   * Whether a count has been set for the given state.
+   */
+  bool IsSet(const uint64_t state) const { return counts_[Index(state)] != UNSET; }
+
+  void Set(const uint64_t state, const uint64_t count) { counts_[Index(state)] = count; }
+
+  size_t GetNumberOfStates() const { return counts_.size(); }
+
+ private:
+  static constexpr uint64_t UNSET = std::numeric_limits<uint64_t>::max();
+  static const size_t WORDS_PER_RANK = 8;
+
+  std::vector<uint64_t> states_;
+  std::vector<uint64_t> ranks_;
+  std::vector<uint64_t> counts_;
+
+  /**
+   * The dense number of a state: the number of states before it.
+   */
+  size_t Index(const uint64_t state) const {
+    const size_t word = state / 64;
+    assert(states_[word] & (1ULL << (state % 64)));
+
+    size_t index = ranks_[word / WORDS_PER_RANK];
+    for (size_t i = word - word % WORDS_PER_RANK; i < word; ++i) {
+      index += __builtin_popcountll(states_[i]);
+    }
+
+    return index + __builtin_popcountll(states_[word] & ((1ULL << (state % 64)) - 1));
+  }
+};
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_INTERNAL_KEY_COUNTS_H_
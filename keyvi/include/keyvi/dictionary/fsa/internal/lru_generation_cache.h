@@ -25,6 +25,9 @@
 #ifndef KEYVI_DICTIONARY_FSA_INTERNAL_LRU_GENERATION_CACHE_H_
 #define KEYVI_DICTIONARY_FSA_INTERNAL_LRU_GENERATION_CACHE_H_
 
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 #include <vector>
 
 #include "keyvi/dictionary/fsa/internal/minimization_hash.h"
@@ -37,6 +40,11 @@ namespace internal {
 
 /**
  * A simple implementation of a lightweight least recently used cache using generations.
+ *
+ * A filter with a byte per slot records which generations might contain an entry with a given hashcode, a lookup only
+ * probes those generations. A miss, the common case, usually costs a single probe into the filter instead of one probe
+ * per generation. The filter has no false negatives: bits get set on every add and are only cleared when the
+ * generation they stand for is evicted.
  */
 template <class EntryT = PackedState<>>
 class LeastRecentlyUsedGenerationsCache final {
@@ -48,10 +56,13 @@ class LeastRecentlyUsedGenerationsCache final {
   explicit LeastRecentlyUsedGenerationsCache(size_t memory_limit) {
     current_generation_ = new MinimizationHash<EntryT>();
 
-    auto memoryConfiguration = current_generation_->FindMemoryLimitConfigurationForLRUCache(memory_limit, 3, 6);
+    // leave a part of the budget for the filter, 2 bytes per entry compared to more than 20 bytes in the tables
+    auto memoryConfiguration =
+        current_generation_->FindMemoryLimitConfigurationForLRUCache(memory_limit - memory_limit / 12, 3, 6);
 
     size_per_generation_ = memoryConfiguration.best_fit_maximum_number_of_items_per_table;
     max_number_of_generations_ = memoryConfiguration.best_fit_generations;
+    InitFilter();
   }
 
   /** Constructor of LeastRecentlyUsedGenerationsCache
@@ -62,6 +73,7 @@ class LeastRecentlyUsedGenerationsCache final {
   LeastRecentlyUsedGenerationsCache(size_t size_per_generation, size_t max_number_of_generations)
       : size_per_generation_(size_per_generation), max_number_of_generations_(max_number_of_generations) {
     current_generation_ = new MinimizationHash<EntryT>();
+    InitFilter();
   }
 
   ~LeastRecentlyUsedGenerationsCache() {
@@ -81,38 +93,66 @@ class LeastRecentlyUsedGenerationsCache final {
   void Add(EntryT key) {
     if (current_generation_->Size() >= size_per_generation_) {
       MinimizationHash<EntryT> *newGeneration = nullptr;
+      uint8_t new_generation_tag;
+
       if (generations_.size() + 1 == max_number_of_generations_) {
         // remove(free) the first generation
         newGeneration = generations_[0];
         newGeneration->Reset();
         generations_.erase(generations_.begin());
+
+        // reuse its tag, after removing it from the filter
+        new_generation_tag = generation_tags_[0];
+        generation_tags_.erase(generation_tags_.begin());
+        ClearTag(new_generation_tag);
+      } else {
+        // tags in use: the current generation and the older ones
+        new_generation_tag = static_cast<uint8_t>(1 << (generations_.size() + 1));
       }
 
       generations_.push_back(current_generation_);
+      generation_tags_.push_back(current_generation_tag_);
 
       if (newGeneration == nullptr) {
         newGeneration = new MinimizationHash<EntryT>();
       }
 
       current_generation_ = newGeneration;
+      current_generation_tag_ = new_generation_tag;
     }
 
     current_generation_->Add(key);
+    filter_[GetFilterSlot(key.GetHashcode())] |= current_generation_tag_;
   }
 
   template <typename EqualityType>
   const EntryT Get(EqualityType &key) {  // NOLINT
-    EntryT state = current_generation_->Get(key);
+    const size_t filter_slot = GetFilterSlot(key.GetHashcode());
+    const uint8_t tags = filter_[filter_slot];
 
-    if (!state.IsEmpty()) {
-      return state;
+    if (tags == 0) {
+      return EntryT();
+    }
+
+    if (tags & current_generation_tag_) {
+      EntryT state = current_generation_->Get(key);
+
+      if (!state.IsEmpty()) {
+        return state;
+      }
     }
 
     // try to find it in one of the generations
     for (size_t i = generations_.size(); i > 0; --i) {
-      state = generations_[i - 1]->GetAndMove(key, current_generation_);
+      if ((tags & generation_tags_[i - 1]) == 0) {
+        continue;
+      }
+
+      EntryT state = generations_[i - 1]->GetAndMove(key, current_generation_);
 
       if (!state.IsEmpty()) {
+        // moved to the current generation, the bit of the old generation stays until it gets evicted
+        filter_[filter_slot] |= current_generation_tag_;
         return state;
       }
     }
@@ -130,6 +170,9 @@ class LeastRecentlyUsedGenerationsCache final {
       delete generation;
     }
     generations_.clear();
+    generation_tags_.clear();
+    current_generation_tag_ = 1;
+    std::fill(filter_.begin(), filter_.end(), 0);
   }
 
   /***
@@ -138,7 +181,7 @@ class LeastRecentlyUsedGenerationsCache final {
    * @return the memory usage
    */
   size_t GetMemoryUsage() const {
-    size_t memory = current_generation_->GetMemoryUsage();
+    size_t memory = current_generation_->GetMemoryUsage() + filter_.size();
     for (auto generation : generations_) {
       memory += generation->GetMemoryUsage();
     }
@@ -150,6 +193,34 @@ class LeastRecentlyUsedGenerationsCache final {
   size_t max_number_of_generations_;
   MinimizationHash<EntryT> *current_generation_;
   std::vector<MinimizationHash<EntryT> *> generations_;
+
+  // one bit per generation, generation_tags_ runs parallel to generations_
+  uint8_t current_generation_tag_ = 1;
+  std::vector<uint8_t> generation_tags_;
+  std::vector<uint8_t> filter_;
+
+  void InitFilter() {
+    if (max_number_of_generations_ > 8) {
+      throw std::invalid_argument("at most 8 generations are supported");
+    }
+
+    // 2 slots per entry, so most slots of a miss are empty
+    filter_.resize(std::max<size_t>(2 * size_per_generation_ * max_number_of_generations_, 64));
+  }
+
+  template <typename HashCodeT>
+  inline size_t GetFilterSlot(const HashCodeT hashcode) const {
+    // the lower 32 bits are the same for all entry and key types, scrambled and mapped to the filter size
+    const uint32_t h = static_cast<uint32_t>(hashcode) * 0x9E3779B1;
+    return static_cast<size_t>((static_cast<uint64_t>(h) * filter_.size()) >> 32);
+  }
+
+  void ClearTag(const uint8_t tag) {
+    const uint8_t mask = static_cast<uint8_t>(~tag);
+    for (uint8_t &tags : filter_) {
+      tags &= mask;
+    }
+  }
 };
 
 } /* namespace internal */
@@ -50,7 +50,15 @@ enum class loading_strategy_types {
   populate_lazy,                 // load data lazy but ask the OS to read ahead if possible (does not block)
   lazy_no_readahead,             // disable any read-ahead (for cases when index > x * main memory)
   lazy_no_readahead_value_part,  // disable read-ahead only for the value part
-  populate_key_part_no_readahead_value_part  // populate the key part, but disable read ahead value part
+  populate_key_part_no_readahead_value_part,  // populate the key part, but disable read ahead value part
+  lazy_access_profile,  // load data lazy, but read ahead the pages recorded in the page access profile (if available)
+  populate_background,  // load data lazy, but populate everything on background threads (does not block)
+  populate_key_part_locked,  // populate the key part and lock it in memory (mlock), load value part lazy
+  populate_locked,           // populate key and value part and lock both in memory (mlock)
+  anonymous_key_part,  // copy the key part into anonymous memory placed according to the numa_node parameter
+                       // (interleaved across all numa nodes by default), load value part lazy
+  pread_value_part,    // load the key part lazy, read the value part using pread through a page cache
+  pread                // read the key part into memory using pread, read the value part through a page cache
 };
 
 namespace fsa {
@@ -86,6 +94,8 @@ class MemoryMapFlags final {
       case loading_strategy_types::populate:
       case loading_strategy_types::populate_key_part:
       case loading_strategy_types::populate_key_part_no_readahead_value_part:
+      case loading_strategy_types::populate_key_part_locked:
+      case loading_strategy_types::populate_locked:
         flags |= MAP_POPULATE;
         break;
       default:
@@ -122,6 +132,7 @@ class MemoryMapFlags final {
 
         switch (strategy) {
       case loading_strategy_types::populate:
+      case loading_strategy_types::populate_locked:
         flags |= MAP_POPULATE;
         break;
       default:
@@ -26,6 +26,7 @@
 #define KEYVI_DICTIONARY_FSA_INTERNAL_MEMORY_MAP_MANAGER_H_
 
 #include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -34,6 +35,8 @@
 #include <boost/interprocess/file_mapping.hpp>
 #include <boost/interprocess/mapped_region.hpp>
 
+#include "keyvi/util/file_output_stream.h"
+
 // #define ENABLE_TRACING
 #include "keyvi/dictionary/util/trace.h"
 
@@ -113,16 +116,44 @@ class MemoryMapManager final {
    * @param buffer_length the buffer length to append
    */
   void Append(const void* buffer, const size_t buffer_length) {
+    SetBuffer(tail_, buffer, buffer_length);
+    tail_ += buffer_length;
+  }
+
+  /**
+   * Extend the buffer at the current tail without writing, the reserved range gets written with SetBuffer.
+   *
+   * All chunks of the range are created here, so that SetBuffer can be called from another thread as long as no
+   * other method creates chunks at the same time.
+   *
+   * @param buffer_length the number of bytes to reserve
+   */
+  void Reserve(const size_t buffer_length) {
+    if (buffer_length > 0) {
+      GetChunk((tail_ + buffer_length - 1) / chunk_size_);
+    }
+
+    tail_ += buffer_length;
+  }
+
+  /**
+   * Copy a buffer to the given offset, possibly spanning several chunks.
+   *
+   * @param offset the offset to write to
+   * @param buffer the buffer to copy
+   * @param buffer_length the buffer length
+   */
+  void SetBuffer(const size_t offset, const void* buffer, const size_t buffer_length) {
     size_t remaining = buffer_length;
     size_t buffer_offset = 0;
 
-    TRACE("append %ld %ld", buffer_offset, remaining);
+    TRACE("set buffer %ld %ld", offset, remaining);
 
     while (remaining > 0) {
       TRACE("next chunk remaining: %ld", remaining);
 
-      size_t chunk_number = tail_ / chunk_size_;
-      size_t chunk_offset = tail_ % chunk_size_;
+      size_t chunk_number = (offset + buffer_offset) / chunk_size_;
+      size_t chunk_offset = (offset + buffer_offset) % chunk_size_;
       TRACE("chunk number: %ld offset %ld", chunk_number, chunk_offset);
 
       void* chunk_address = GetChunk(chunk_number);
@@ -133,7 +164,6 @@ class MemoryMapManager final {
                   reinterpret_cast<const char*>(buffer) + buffer_offset, copy_size);
 
       remaining -= copy_size;
-      tail_ += copy_size;
       buffer_offset += copy_size;
     }
   }
@@ -171,6 +201,12 @@ class MemoryMapManager final {
   }
 
   void Write(std::ostream& stream, const size_t end) const {
+    // copy the chunk files inside the kernel if writing into a file
+    keyvi::util::FileOutputStream* file_stream = dynamic_cast<keyvi::util::FileOutputStream*>(&stream);
+    if (file_stream && AppendChunks(file_stream, end)) {
+      return;
+    }
+
     if (persisted_) {
       for (size_t i = 0; i < number_of_chunks_; i++) {
         std::ifstream data_stream(GetFilenameForChunk(i).native().c_str(), std::ios::binary);
@@ -257,6 +293,34 @@ class MemoryMapManager final {
     return filename;
   }
 
+  /**
+   * Append the chunk files to the given file.
+   *
+   * Data in the mapped regions does not need to be synced, the copy reads the same page cache.
+   *
+   * @return true if appended, false if the stream has to be used instead
+   */
+  bool AppendChunks(keyvi::util::FileOutputStream* file_stream, const size_t end) const {
+    size_t remaining = persisted_ ? tail_ : end;
+    size_t chunk = 0;
+
+    while (remaining > 0 && chunk < number_of_chunks_) {
+      size_t bytes_in_chunk = std::min(chunk_size_, remaining);
+
+      if (!file_stream->AppendFile(GetFilenameForChunk(chunk), bytes_in_chunk)) {
+        if (chunk > 0) {
+          throw memory_map_manager_exception("failed to append chunk");
+        }
+        return false;
+      }
+
+      remaining -= bytes_in_chunk;
+      ++chunk;
+    }
+
+    return true;
+  }
+
   void* GetChunk(const size_t chunk_number) {
     while (chunk_number >= number_of_chunks_) {
       CreateMapping();
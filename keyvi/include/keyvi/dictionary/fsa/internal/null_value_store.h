@@ -41,6 +41,7 @@ class NullValueStoreBase {
   typedef uint32_t value_t;
   static const uint64_t no_value = 0;
   static const bool inner_weight = false;
+  static const bool parallel_encoding = false;
 
   NullValueStoreBase() {}
 
@@ -0,0 +1,337 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * page_access_profile.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_INTERNAL_PAGE_ACCESS_PROFILE_H_
+#define KEYVI_DICTIONARY_FSA_INTERNAL_PAGE_ACCESS_PROFILE_H_
+
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "rapidjson/document.h"
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "keyvi/dictionary/util/endian.h"
+#include "keyvi/util/serialization_utils.h"
+#include "keyvi/util/vint.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+static const char PAGE_ACCESS_PROFILE_MAGIC[] = "KEYVIPAP";
+static const size_t PAGE_ACCESS_PROFILE_MAGIC_LEN = 8;
+static const char PAGE_ACCESS_PROFILE_FILE_SUFFIX[] = ".pageprofile";
+static const char PAGE_SIZE_PROPERTY[] = "page_size";
+static const char NUMBER_OF_RANGES_PROPERTY[] = "number_of_ranges";
+
+/**
+ * Profile of the pages of a keyvi file that have been accessed.
+ *
+ * A profile is recorded by sampling the page cache residency (mincore) of the mapped regions of a loaded dictionary,
+ * it can be stored in a sidecar file next to the dictionary and replayed on the next load using madvise(WILLNEED), so
+ * that only the pages that are actually used get prefetched.
+ *
+ * Pages are tracked by their position in the file, so one profile covers all regions (labels, transitions, values).
+ */
+class PageAccessProfile final {
+ public:
+  PageAccessProfile() : page_size_(boost::interprocess::mapped_region::get_page_size()) {}
+
+  /**
+   * Get the name of the sidecar profile for the given dictionary file.
+   *
+   * @param file_name the file name of the dictionary
+   * @return the file name of the profile
+   */
+  static std::string GetProfileFileName(const std::string& file_name) {
+    return file_name + PAGE_ACCESS_PROFILE_FILE_SUFFIX;
+  }
+
+  /**
+   * Take a snapshot of the resident pages of a mapped region and add them to the profile.
+   *
+   * @param address the address of the mapped region
+   * @param size the size of the mapped region
+   * @param file_offset the offset in the file the region has been mapped from
+   */
+  void Sample(const void* address, const size_t size, const size_t file_offset) {
+#if !defined(_WIN32)
+    if (size == 0) {
+      return;
+    }
+
+    const size_t alignment_offset = reinterpret_cast<uintptr_t>(address) % page_size_;
+    const char* aligned_address = static_cast<const char*>(address) - alignment_offset;
+    const size_t number_of_pages = (size + alignment_offset + page_size_ - 1) / page_size_;
+    const size_t first_page = file_offset / page_size_;
+
+#if defined(OS_MACOSX)
+    std::vector<char> residency(number_of_pages);
+#else
+    std::vector<unsigned char> residency(number_of_pages);
+#endif
+    if (mincore(const_cast<char*>(aligned_address), number_of_pages * page_size_, residency.data()) != 0) {
+      TRACE("mincore failed, skip sample");
+      return;
+    }
+
+    if (pages_.size() < first_page + number_of_pages) {
+      pages_.resize(first_page + number_of_pages, false);
+    }
+
+    for (size_t i = 0; i < number_of_pages; ++i) {
+      if (residency[i] & 1) {
+        pages_[first_page + i] = true;
+      }
+    }
+#endif
+  }
+
+  /**
+   * Ask the OS to read ahead all pages of the profile that belong to the given mapped region.
+   *
+   * @param address the address of the mapped region
+   * @param size the size of the mapped region
+   * @param file_offset the offset in the file the region has been mapped from
+   */
+  void Replay(const void* address, const size_t size, const size_t file_offset) const {
+#if !defined(_WIN32)
+    if (size == 0) {
+      return;
+    }
+
+    const size_t alignment_offset = reinterpret_cast<uintptr_t>(address) % page_size_;
+    char* aligned_address = const_cast<char*>(static_cast<const char*>(address) - alignment_offset);
+    const size_t number_of_pages = (size + alignment_offset + page_size_ - 1) / page_size_;
+    const size_t first_page = file_offset / page_size_;
+
+    size_t i = 0;
+    while (i < number_of_pages) {
+      if (!HasPage(first_page + i)) {
+        ++i;
+        continue;
+      }
+
+      // collect consecutive pages to reduce the number of syscalls
+      size_t run_start = i;
+      while (i < number_of_pages && HasPage(first_page + i)) {
+        ++i;
+      }
+
+      TRACE("replay pages %d-%d", first_page + run_start, first_page + i);
+      madvise(aligned_address + (run_start * page_size_), (i - run_start) * page_size_, MADV_WILLNEED);
+    }
+#endif
+  }
+
+  bool HasPage(const size_t page) const { return page < pages_.size() && pages_[page]; }
+
+  size_t GetNumberOfPages() const {
+    size_t number_of_pages = 0;
+    for (const bool page : pages_) {
+      number_of_pages += page ? 1 : 0;
+    }
+    return number_of_pages;
+  }
+
+  size_t GetPageSize() const { return page_size_; }
+
+  void Clear() { pages_.clear(); }
+
+  /**
+   * Write the profile: magic, a length prefixed json header and the varint encoded page ranges.
+   *
+   * @param stream the stream to write into
+   */
+  void Write(std::ostream& stream) const {
+    std::vector<std::pair<size_t, size_t>> ranges = GetRanges();
+
+    stream.write(PAGE_ACCESS_PROFILE_MAGIC, PAGE_ACCESS_PROFILE_MAGIC_LEN);
+
+    rapidjson::StringBuffer string_buffer;
+    {
+      rapidjson::Writer<rapidjson::StringBuffer> writer(string_buffer);
+
+      writer.StartObject();
+      writer.Key(PAGE_SIZE_PROPERTY);
+      writer.Uint64(page_size_);
+      writer.Key(NUMBER_OF_RANGES_PROPERTY);
+      writer.Uint64(ranges.size());
+      writer.EndObject();
+    }
+
+    uint32_t size = htobe32(string_buffer.GetLength());
+    stream.write(reinterpret_cast<const char*>(&size), sizeof(uint32_t));
+    stream.write(string_buffer.GetString(), string_buffer.GetLength());
+
+    // ranges are delta encoded: (distance to end of previous range, length)
+    std::vector<uint8_t> buffer;
+    size_t previous_end = 0;
+    for (const auto& range : ranges) {
+      size_t written_bytes;
+      keyvi::util::encodeVarInt(range.first - previous_end, &buffer, &written_bytes);
+      keyvi::util::encodeVarInt(range.second, &buffer, &written_bytes);
+      previous_end = range.first + range.second;
+    }
+    stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+  }
+
+  void WriteToFile(const std::string& file_name) const {
+    std::ofstream out_stream(file_name, std::ios::binary);
+    if (!out_stream.good()) {
+      throw std::invalid_argument("failed to open page access profile for writing");
+    }
+    Write(out_stream);
+  }
+
+  /**
+   * Read a profile written with Write.
+   *
+   * @param file_name the file name of the profile
+   * @param max_size the size of the file the profile belongs to, ranges beyond it are ignored
+   * @return the profile, empty if it has been recorded with a different page size
+   */
+  static PageAccessProfile FromFile(const std::string& file_name, const size_t max_size) {
+    std::ifstream in_stream(file_name, std::ios::binary);
+
+    if (!in_stream.good()) {
+      throw std::invalid_argument("page access profile not found");
+    }
+
+    char magic[PAGE_ACCESS_PROFILE_MAGIC_LEN];
+    in_stream.read(magic, PAGE_ACCESS_PROFILE_MAGIC_LEN);
+
+    if (!in_stream.good() || std::strncmp(magic, PAGE_ACCESS_PROFILE_MAGIC, PAGE_ACCESS_PROFILE_MAGIC_LEN) != 0) {
+      throw std::invalid_argument("not a page access profile");
+    }
+
+    rapidjson::Document header;
+    keyvi::util::SerializationUtils::ReadLengthPrefixedJsonRecord(in_stream, &header);
+
+    PageAccessProfile profile;
+
+    // a profile recorded with a different page size can not be replayed
+    if (keyvi::util::SerializationUtils::GetUint64FromValueOrString(header, PAGE_SIZE_PROPERTY) != profile.page_size_) {
+      return profile;
+    }
+
+    const size_t number_of_ranges =
+        keyvi::util::SerializationUtils::GetUint64FromValueOrString(header, NUMBER_OF_RANGES_PROPERTY);
+    const size_t max_pages = (max_size + profile.page_size_ - 1) / profile.page_size_;
+
+    const std::string encoded_ranges((std::istreambuf_iterator<char>(in_stream)), std::istreambuf_iterator<char>());
+    const uint8_t* position = reinterpret_cast<const uint8_t*>(encoded_ranges.data());
+    const uint8_t* end = position + encoded_ranges.size();
+
+    size_t previous_end = 0;
+    for (size_t i = 0; i < number_of_ranges; ++i) {
+      uint64_t distance;
+      uint64_t length;
+      if (!DecodeVarInt(&position, end, &distance) || !DecodeVarInt(&position, end, &length)) {
+        throw std::invalid_argument("page access profile is corrupt(truncated)");
+      }
+
+      // ranges are ordered, so all remaining ranges are beyond the file, too
+      if (distance >= max_pages - previous_end) {
+        break;
+      }
+
+      const size_t start = previous_end + distance;
+      const size_t range_end = start + std::min<uint64_t>(length, max_pages - start);
+
+      profile.pages_.resize(range_end, false);
+      std::fill(profile.pages_.begin() + start, profile.pages_.end(), true);
+      previous_end = range_end;
+    }
+
+    return profile;
+  }
+
+ private:
+  size_t page_size_;
+  std::vector<bool> pages_;
+
+  std::vector<std::pair<size_t, size_t>> GetRanges() const {
+    std::vector<std::pair<size_t, size_t>> ranges;
+
+    size_t i = 0;
+    while (i < pages_.size()) {
+      if (!pages_[i]) {
+        ++i;
+        continue;
+      }
+      size_t start = i;
+      while (i < pages_.size() && pages_[i]) {
+        ++i;
+      }
+      ranges.emplace_back(start, i - start);
+    }
+
+    return ranges;
+  }
+
+  /**
+   * Decode a varint without reading past the end of the buffer.
+   *
+   * @return false if the buffer ends before the varint
+   */
+  static bool DecodeVarInt(const uint8_t** position, const uint8_t* end, uint64_t* value) {
+    *value = 0;
+    for (size_t shift = 0; *position < end && shift < 64; shift += 7) {
+      const uint8_t byte = *(*position)++;
+      *value |= static_cast<uint64_t>(byte & 127) << shift;
+
+      if (!(byte & 128)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+};
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_INTERNAL_PAGE_ACCESS_PROFILE_H_
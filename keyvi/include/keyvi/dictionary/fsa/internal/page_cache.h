@@ -0,0 +1,332 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * page_cache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_INTERNAL_PAGE_CACHE_H_
+#define KEYVI_DICTIONARY_FSA_INTERNAL_PAGE_CACHE_H_
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/align/aligned_alloc.hpp>
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+// page size of the cache, a multiple of the block size as required for direct io
+static const size_t PAGE_CACHE_PAGE_SIZE = 16 * 1024;
+static const size_t PAGE_CACHE_NUMBER_OF_SHARDS = 16;
+
+/**
+ * A user space page cache for reading a file with pread instead of memory mapping it.
+ *
+ * Pages are kept in shards, each shard has its own lock and least recently used eviction, the capacity is split
+ * evenly across shards. Pages are handed out as shared pointers, so they stay valid for the reader even if they get
+ * evicted concurrently.
+ *
+ * Optionally the file is opened with O_DIRECT to bypass the OS page cache (linux only).
+ */
+class PageCache final {
+ public:
+  /**
+   * @param file_name the file to read from
+   * @param capacity the maximum memory to use for cached pages
+   * @param direct_io whether to bypass the OS page cache
+   */
+  PageCache(const std::string& file_name, const size_t capacity, const bool direct_io = false)
+      : pages_per_shard_(std::max<size_t>(1, capacity / PAGE_CACHE_PAGE_SIZE / PAGE_CACHE_NUMBER_OF_SHARDS)),
+        shards_(PAGE_CACHE_NUMBER_OF_SHARDS) {
+#if defined(_WIN32)
+    throw std::invalid_argument("pread based loading is not supported on this platform");
+#else
+    int flags = O_RDONLY;
+#if defined(O_DIRECT)
+    if (direct_io) {
+      flags |= O_DIRECT;
+    }
+#endif
+    fd_ = open(file_name.c_str(), flags);
+
+    if (fd_ == -1) {
+      throw std::invalid_argument("failed to open " + file_name);
+    }
+
+    struct stat file_stat;
+    if (fstat(fd_, &file_stat) != 0) {
+      close(fd_);
+      throw std::invalid_argument("failed to stat " + file_name);
+    }
+
+    file_size_ = file_stat.st_size;
+#endif
+  }
+
+  ~PageCache() {
+#if !defined(_WIN32)
+    close(fd_);
+#endif
+  }
+
+  PageCache& operator=(PageCache const&) = delete;
+  PageCache(const PageCache& that) = delete;
+
+  /**
+   * Read from the file through the cache.
+   *
+   * @param offset the offset in the file
+   * @param length the number of bytes to read
+   * @param buffer the output buffer
+   */
+  void Read(size_t offset, size_t length, char* buffer) const {
+    if (offset + length > file_size_) {
+      throw std::out_of_range("read beyond end of file");
+    }
+
+    while (length > 0) {
+      const size_t page_offset = offset % PAGE_CACHE_PAGE_SIZE;
+      const size_t bytes = std::min(length, PAGE_CACHE_PAGE_SIZE - page_offset);
+      const page_t page = GetPage(offset / PAGE_CACHE_PAGE_SIZE);
+
+      std::memcpy(buffer, page->data + page_offset, bytes);
+      buffer += bytes;
+      offset += bytes;
+      length -= bytes;
+    }
+  }
+
+  /**
+   * Read a zero terminated string.
+   *
+   * @param offset the offset in the file
+   * @return the string (without the terminating zero)
+   */
+  std::string ReadZeroTerminatedString(size_t offset) const {
+    std::string result;
+
+    while (offset < file_size_) {
+      const size_t page_offset = offset % PAGE_CACHE_PAGE_SIZE;
+      const page_t page = GetPage(offset / PAGE_CACHE_PAGE_SIZE);
+      const size_t available = page->size - page_offset;
+      const char* start = page->data + page_offset;
+      const char* end = static_cast<const char*>(std::memchr(start, 0, available));
+
+      if (end) {
+        result.append(start, end - start);
+        return result;
+      }
+
+      result.append(start, available);
+      offset += available;
+    }
+
+    return result;
+  }
+
+  /**
+   * Read a string, prefixed by its length as varint.
+   *
+   * @param offset the offset in the file
+   * @return the string
+   */
+  std::string ReadVarIntString(size_t offset) const {
+    char varint_buffer[10];
+    const size_t varint_bytes = std::min(sizeof(varint_buffer), file_size_ - std::min(offset, file_size_));
+    Read(offset, varint_bytes, varint_buffer);
+
+    uint64_t length = 0;
+    size_t i = 0;
+    for (; i < varint_bytes; ++i) {
+      length |= static_cast<uint64_t>(varint_buffer[i] & 127) << (7 * i);
+
+      if (!(varint_buffer[i] & 128)) {
+        break;
+      }
+    }
+
+    std::string result(length, 0);
+    Read(offset + i + 1, length, &result[0]);
+    return result;
+  }
+
+  /**
+   * Read from the file bypassing the cache, e.g. for loading a region completely.
+   *
+   * @param offset the offset in the file
+   * @param length the number of bytes to read
+   * @param buffer the output buffer
+   */
+  void ReadUncached(size_t offset, size_t length, char* buffer) const {
+    if (offset + length > file_size_) {
+      throw std::out_of_range("read beyond end of file");
+    }
+
+    Page page;
+    while (length > 0) {
+      const size_t page_offset = offset % PAGE_CACHE_PAGE_SIZE;
+      const size_t bytes = std::min(length, PAGE_CACHE_PAGE_SIZE - page_offset);
+      ReadPage(offset / PAGE_CACHE_PAGE_SIZE, &page);
+
+      std::memcpy(buffer, page.data + page_offset, bytes);
+      buffer += bytes;
+      offset += bytes;
+      length -= bytes;
+    }
+  }
+
+  size_t GetFileSize() const { return file_size_; }
+
+  size_t GetHits() const { return hits_; }
+
+  size_t GetMisses() const { return misses_; }
+
+  size_t GetCapacity() const { return pages_per_shard_ * PAGE_CACHE_NUMBER_OF_SHARDS * PAGE_CACHE_PAGE_SIZE; }
+
+ private:
+  struct Page {
+    Page() {
+      // aligned, as required for direct io
+      data = static_cast<char*>(boost::alignment::aligned_alloc(PAGE_CACHE_PAGE_SIZE, PAGE_CACHE_PAGE_SIZE));
+      if (!data) {
+        throw std::bad_alloc();
+      }
+    }
+
+    ~Page() { boost::alignment::aligned_free(data); }
+
+    Page& operator=(Page const&) = delete;
+    Page(const Page& that) = delete;
+
+    char* data;
+    size_t size = 0;
+  };
+
+  typedef std::shared_ptr<const Page> page_t;
+
+  struct Shard {
+    std::mutex mutex;
+    std::list<size_t> lru;
+    std::unordered_map<size_t, std::pair<page_t, std::list<size_t>::iterator>> pages;
+  };
+
+  int fd_ = -1;
+  size_t file_size_ = 0;
+  const size_t pages_per_shard_;
+  mutable std::vector<Shard> shards_;
+  mutable std::atomic<size_t> hits_{0};
+  mutable std::atomic<size_t> misses_{0};
+
+  page_t GetPage(const size_t page_number) const {
+    Shard& shard = shards_[page_number % PAGE_CACHE_NUMBER_OF_SHARDS];
+
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      auto it = shard.pages.find(page_number);
+      if (it != shard.pages.end()) {
+        ++hits_;
+        shard.lru.splice(shard.lru.begin(), shard.lru, it->second.second);
+        return it->second.first;
+      }
+    }
+
+    ++misses_;
+
+    // read outside of the lock
+    std::shared_ptr<Page> page = std::make_shared<Page>();
+    ReadPage(page_number, page.get());
+
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    // another thread might have loaded the same page in the meantime
+    auto it = shard.pages.find(page_number);
+    if (it != shard.pages.end()) {
+      return it->second.first;
+    }
+
+    shard.lru.push_front(page_number);
+    shard.pages.emplace(page_number, std::make_pair(page, shard.lru.begin()));
+
+    while (shard.pages.size() > pages_per_shard_) {
+      TRACE("evict page %d", shard.lru.back());
+      shard.pages.erase(shard.lru.back());
+      shard.lru.pop_back();
+    }
+
+    return page;
+  }
+
+  void ReadPage(const size_t page_number, Page* page) const {
+#if !defined(_WIN32)
+    const size_t offset = page_number * PAGE_CACHE_PAGE_SIZE;
+    size_t bytes_read = 0;
+
+    // always request full pages, the last page of the file might be shorter
+    while (bytes_read < PAGE_CACHE_PAGE_SIZE && offset + bytes_read < file_size_) {
+      const ssize_t result =
+          pread(fd_, page->data + bytes_read, PAGE_CACHE_PAGE_SIZE - bytes_read, offset + bytes_read);
+
+      if (result < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw std::runtime_error("failed to read page: " + std::string(std::strerror(errno)));
+      }
+
+      if (result == 0) {
+        break;
+      }
+
+      bytes_read += result;
+    }
+
+    page->size = bytes_read;
+#endif
+  }
+};
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_INTERNAL_PAGE_CACHE_H_
@@ -28,6 +28,9 @@
 #include <algorithm>
 #include <cstring>
 #include <fstream>
+#include <future>  // NOLINT
+#include <utility>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 #include <boost/interprocess/file_mapping.hpp>
@@ -51,11 +54,21 @@ namespace dictionary {
 namespace fsa {
 namespace internal {
 
+/**
+ * Persistence of the sparse array while it is built.
+ *
+ * The upper part of the array is kept in memory, the lower part is flushed to external memory in windows. Flushing
+ * is double buffered: the flushed window is copied to external memory in the background while building continues
+ * on the other buffer. Until the next flush, the flushed window is read from its buffer, writes to it wait for the
+ * copy to finish.
+ */
 template <class BucketT = uint16_t>
 class SparseArrayPersistence final {
  public:
-  SparseArrayPersistence(size_t memory_limit, boost::filesystem::path temporary_path) : in_memory_buffer_offset_(0) {
-    buffer_size_ = memory_limit / (sizeof(unsigned char) + sizeof(BucketT));
+  SparseArrayPersistence(size_t memory_limit, boost::filesystem::path temporary_path)
+      : in_memory_buffer_offset_(0), flushed_buffer_offset_(0) {
+    // 2 buffers, the 2nd one for the window that gets flushed in the background
+    buffer_size_ = memory_limit / (2 * (sizeof(unsigned char) + sizeof(BucketT)));
 
     // align it to 16bit (for fast memcpy)
     buffer_size_ += 16 - (buffer_size_ % 16);
@@ -67,6 +80,7 @@ class SparseArrayPersistence final {
 
     labels_ = new unsigned char[buffer_size_];
     std::memset(labels_, 0, buffer_size_);
+    flushed_labels_ = new unsigned char[buffer_size_];
 
     temporary_directory_ = temporary_path;
     temporary_directory_ /= boost::filesystem::unique_path("dictionary-fsa-%%%%-%%%%-%%%%-%%%%");
@@ -84,17 +98,24 @@ class SparseArrayPersistence final {
 
     transitions_ = new BucketT[buffer_size_];
     std::memset(transitions_, 0, buffer_size_ * sizeof(BucketT));
+    flushed_transitions_ = new BucketT[buffer_size_];
 
     transitions_extern_ = new MemoryMapManager(external_memory_chunk_size * sizeof(BucketT), temporary_directory_,
                                                "valueTableFileBuffer");
   }
 
   ~SparseArrayPersistence() {
+    if (flush_.valid()) {
+      flush_.wait();
+    }
+
     delete labels_extern_;
     delete transitions_extern_;
     if (labels_) {
       delete[] labels_;
       delete[] transitions_;
+      delete[] flushed_labels_;
+      delete[] flushed_transitions_;
     }
     boost::filesystem::remove_all(temporary_directory_);
   }
@@ -130,6 +151,12 @@ class SparseArrayPersistence final {
       return;
     }
 
+    if (offset >= flushed_buffer_offset_) {
+      // the window is being copied, write to external memory once it is done
+      WaitForFlush();
+      flushed_buffer_offset_ = in_memory_buffer_offset_;
+    }
+
     unsigned char* label_ptr = (unsigned char*)labels_extern_->GetAddress(offset);
     *label_ptr = transitionId;
 
@@ -142,6 +169,10 @@ class SparseArrayPersistence final {
       return labels_[offset - in_memory_buffer_offset_];
     }
 
+    if (offset >= flushed_buffer_offset_) {
+      return flushed_labels_[offset - flushed_buffer_offset_];
+    }
+
     unsigned char* ptr = (unsigned char*)labels_extern_->GetAddress(offset);
     return *ptr;
   }
@@ -151,6 +182,10 @@ class SparseArrayPersistence final {
       return transitions_[offset - in_memory_buffer_offset_];
     }
 
+    if (offset >= flushed_buffer_offset_) {
+      return flushed_transitions_[offset - flushed_buffer_offset_];
+    }
+
     BucketT* ptr = reinterpret_cast<BucketT*>(transitions_extern_->GetAddress(offset * sizeof(BucketT)));
 
     return PersistenceOrderToHostOrder(*ptr);
@@ -166,6 +201,9 @@ class SparseArrayPersistence final {
   void Flush() {
     // make idempotent, so it can be called twice or more);
     if (labels_) {
+      WaitForFlush();
+      flushed_buffer_offset_ = in_memory_buffer_offset_;
+
       size_t highest_write_position =
           std::max(highest_state_begin_ + MAX_TRANSITIONS_OF_A_STATE, highest_raw_write_bucket_ + 1);
 
@@ -178,8 +216,12 @@ class SparseArrayPersistence final {
 
       delete[] labels_;
       delete[] transitions_;
+      delete[] flushed_labels_;
+      delete[] flushed_transitions_;
       labels_ = 0;
       transitions_ = 0;
+      flushed_labels_ = 0;
+      flushed_transitions_ = 0;
     }
   }
 
@@ -210,32 +252,74 @@ class SparseArrayPersistence final {
   MemoryMapManager* transitions_extern_;
   boost::filesystem::path temporary_directory_;
 
+  // the window flushed last, read from these buffers until the next flush
+  unsigned char* flushed_labels_;
+  BucketT* flushed_transitions_;
+  std::future<void> flush_;
+
   size_t in_memory_buffer_offset_;
+  size_t flushed_buffer_offset_;
   size_t buffer_size_;
   size_t flush_size_;
   size_t highest_state_begin_ = 0;
   size_t highest_raw_write_bucket_ = 0;
 
   inline void FlushBuffers() {
-    labels_extern_->Append(labels_, flush_size_);
+    // the buffer of the previous window gets reused
+    WaitForFlush();
 
     TRACE("Write labels from %d to %d (flushsize %d)", in_memory_buffer_offset_, in_memory_buffer_offset_ + flush_size_,
           flush_size_);
 
-    // in place re-write
-    HostOrderToPersistenceOrder(transitions_, flush_size_);
-
-    transitions_extern_->Append(transitions_, flush_size_ * sizeof(BucketT));
+    // create the chunks here, the background copy must not change the memory map managers
+    labels_extern_->Reserve(flush_size_);
+    transitions_extern_->Reserve(flush_size_ * sizeof(BucketT));
 
     size_t overlap = buffer_size_ - flush_size_;
 
-    std::memcpy(labels_, labels_ + flush_size_, overlap);
-    std::memcpy(transitions_, transitions_ + flush_size_, sizeof(BucketT) * overlap);
+    std::memcpy(flushed_labels_, labels_ + flush_size_, overlap);
+    std::memcpy(flushed_transitions_, transitions_ + flush_size_, sizeof(BucketT) * overlap);
+
+    std::memset(flushed_labels_ + overlap, 0, flush_size_);
+    std::memset(flushed_transitions_ + overlap, 0, sizeof(BucketT) * flush_size_);
 
-    std::memset(labels_ + overlap, 0, flush_size_);
-    std::memset(transitions_ + overlap, 0, sizeof(BucketT) * flush_size_);
+    std::swap(labels_, flushed_labels_);
+    std::swap(transitions_, flushed_transitions_);
 
+    flushed_buffer_offset_ = in_memory_buffer_offset_;
     in_memory_buffer_offset_ += flush_size_;
+
+    flush_ = std::async(std::launch::async, &SparseArrayPersistence::CopyToExtern, this, flushed_buffer_offset_,
+                        flushed_labels_, flushed_transitions_, flush_size_);
+  }
+
+  void CopyToExtern(const size_t offset, const unsigned char* labels, const BucketT* transitions,
+                    const size_t length) {
+    labels_extern_->SetBuffer(offset, labels, length);
+
+#ifdef KEYVI_BIG_ENDIAN
+    // the buffer is still read while copying, convert a copy
+    std::vector<BucketT> transitions_persistence_order(transitions, transitions + length);
+    HostOrderToPersistenceOrder(transitions_persistence_order.data(), length);
+    transitions = transitions_persistence_order.data();
+#endif
+
+    transitions_extern_->SetBuffer(offset * sizeof(BucketT), transitions, length * sizeof(BucketT));
+  }
+
+  void WaitForFlush() {
+    if (flush_.valid()) {
+      flush_.get();
+    }
+  }
+
+  /**
+   * Read transitions into a buffer, e.g. for decoding a varshort which might cross a buffer border.
+   */
+  void GetTransitions(size_t offset, BucketT* buffer, const size_t length) const {
+    for (size_t i = 0; i < length; ++i) {
+      buffer[i] = ReadTransitionValue(offset + i);
+    }
   }
 
   BucketT PersistenceOrderToHostOrder(BucketT value) const;
@@ -262,7 +346,7 @@ inline uint16_t SparseArrayPersistence<uint16_t>::HostOrderToPesistenceOrder(uin
 template <>
 inline void SparseArrayPersistence<uint16_t>::HostOrderToPersistenceOrder(uint16_t* values, size_t length) const {
 #ifdef KEYVI_BIG_ENDIAN
-  for (size_t i = 0; i < flush_size_; ++i) {
+  for (size_t i = 0; i < length; ++i) {
     values[i] = htole16(values[i]);
   }
 #endif
@@ -288,6 +372,11 @@ inline uint64_t SparseArrayPersistence<uint16_t>::ResolveTransitionValue(size_t
 
     if (overflow_bucket >= in_memory_buffer_offset_) {
       resolved_ptr = keyvi::util::decodeVarShort(transitions_ + overflow_bucket - in_memory_buffer_offset_);
+    } else if (overflow_bucket + 2 >= flushed_buffer_offset_) {
+      // the value might continue in the window that is being copied or in the in-memory buffer
+      uint16_t buffer[3];
+      GetTransitions(overflow_bucket, buffer, 3);
+      resolved_ptr = keyvi::util::decodeVarShort(buffer);
     } else {
       // value needs to be read from external storage, which in 99.9% is a trivial access to the mmap'ed area
       // but in rare cases might be spread across 2 chunks, for the chunk border test we assume worst case 3 varshorts
@@ -324,6 +413,12 @@ inline uint64_t SparseArrayPersistence<uint16_t>::ReadFinalValue(size_t offset)
     return keyvi::util::decodeVarShort(transitions_ + offset - in_memory_buffer_offset_ + FINAL_OFFSET_TRANSITION);
   }
 
+  if (offset + FINAL_OFFSET_TRANSITION + 9 >= flushed_buffer_offset_) {
+    uint16_t buffer[10];
+    GetTransitions(offset + FINAL_OFFSET_TRANSITION, buffer, 10);
+    return keyvi::util::decodeVarShort(buffer);
+  }
+
   if (transitions_extern_->GetAddressQuickTestOk((offset + FINAL_OFFSET_TRANSITION) * sizeof(uint16_t), 5)) {
     uint16_t* ptr = reinterpret_cast<uint16_t*>(
         transitions_extern_->GetAddress((offset + FINAL_OFFSET_TRANSITION) * sizeof(uint16_t)));
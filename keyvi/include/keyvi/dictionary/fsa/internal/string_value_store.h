@@ -34,10 +34,11 @@
 
 #include "keyvi/dictionary/dictionary_properties.h"
 #include "keyvi/dictionary/fsa/internal/ivalue_store.h"
-#include "keyvi/dictionary/fsa/internal/lru_generation_cache.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_flags.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_manager.h"
+#include "keyvi/dictionary/fsa/internal/page_cache.h"
 #include "keyvi/dictionary/fsa/internal/minimization_hash.h"
+#include "keyvi/dictionary/fsa/internal/value_deduplication_cache.h"
 #include "keyvi/dictionary/fsa/internal/value_store_persistence.h"
 #include "keyvi/dictionary/fsa/internal/value_store_properties.h"
 #include "keyvi/dictionary/fsa/internal/value_store_types.h"
@@ -56,6 +57,8 @@ class StringValueStoreBase {
   typedef std::string value_t;
   static const std::string no_value;
   static const bool inner_weight = false;
+  // strings are stored as is, there is nothing to encode in parallel
+  static const bool parallel_encoding = false;
 
   StringValueStoreBase() {}
 
@@ -80,7 +83,7 @@ class StringValueStoreMinimizationBase : public StringValueStoreBase {
  public:
   explicit StringValueStoreMinimizationBase(const keyvi::util::parameters_t& parameters = keyvi::util::parameters_t())
       : parameters_(parameters),
-        hash_(keyvi::util::mapGetMemory(parameters, MEMORY_LIMIT_KEY, DEFAULT_MEMORY_LIMIT_VALUE_STORE)) {
+        hash_(parameters) {
     temporary_directory_ = keyvi::util::mapGetTemporaryPath(parameters_);
 
     temporary_directory_ /= boost::filesystem::unique_path("dictionary-fsa-string_value_store-%%%%-%%%%-%%%%-%%%%");
@@ -106,11 +109,16 @@ class StringValueStoreMinimizationBase : public StringValueStoreBase {
     hash_.Clear();
   }
 
+  /**
+   * Lookups and hits of the value deduplication.
+   */
+  ValueDeduplicationStatistics GetDeduplicationStatistics() const { return hash_.GetStatistics(); }
+
  protected:
   keyvi::util::parameters_t parameters_;
   boost::filesystem::path temporary_directory_;
   std::unique_ptr<MemoryMapManager> values_extern_;
-  LeastRecentlyUsedGenerationsCache<RawPointer<>> hash_;
+  ValueDeduplicationCache hash_;
 };
 
 /**
@@ -249,8 +257,14 @@ class StringValueStoreReader final : public IValueStoreReader {
   using IValueStoreReader::IValueStoreReader;
 
   StringValueStoreReader(boost::interprocess::file_mapping* file_mapping, const ValueStoreProperties& properties,
-                         loading_strategy_types loading_strategy = loading_strategy_types::lazy)
-      : IValueStoreReader(file_mapping, properties) {
+                         loading_strategy_types loading_strategy = loading_strategy_types::lazy,
+                         const std::shared_ptr<PageCache>& page_cache = std::shared_ptr<PageCache>())
+      : IValueStoreReader(file_mapping, properties), page_cache_(page_cache), values_offset_(properties.GetOffset()) {
+    if (page_cache_) {
+      // values are read through the page cache, no need to map them
+      return;
+    }
+
     const boost::interprocess::map_options_t map_options =
         internal::MemoryMapFlags::ValuesGetMemoryMapOptions(loading_strategy);
 
@@ -264,6 +278,11 @@ class StringValueStoreReader final : public IValueStoreReader {
     strings_ = (const char*)strings_region_->get_address();
   }
 
+  StringValueStoreReader(const char* buffer, const ValueStoreProperties& properties)
+      : IValueStoreReader(buffer, properties),
+        strings_(buffer + properties.GetOffset()),
+        values_offset_(properties.GetOffset()) {}
+
   ~StringValueStoreReader() { delete strings_region_; }
 
   value_store_t GetValueStoreType() const override { return value_store_t::STRING; }
@@ -271,17 +290,28 @@ class StringValueStoreReader final : public IValueStoreReader {
   attributes_t GetValueAsAttributeVector(uint64_t fsa_value) const override {
     attributes_t attributes(new attributes_raw_t());
 
-    std::string raw_value(strings_ + fsa_value);
+    std::string raw_value = GetStringValue(fsa_value);
 
     (*attributes)["value"] = raw_value;
     return attributes;
   }
 
-  std::string GetValueAsString(uint64_t fsa_value) const override { return std::string(strings_ + fsa_value); }
+  std::string GetValueAsString(uint64_t fsa_value) const override { return GetStringValue(fsa_value); }
+
+  const boost::interprocess::mapped_region* GetMappedRegion() const override { return strings_region_; }
 
  private:
-  boost::interprocess::mapped_region* strings_region_;
-  const char* strings_;
+  boost::interprocess::mapped_region* strings_region_ = nullptr;
+  const char* strings_ = nullptr;
+  std::shared_ptr<PageCache> page_cache_;
+  size_t values_offset_;
+
+  std::string GetStringValue(uint64_t fsa_value) const {
+    if (page_cache_) {
+      return page_cache_->ReadZeroTerminatedString(values_offset_ + fsa_value);
+    }
+    return std::string(strings_ + fsa_value);
+  }
 
   const char* GetValueStorePayload() const override { return strings_; }
 };
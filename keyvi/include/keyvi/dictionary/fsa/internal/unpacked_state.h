@@ -29,6 +29,7 @@
 
 #include "keyvi/dictionary/fsa/internal/bit_vector.h"
 #include "keyvi/dictionary/fsa/internal/constants.h"
+#include "keyvi/dictionary/fsa/internal/intrinsics.h"
 #include "keyvi/dictionary/fsa/internal/packed_state.h"
 #include "keyvi/dictionary/fsa/internal/sparse_array_persistence.h"
 #include "keyvi/util/vint.h"
@@ -152,6 +153,16 @@ class UnpackedState final {
 
   inline int64_t GetHashcode() {
     if (hashcode_ == -1) {
+#if defined(KEYVI_SSE42)
+      // crc32 instruction: 2 instructions per transition, the weight flag is the seed
+      uint32_t crc = weight_ > 0 ? 1 : 0;
+      for (int i = 0; i < used_; ++i) {
+        crc = _mm_crc32_u32(crc, static_cast<uint32_t>(outgoing_[i].label));
+        crc = static_cast<uint32_t>(_mm_crc32_u64(crc, outgoing_[i].value));
+      }
+
+      hashcode_ = crc;
+#else
       int64_t b;
       int64_t a = b = 0x9e3779b9;
       int64_t c = weight_ > 0 ? 1 : 0;
@@ -198,6 +209,7 @@ class UnpackedState final {
       }
 
       hashcode_ = c;
+#endif
     }
 
     return hashcode_;
@@ -0,0 +1,116 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * value_deduplication_cache.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_DEDUPLICATION_CACHE_H_
+#define KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_DEDUPLICATION_CACHE_H_
+
+#include <algorithm>
+#include <cstddef>
+
+#include "keyvi/dictionary/fsa/internal/constants.h"
+#include "keyvi/dictionary/fsa/internal/lru_generation_cache.h"
+#include "keyvi/dictionary/fsa/internal/value_store_persistence.h"
+#include "keyvi/util/configuration.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+struct ValueDeduplicationStatistics final {
+  size_t lookups = 0;
+  size_t hits = 0;
+  size_t memory_limit = 0;
+  size_t peak_memory_usage = 0;
+
+  double GetHitRate() const { return lookups > 0 ? static_cast<double>(hits) / lookups : 0.0; }
+};
+
+/**
+ * Cache of the values added to a value store, used to find duplicates.
+ *
+ * The memory budget is taken from dedup_memory_limit, falling back to the memory limit of the value store. Values
+ * that got evicted are not found anymore and stored again.
+ */
+class ValueDeduplicationCache final {
+ public:
+  explicit ValueDeduplicationCache(const keyvi::util::parameters_t& parameters)
+      : ValueDeduplicationCache(GetMemoryLimit(parameters)) {}
+
+  explicit ValueDeduplicationCache(const size_t memory_limit) : hash_(memory_limit) {
+    statistics_.memory_limit = memory_limit;
+  }
+
+  ValueDeduplicationCache& operator=(ValueDeduplicationCache const&) = delete;
+  ValueDeduplicationCache(const ValueDeduplicationCache& that) = delete;
+
+  template <typename EqualityType>
+  const RawPointer<> Get(EqualityType& key) {  // NOLINT
+    ++statistics_.lookups;
+    const RawPointer<> p = hash_.Get(key);
+
+    if (!p.IsEmpty()) {
+      ++statistics_.hits;
+    }
+
+    return p;
+  }
+
+  void Add(const RawPointer<>& value) { hash_.Add(value); }
+
+  void Clear() {
+    UpdatePeakMemoryUsage();
+    hash_.Clear();
+  }
+
+  ValueDeduplicationStatistics GetStatistics() const {
+    ValueDeduplicationStatistics statistics = statistics_;
+    statistics.peak_memory_usage = std::max(statistics.peak_memory_usage, hash_.GetMemoryUsage());
+    return statistics;
+  }
+
+  static size_t GetMemoryLimit(const keyvi::util::parameters_t& parameters) {
+    return keyvi::util::mapGetMemory(
+        parameters, DEDUP_MEMORY_LIMIT_KEY,
+        keyvi::util::mapGetMemory(parameters, MEMORY_LIMIT_KEY, DEFAULT_MEMORY_LIMIT_VALUE_STORE));
+  }
+
+ private:
+  LeastRecentlyUsedGenerationsCache<RawPointer<>> hash_;
+  ValueDeduplicationStatistics statistics_;
+
+  void UpdatePeakMemoryUsage() {
+    statistics_.peak_memory_usage = std::max(statistics_.peak_memory_usage, hash_.GetMemoryUsage());
+  }
+};
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_DEDUPLICATION_CACHE_H_
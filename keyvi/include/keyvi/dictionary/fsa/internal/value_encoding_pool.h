@@ -0,0 +1,216 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * value_encoding_pool.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_ENCODING_POOL_H_
+#define KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_ENCODING_POOL_H_
+
+#include <algorithm>
+#include <condition_variable>  // NOLINT
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "keyvi/compression/compression_strategy.h"
+#include "keyvi/dictionary/fsa/internal/value_store_persistence.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+// number of values a worker encodes in one go
+static const size_t VALUE_ENCODING_BLOCK_SIZE = 64;
+
+/**
+ * Encodes batches of values for a value store on a pool of worker threads.
+ *
+ * Every worker has its own encoder, as the compressors keep state. Values are encoded out of order, while the calling
+ * thread adds them to the value store in order as soon as they are ready. Deduplication and offsets are the same as
+ * with sequential AddValue calls.
+ *
+ * The value store must provide:
+ *
+ *  - CreateEncoder(): an encoder with Encode(const value_t&, compression::buffer_t*)
+ *  - AddEncodedValue(const char*, size_t, int32_t hashcode, bool* no_minimization)
+ */
+template <class ValueStoreT>
+class ValueEncodingPool final {
+  using value_t = typename ValueStoreT::value_t;
+
+ public:
+  ValueEncodingPool(ValueStoreT* value_store, const size_t number_of_threads) : value_store_(value_store) {
+    for (size_t i = 0; i < std::max<size_t>(1, number_of_threads); ++i) {
+      auto encoder = value_store_->CreateEncoder();
+      workers_.emplace_back([this, encoder = std::move(encoder)]() { Run(encoder.get()); });
+    }
+  }
+
+  ~ValueEncodingPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    work_available_.notify_all();
+
+    for (std::thread& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  ValueEncodingPool& operator=(ValueEncodingPool const&) = delete;
+  ValueEncodingPool(const ValueEncodingPool& that) = delete;
+
+  /**
+   * Add a batch of values to the value store.
+   *
+   * If encoding or adding a value fails, the values before it have been added and the exception is rethrown.
+   *
+   * @param values the values
+   * @param value_added called in order for every value: (index, value_idx, no_minimization)
+   */
+  template <typename CallbackT>
+  void AddValues(const std::vector<value_t>& values, CallbackT value_added) {
+    if (values.empty()) {
+      return;
+    }
+
+    const size_t number_of_blocks = (values.size() + VALUE_ENCODING_BLOCK_SIZE - 1) / VALUE_ENCODING_BLOCK_SIZE;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (encoded_values_.size() < values.size()) {
+        encoded_values_.resize(values.size());
+      }
+      values_ = &values;
+      number_of_blocks_ = number_of_blocks;
+      next_block_ = 0;
+      finished_blocks_ = 0;
+      blocks_done_.assign(number_of_blocks, false);
+    }
+    work_available_.notify_all();
+
+    try {
+      for (size_t block = 0; block < number_of_blocks; ++block) {
+        {
+          std::unique_lock<std::mutex> lock(mutex_);
+          block_done_.wait(lock, [this, block] { return blocks_done_[block]; });
+        }
+
+        const size_t end = std::min(values.size(), (block + 1) * VALUE_ENCODING_BLOCK_SIZE);
+        for (size_t i = block * VALUE_ENCODING_BLOCK_SIZE; i < end; ++i) {
+          const EncodedValue& encoded = encoded_values_[i];
+          if (encoded.error) {
+            std::rethrow_exception(encoded.error);
+          }
+
+          bool no_minimization = false;
+          const uint64_t value_idx = value_store_->AddEncodedValue(encoded.buffer.data(), encoded.buffer.size(),
+                                                                   encoded.hashcode, &no_minimization);
+          value_added(i, value_idx, no_minimization);
+        }
+      }
+    } catch (...) {
+      // the workers still access the values
+      WaitForAllBlocks();
+      throw;
+    }
+
+    WaitForAllBlocks();
+  }
+
+ private:
+  struct EncodedValue {
+    compression::buffer_t buffer;
+    int32_t hashcode = 0;
+    std::exception_ptr error;
+  };
+
+  ValueStoreT* value_store_;
+  std::vector<std::thread> workers_;
+  std::vector<EncodedValue> encoded_values_;
+
+  // guarded by mutex_
+  std::mutex mutex_;
+  std::condition_variable work_available_;
+  std::condition_variable block_done_;
+  const std::vector<value_t>* values_ = nullptr;
+  size_t number_of_blocks_ = 0;
+  size_t next_block_ = 0;
+  std::vector<bool> blocks_done_;
+  size_t finished_blocks_ = 0;
+  bool stop_ = false;
+
+  template <typename EncoderT>
+  void Run(EncoderT* encoder) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    for (;;) {
+      work_available_.wait(lock, [this] { return stop_ || next_block_ < number_of_blocks_; });
+      if (stop_) {
+        return;
+      }
+
+      const size_t block = next_block_++;
+      const std::vector<value_t>& values = *values_;
+      lock.unlock();
+
+      const size_t end = std::min(values.size(), (block + 1) * VALUE_ENCODING_BLOCK_SIZE);
+      for (size_t i = block * VALUE_ENCODING_BLOCK_SIZE; i < end; ++i) {
+        EncodedValue& encoded = encoded_values_[i];
+        encoded.error = nullptr;
+
+        try {
+          encoder->Encode(values[i], &encoded.buffer);
+          encoded.hashcode = GetValueHashcode(encoded.buffer.data(), encoded.buffer.size());
+        } catch (...) {
+          encoded.error = std::current_exception();
+        }
+      }
+
+      lock.lock();
+      blocks_done_[block] = true;
+      ++finished_blocks_;
+      block_done_.notify_all();
+    }
+  }
+
+  void WaitForAllBlocks() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    block_done_.wait(lock, [this] { return finished_blocks_ == number_of_blocks_; });
+    values_ = nullptr;
+    number_of_blocks_ = 0;
+  }
+};
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_ENCODING_POOL_H_
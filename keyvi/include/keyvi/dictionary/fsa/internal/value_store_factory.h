@@ -25,6 +25,8 @@
 #ifndef KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_STORE_FACTORY_H_
 #define KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_STORE_FACTORY_H_
 
+#include <memory>
+
 #include "keyvi/dictionary/fsa/internal/float_vector_value_store.h"
 #include "keyvi/dictionary/fsa/internal/int_inner_weights_value_store.h"
 #include "keyvi/dictionary/fsa/internal/int_value_store.h"
@@ -32,6 +34,7 @@
 #include "keyvi/dictionary/fsa/internal/json_value_store.h"
 #include "keyvi/dictionary/fsa/internal/memory_map_flags.h"
 #include "keyvi/dictionary/fsa/internal/null_value_store.h"
+#include "keyvi/dictionary/fsa/internal/page_cache.h"
 #include "keyvi/dictionary/fsa/internal/string_value_store.h"
 #include "keyvi/dictionary/fsa/internal/value_store_properties.h"
 
@@ -44,7 +47,8 @@ class ValueStoreFactory final {
  public:
   static IValueStoreReader* MakeReader(value_store_t type, boost::interprocess::file_mapping* file_mapping,
                                        const ValueStoreProperties& properties,
-                                       loading_strategy_types loading_strategy = loading_strategy_types::lazy) {
+                                       loading_strategy_types loading_strategy = loading_strategy_types::lazy,
+                                       const std::shared_ptr<PageCache>& page_cache = std::shared_ptr<PageCache>()) {
     switch (type) {
       case value_store_t::KEY_ONLY:
         return new ValueStoreComponents<value_store_t::KEY_ONLY>::value_store_reader_t(file_mapping, properties);
@@ -52,17 +56,39 @@ class ValueStoreFactory final {
         return new ValueStoreComponents<value_store_t::INT>::value_store_reader_t(file_mapping, properties);
       case value_store_t::STRING:
         return new ValueStoreComponents<value_store_t::STRING>::value_store_reader_t(file_mapping, properties,
-                                                                                     loading_strategy);
+                                                                                     loading_strategy, page_cache);
       case value_store_t::JSON_DEPRECATED:
         throw std::invalid_argument("Deprecated Value Storage type");
       case value_store_t::JSON:
         return new ValueStoreComponents<value_store_t::JSON>::value_store_reader_t(file_mapping, properties,
-                                                                                   loading_strategy);
+                                                                                   loading_strategy, page_cache);
       case value_store_t::INT_WITH_WEIGHTS:
         return new ValueStoreComponents<value_store_t::INT_WITH_WEIGHTS>::value_store_reader_t(file_mapping,
                                                                                                properties);
       case value_store_t::FLOAT_VECTOR:
-        return new ValueStoreComponents<value_store_t::FLOAT_VECTOR>::value_store_reader_t(file_mapping, properties);
+        return new ValueStoreComponents<value_store_t::FLOAT_VECTOR>::value_store_reader_t(
+            file_mapping, properties, loading_strategy, page_cache);
+      default:
+        throw std::invalid_argument("Unknown Value Storage type");
+    }
+  }
+
+  static IValueStoreReader* MakeReader(value_store_t type, const char* buffer, const ValueStoreProperties& properties) {
+    switch (type) {
+      case value_store_t::KEY_ONLY:
+        return new ValueStoreComponents<value_store_t::KEY_ONLY>::value_store_reader_t(buffer, properties);
+      case value_store_t::INT:
+        return new ValueStoreComponents<value_store_t::INT>::value_store_reader_t(buffer, properties);
+      case value_store_t::STRING:
+        return new ValueStoreComponents<value_store_t::STRING>::value_store_reader_t(buffer, properties);
+      case value_store_t::JSON_DEPRECATED:
+        throw std::invalid_argument("Deprecated Value Storage type");
+      case value_store_t::JSON:
+        return new ValueStoreComponents<value_store_t::JSON>::value_store_reader_t(buffer, properties);
+      case value_store_t::INT_WITH_WEIGHTS:
+        return new ValueStoreComponents<value_store_t::INT_WITH_WEIGHTS>::value_store_reader_t(buffer, properties);
+      case value_store_t::FLOAT_VECTOR:
+        return new ValueStoreComponents<value_store_t::FLOAT_VECTOR>::value_store_reader_t(buffer, properties);
       default:
         throw std::invalid_argument("Unknown Value Storage type");
     }
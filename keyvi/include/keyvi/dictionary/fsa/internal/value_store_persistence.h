@@ -25,10 +25,13 @@
 #ifndef KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_STORE_PERSISTENCE_H_
 #define KEYVI_DICTIONARY_FSA_INTERNAL_VALUE_STORE_PERSISTENCE_H_
 
+#include <array>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <limits>
 
+#include "keyvi/dictionary/fsa/internal/intrinsics.h"
 #include "keyvi/util/vint.h"
 
 // #define ENABLE_TRACING
@@ -39,6 +42,60 @@ namespace dictionary {
 namespace fsa {
 namespace internal {
 
+/**
+ * CRC32C (Castagnoli) checksum, using the crc32 instruction of SSE 4.2 if available.
+ */
+inline uint32_t Crc32c(const char* data, size_t size) {
+  uint32_t crc = 0xFFFFFFFF;
+
+#if defined(KEYVI_SSE42)
+  uint64_t crc64 = crc;
+  for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), data += sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(uint64_t));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+
+  crc = static_cast<uint32_t>(crc64);
+  for (; size > 0; --size, ++data) {
+    crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*data));
+  }
+#else
+  static const std::array<uint32_t, 256> table = [] {
+    std::array<uint32_t, 256> t{};
+    for (uint32_t i = 0; i < 256; ++i) {
+      uint32_t c = i;
+      for (size_t bit = 0; bit < 8; ++bit) {
+        c = (c & 1) ? (c >> 1) ^ 0x82F63B78 : c >> 1;
+      }
+      t[i] = c;
+    }
+    return t;
+  }();
+
+  for (; size > 0; --size, ++data) {
+    crc = table[(crc ^ static_cast<uint8_t>(*data)) & 0xFF] ^ (crc >> 8);
+  }
+#endif
+
+  return ~crc;
+}
+
+/**
+ * Hashcode of a value, used to find duplicate values in the value stores.
+ *
+ * Besides selecting the bucket the full hashcode is kept in RawPointer as a fingerprint, only if it matches (and the
+ * length) the stored value gets read for verification.
+ */
+template <class HashCodeTypeT = int32_t>
+inline HashCodeTypeT GetValueHashcode(const char* value, size_t value_size) {
+  const HashCodeTypeT h = static_cast<HashCodeTypeT>(Crc32c(value, value_size));
+
+  TRACE("hashcode %d", h);
+
+  return h;
+}
+
 template <class HashCodeTypeT = int32_t>
 struct RawPointer final {
  public:
@@ -80,18 +137,10 @@ template <class PersistenceT, class HashCodeTypeT = int32_t>
 struct RawPointerForCompare final {
  public:
   RawPointerForCompare(const char* value, size_t value_size, PersistenceT* persistence)
-      : value_(value), value_size_(value_size), persistence_(persistence) {
-    // calculate a hashcode
-    HashCodeTypeT h = 31;
-
-    for (size_t i = 0; i < value_size_; ++i) {
-      h = (h * 54059) ^ (value[i] * 76963);
-    }
+      : RawPointerForCompare(value, value_size, GetValueHashcode<HashCodeTypeT>(value, value_size), persistence) {}
 
-    TRACE("hashcode %d", h);
-
-    hashcode_ = h;
-  }
+  RawPointerForCompare(const char* value, size_t value_size, HashCodeTypeT hashcode, PersistenceT* persistence)
+      : value_(value), value_size_(value_size), persistence_(persistence), hashcode_(hashcode) {}
 
   HashCodeTypeT GetHashcode() const { return hashcode_; }
 
@@ -150,18 +199,11 @@ template <class PersistenceT, class HashCodeTypeT = int32_t>
 struct RawPointerForCompareString final {
  public:
   RawPointerForCompareString(const char* value, size_t value_size, PersistenceT* persistence)
-      : value_(value), value_size_(value_size), persistence_(persistence) {
-    // calculate a hashcode
-    HashCodeTypeT h = 31;
-
-    for (size_t i = 0; i < value_size_; ++i) {
-      h = (h * 54059) ^ (value[i] * 76963);
-    }
-
-    TRACE("hashcode %d", h);
+      : RawPointerForCompareString(value, value_size, GetValueHashcode<HashCodeTypeT>(value, value_size),
+                                   persistence) {}
 
-    hashcode_ = h;
-  }
+  RawPointerForCompareString(const char* value, size_t value_size, HashCodeTypeT hashcode, PersistenceT* persistence)
+      : value_(value), value_size_(value_size), persistence_(persistence), hashcode_(hashcode) {}
 
   HashCodeTypeT GetHashcode() const { return hashcode_; }
 
@@ -0,0 +1,182 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * segment_loser_tree.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_FSA_SEGMENT_LOSER_TREE_H_
+#define KEYVI_DICTIONARY_FSA_SEGMENT_LOSER_TREE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "keyvi/dictionary/fsa/entry_iterator.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+
+/**
+ * Tournament tree (loser tree) for a k-way merge of sorted segments.
+ *
+ * Every inner node keeps the loser of the match played at it, so advancing the winner only replays the matches on the
+ * path from its leaf to the root: log2(k) comparisons, a heap needs up to twice as many plus the pop and push.
+ *
+ * The first 8 bytes of every key are cached as a big endian integer, most matches between different keys are decided
+ * by a single integer comparison without touching the keys.
+ *
+ * For equal keys the segment with the higher index wins, so it comes first and a merge can keep the most recent value.
+ */
+class SegmentLoserTree final {
+ public:
+  explicit SegmentLoserTree(const std::vector<EntryIterator>& segments) {
+    size_t capacity = 1;
+    while (capacity < segments.size()) {
+      capacity *= 2;
+    }
+
+    // unused leaves are exhausted and lose every match
+    leaves_.resize(capacity);
+    for (size_t i = 0; i < segments.size(); ++i) {
+      leaves_[i].iterator = segments[i];
+      UpdateLeaf(i);
+    }
+
+    losers_.resize(capacity);
+    winner_ = Build(1);
+  }
+
+  bool Empty() const { return leaves_[winner_].exhausted; }
+
+  /**
+   * The iterator with the smallest key.
+   */
+  const EntryIterator& Top() const { return leaves_[winner_].iterator; }
+
+  /**
+   * The index of the segment the smallest key belongs to.
+   */
+  size_t TopSegment() const { return winner_; }
+
+  /**
+   * Advance the iterator with the smallest key.
+   */
+  void Next() {
+    ++leaves_[winner_].iterator;
+    UpdateLeaf(winner_);
+
+    size_t winner = winner_;
+    for (size_t node = (winner_ + leaves_.size()) / 2; node > 0; node /= 2) {
+      if (Beats(losers_[node], winner)) {
+        std::swap(losers_[node], winner);
+      }
+    }
+
+    winner_ = winner;
+  }
+
+ private:
+  struct Leaf {
+    EntryIterator iterator;
+    uint64_t prefix = 0;
+    bool exhausted = true;
+  };
+
+  std::vector<Leaf> leaves_;
+  // inner nodes, index 1 is the root, children of node n are 2n and 2n + 1, leaves start at leaves_.size()
+  std::vector<size_t> losers_;
+  size_t winner_ = 0;
+
+  size_t Build(const size_t node) {
+    if (node >= leaves_.size()) {
+      return node - leaves_.size();
+    }
+
+    const size_t left = Build(2 * node);
+    const size_t right = Build(2 * node + 1);
+
+    if (Beats(left, right)) {
+      losers_[node] = right;
+      return left;
+    }
+
+    losers_[node] = left;
+    return right;
+  }
+
+  void UpdateLeaf(const size_t leaf) {
+    Leaf& l = leaves_[leaf];
+    l.exhausted = l.iterator == EndIterator();
+    l.prefix = 0;
+
+    if (l.exhausted) {
+      return;
+    }
+
+    // zero padding keeps the order: if the prefixes differ, the keys differ in the same way
+    const std::string_view key = l.iterator.GetKeyView();
+    const size_t length = std::min<size_t>(key.size(), sizeof(uint64_t));
+    for (size_t i = 0; i < length; ++i) {
+      l.prefix |= static_cast<uint64_t>(static_cast<unsigned char>(key[i])) << (56 - 8 * i);
+    }
+  }
+
+  inline bool Beats(const size_t a, const size_t b) const {
+    const Leaf& leaf_a = leaves_[a];
+    const Leaf& leaf_b = leaves_[b];
+
+    if (leaf_a.exhausted) {
+      return false;
+    }
+
+    if (leaf_b.exhausted) {
+      return true;
+    }
+
+    if (leaf_a.prefix != leaf_b.prefix) {
+      return leaf_a.prefix < leaf_b.prefix;
+    }
+
+    const int compare = leaf_a.iterator.GetKeyView().compare(leaf_b.iterator.GetKeyView());
+    if (compare != 0) {
+      return compare < 0;
+    }
+
+    return a > b;
+  }
+
+  static const EntryIterator& EndIterator() {
+    static EntryIterator end_it;
+    return end_it;
+  }
+};
+
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_FSA_SEGMENT_LOSER_TREE_H_
@@ -38,6 +38,7 @@
 #include "keyvi/dictionary/fsa/traverser_types.h"
 #include "keyvi/dictionary/fsa/zip_state_traverser.h"
 #include "keyvi/dictionary/match.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 #include "keyvi/dictionary/util/utf8_utils.h"
 #include "keyvi/stringdistance/levenshtein.h"
 
@@ -235,8 +236,20 @@ class FuzzyMatching final {
 
   Match FirstMatch() const { return first_match_; }
 
+  /**
+   * Limit the work of this matcher, once the budget is exhausted no further matches are returned.
+   *
+   * @param budget the budget, check it for truncation after iterating
+   */
+  void SetBudget(const util::traversal_budget_t& budget) { budget_ = budget; }
+
   Match NextMatch() {
     for (; traverser_ptr_ && *traverser_ptr_; (*traverser_ptr_)++) {
+      if (budget_ && !budget_->VisitState()) {
+        TRACE("budget exhausted, stop traversal");
+        return Match();
+      }
+
       TRACE("metric->put %lu  depth: %lu", traverser_ptr_->GetStateLabel(), candidate_length() - 1);
       const int32_t intermediate_score = metric_ptr_->Put(traverser_ptr_->GetStateLabel(), candidate_length() - 1);
       // don't consider subtrees which can not be matched anyways
@@ -284,6 +297,7 @@ class FuzzyMatching final {
   const int32_t max_edit_distance_;
   const size_t exact_prefix_;
   const Match first_match_;
+  util::traversal_budget_t budget_;
 
   // reset method for the index in the special case the match is deleted
   template <class MatcherT, class DeletedT>
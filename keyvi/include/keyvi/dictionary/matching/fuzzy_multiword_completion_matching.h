@@ -35,6 +35,7 @@
 #include "keyvi/dictionary/fsa/zip_state_traverser.h"
 #include "keyvi/dictionary/match.h"
 #include "keyvi/dictionary/util/transform.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 #include "keyvi/dictionary/util/utf8_utils.h"
 #include "keyvi/stringdistance/levenshtein.h"
 #include "utf8.h"
@@ -204,8 +205,20 @@ class FuzzyMultiwordCompletionMatching final {
 
   Match FirstMatch() const { return first_match_; }
 
+  /**
+   * Limit the work of this matcher, once the budget is exhausted no further matches are returned.
+   *
+   * @param budget the budget, check it for truncation after iterating
+   */
+  void SetBudget(const util::traversal_budget_t& budget) { budget_ = budget; }
+
   Match NextMatch() {
     for (; traverser_ptr_ && *traverser_ptr_; (*traverser_ptr_)++) {
+      if (budget_ && !budget_->VisitState()) {
+        TRACE("budget exhausted, stop traversal");
+        return Match();
+      }
+
       uint64_t label = traverser_ptr_->GetStateLabel();
       TRACE("label [%c] prefix length %ld traverser depth: %ld", label, prefix_length_, traverser_ptr_->GetDepth());
 
@@ -285,6 +298,7 @@ class FuzzyMultiwordCompletionMatching final {
  private:
   std::unique_ptr<innerTraverserType> traverser_ptr_;
   const Match first_match_;
+  util::traversal_budget_t budget_;
   std::unique_ptr<stringdistance::LevenshteinCompletion> distance_metric_;
   const int32_t max_edit_distance_ = 0;
   const size_t prefix_length_ = 0;
@@ -33,6 +33,7 @@
 #include "keyvi/dictionary/fsa/zip_state_traverser.h"
 #include "keyvi/dictionary/match.h"
 #include "keyvi/dictionary/util/transform.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 
 // #define ENABLE_TRACING
 #include "keyvi/dictionary/util/trace.h"
@@ -173,8 +174,20 @@ class MultiwordCompletionMatching final {
 
   Match FirstMatch() const { return first_match_; }
 
+  /**
+   * Limit the work of this matcher, once the budget is exhausted no further matches are returned.
+   *
+   * @param budget the budget, check it for truncation after iterating
+   */
+  void SetBudget(const util::traversal_budget_t& budget) { budget_ = budget; }
+
   Match NextMatch() {
     for (; traverser_ptr_ && *traverser_ptr_; (*traverser_ptr_)++) {
+      if (budget_ && !budget_->VisitState()) {
+        TRACE("budget exhausted, stop traversal");
+        return Match();
+      }
+
       unsigned char label = traverser_ptr_->GetStateLabel();
       if (label == multiword_separator_) {
         multiword_boundary_ = traverser_ptr_->GetDepth();
@@ -231,6 +244,7 @@ class MultiwordCompletionMatching final {
  private:
   std::unique_ptr<innerTraverserType> traverser_ptr_;
   const Match first_match_;
+  util::traversal_budget_t budget_;
   std::unique_ptr<std::vector<unsigned char>> traversal_stack_;
   const size_t prefix_length_ = 0;
   const unsigned char multiword_separator_ = 0;
@@ -33,6 +33,7 @@
 #include "keyvi/dictionary/fsa/traverser_types.h"
 #include "keyvi/dictionary/fsa/zip_state_traverser.h"
 #include "keyvi/dictionary/match.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 
 // #define ENABLE_TRACING
 #include "keyvi/dictionary/util/trace.h"
@@ -184,9 +185,21 @@ class NearMatching final {
 
   Match FirstMatch() const { return first_match_; }
 
+  /**
+   * Limit the work of this matcher, once the budget is exhausted no further matches are returned.
+   *
+   * @param budget the budget, check it for truncation after iterating
+   */
+  void SetBudget(const util::traversal_budget_t& budget) { budget_ = budget; }
+
   Match NextMatch() {
     TRACE("call next match %lu", matched_depth_);
     for (; traverser_ptr_ && traverser_ptr_->GetDepth() > matched_depth_;) {
+      if (budget_ && !budget_->VisitState()) {
+        TRACE("budget exhausted, stop traversal");
+        return Match();
+      }
+
       if (traverser_ptr_->IsFinalState()) {
         // optimize? fill vector upfront?
         std::string match_str =
@@ -218,6 +231,7 @@ class NearMatching final {
   std::unique_ptr<innerTraverserType> traverser_ptr_;
   const std::string exact_prefix_;
   const Match first_match_;
+  util::traversal_budget_t budget_;
   const bool greedy_ = false;
   size_t matched_depth_ = 0;
 
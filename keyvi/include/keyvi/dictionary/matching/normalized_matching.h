@@ -0,0 +1,271 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * normalized_matching.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_MATCHING_NORMALIZED_MATCHING_H_
+#define KEYVI_DICTIONARY_MATCHING_NORMALIZED_MATCHING_H_
+
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/fsa/codepoint_state_traverser.h"
+#include "keyvi/dictionary/fsa/state_traverser.h"
+#include "keyvi/dictionary/fsa/traverser_types.h"
+#include "keyvi/dictionary/match.h"
+#include "keyvi/dictionary/util/normalization_transducer.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
+#include "keyvi/stringdistance/levenshtein.h"
+#include "utf8.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace index {
+namespace internal {
+template <class MatcherT, class DeletedT>
+keyvi::dictionary::Match NextFilteredMatchSingle(const MatcherT&, const DeletedT&);
+template <class MatcherT, class DeletedT>
+keyvi::dictionary::Match NextFilteredMatch(const MatcherT&, const DeletedT&);
+}  // namespace internal
+}  // namespace index
+namespace dictionary {
+namespace matching {
+
+/**
+ * Matches keys through a normalization transducer, e.g. case-insensitive or ignoring diacritics.
+ *
+ * The transducer is applied to the code points of the fsa while traversing it and compared with the normalized query,
+ * so normalized variants of the keys are never materialized. Subtrees whose normalized form can not match anymore are
+ * pruned. Matches are returned with their original key in lexicographic order.
+ *
+ * With a max edit distance > 0 the normalized key is matched approximately (Damerau-Levenshtein), with prefix
+ * completion every key is matched whose normalized form starts with the (approximately) normalized query.
+ */
+template <class innerTraverserType = fsa::StateTraverser<>>
+class NormalizedMatching final {
+ public:
+  /**
+   * Create a normalized matcher from a single Fsa
+   *
+   * @param fsa the fsa
+   * @param query the query, normalized with the given transducer before matching
+   * @param normalization the normalization transducer
+   * @param max_edit_distance the maximum allowed edit distance of the normalized forms, 0 for exact matching
+   * @param prefix_completion whether to match all keys the normalized query is a prefix of
+   */
+  static NormalizedMatching FromSingleFsa(const fsa::automata_t& fsa, const std::string& query,
+                                          const util::normalization_transducer_t& normalization,
+                                          const int32_t max_edit_distance = 0, const bool prefix_completion = false) {
+    return NormalizedMatching(std::make_unique<fsa::CodePointStateTraverser<innerTraverserType>>(fsa), normalization,
+                              normalization->Normalize(query), max_edit_distance, prefix_completion);
+  }
+
+  // the empty key is never stored, so there is no match before traversal
+  Match FirstMatch() const { return Match(); }
+
+  /**
+   * Limit the work of this matcher, once the budget is exhausted no further matches are returned.
+   *
+   * @param budget the budget, check it for truncation after iterating
+   */
+  void SetBudget(const util::traversal_budget_t& budget) { budget_ = budget; }
+
+  Match NextMatch() {
+    for (; traverser_ptr_ && *traverser_ptr_; (*traverser_ptr_)++) {
+      if (budget_ && !budget_->VisitState()) {
+        TRACE("budget exhausted, stop traversal");
+        return Match();
+      }
+
+      const size_t depth = traverser_ptr_->GetDepth();
+      normalized_lengths_.resize(depth);
+      completion_scores_.resize(depth);
+      candidate_.resize(depth - 1);
+
+      const uint32_t codepoint = traverser_ptr_->GetStateLabel();
+      size_t normalized_length = normalized_lengths_.back();
+      int32_t completion_score = completion_scores_.back();
+
+      // once the query is completed every key below matches, but a longer prefix might still lower the score
+      if (completion_score != 0 && normalized_length != EXHAUSTED &&
+          !Consume(codepoint, &normalized_length, &completion_score)) {
+        if (completion_score == NOT_COMPLETED) {
+          traverser_ptr_->Prune();
+          continue;
+        }
+        normalized_length = EXHAUSTED;
+      }
+
+      normalized_lengths_.push_back(normalized_length);
+      completion_scores_.push_back(completion_score);
+      candidate_.push_back(codepoint);
+
+      if (!traverser_ptr_->IsFinalState()) {
+        continue;
+      }
+
+      int32_t score = completion_score;
+      if (score == NOT_COMPLETED && !prefix_completion_) {
+        score = metric_ptr_ ? scores_[normalized_length]
+                            : (normalized_length == query_.size() ? 0 : max_edit_distance_ + 1);
+      }
+
+      if (score != NOT_COMPLETED && score <= max_edit_distance_) {
+        std::string key;
+        utf8::unchecked::utf32to8(candidate_.begin(), candidate_.end(), std::back_inserter(key));
+
+        TRACE("found match %s", key.c_str());
+        Match m(0, key.size(), key, score, traverser_ptr_->GetFsa(), traverser_ptr_->GetStateValue());
+        (*traverser_ptr_)++;
+        return m;
+      }
+    }
+
+    return Match();
+  }
+
+ private:
+  static constexpr int32_t NOT_COMPLETED = -1;
+  // the normalized form can not complete the query with a lower score anymore
+  static constexpr size_t EXHAUSTED = std::numeric_limits<size_t>::max();
+
+  std::unique_ptr<fsa::CodePointStateTraverser<innerTraverserType>> traverser_ptr_;
+  util::normalization_transducer_t normalization_;
+  const std::vector<uint32_t> query_;
+  std::unique_ptr<stringdistance::Levenshtein> metric_ptr_;
+  const int32_t max_edit_distance_;
+  const bool prefix_completion_;
+  // per code point depth of the fsa: length of the normalized form and best score if the query has been completed
+  std::vector<size_t> normalized_lengths_;
+  std::vector<int32_t> completion_scores_;
+  // per length of the normalized form: score of the metric
+  std::vector<int32_t> scores_;
+  std::vector<uint32_t> candidate_;
+  util::traversal_budget_t budget_;
+
+  NormalizedMatching(std::unique_ptr<fsa::CodePointStateTraverser<innerTraverserType>>&& traverser,
+                     const util::normalization_transducer_t& normalization, std::vector<uint32_t>&& query,
+                     const int32_t max_edit_distance, const bool prefix_completion)
+      : traverser_ptr_(std::move(traverser)),
+        normalization_(normalization),
+        query_(std::move(query)),
+        max_edit_distance_(max_edit_distance),
+        prefix_completion_(prefix_completion) {
+    int32_t completion_score = NOT_COMPLETED;
+
+    if (max_edit_distance_ > 0) {
+      metric_ptr_.reset(new stringdistance::Levenshtein(query_, 20, max_edit_distance_));
+      scores_.push_back(query_.size());
+    }
+
+    if (prefix_completion_ && query_.size() <= static_cast<size_t>(max_edit_distance_)) {
+      completion_score = query_.size();
+    }
+
+    normalized_lengths_.push_back(0);
+    completion_scores_.push_back(completion_score);
+  }
+
+  /**
+   * Consume the normalized form of the given code point.
+   *
+   * @return false if no key in the subtree can match
+   */
+  bool Consume(const uint32_t codepoint, size_t* normalized_length, int32_t* completion_score) {
+    const std::vector<uint32_t>* replacement = normalization_->Lookup(codepoint);
+
+    if (replacement == nullptr) {
+      return ConsumeNormalized(codepoint, normalized_length, completion_score);
+    }
+
+    for (const uint32_t c : *replacement) {
+      if (*completion_score == 0) {
+        break;
+      }
+
+      if (!ConsumeNormalized(c, normalized_length, completion_score)) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  bool ConsumeNormalized(const uint32_t c, size_t* normalized_length, int32_t* completion_score) {
+    const size_t position = *normalized_length;
+
+    if (!metric_ptr_) {
+      if (position >= query_.size() || query_[position] != c) {
+        return false;
+      }
+
+      ++(*normalized_length);
+      if (prefix_completion_ && *normalized_length == query_.size()) {
+        *completion_score = 0;
+      }
+
+      return true;
+    }
+
+    // the metric only calculates rows within the edit distance corridor
+    if (position >= query_.size() + max_edit_distance_) {
+      return false;
+    }
+
+    const int32_t intermediate_score = metric_ptr_->Put(c, position);
+    if (query_.size() > position + 1 && intermediate_score > max_edit_distance_) {
+      return false;
+    }
+
+    ++(*normalized_length);
+    scores_.resize(*normalized_length);
+    scores_.push_back(metric_ptr_->GetScore());
+
+    if (prefix_completion_ && scores_.back() <= max_edit_distance_ &&
+        (*completion_score == NOT_COMPLETED || scores_.back() < *completion_score)) {
+      *completion_score = scores_.back();
+    }
+
+    return true;
+  }
+
+  // reset method for the index in the special case the match is deleted
+  template <class MatcherT, class DeletedT>
+  friend Match index::internal::NextFilteredMatchSingle(const MatcherT&, const DeletedT&);
+  template <class MatcherT, class DeletedT>
+  friend Match index::internal::NextFilteredMatch(const MatcherT&, const DeletedT&);
+
+  void ResetLastMatch() {}
+};
+
+} /* namespace matching */
+} /* namespace dictionary */
+} /* namespace keyvi */
+#endif  // KEYVI_DICTIONARY_MATCHING_NORMALIZED_MATCHING_H_
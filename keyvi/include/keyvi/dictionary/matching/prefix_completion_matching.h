@@ -33,6 +33,7 @@
 #include "keyvi/dictionary/fsa/traverser_types.h"
 #include "keyvi/dictionary/fsa/zip_state_traverser.h"
 #include "keyvi/dictionary/match.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 #include "keyvi/dictionary/util/utf8_utils.h"
 #include "keyvi/stringdistance/levenshtein.h"
 #include "utf8.h"
@@ -166,8 +167,20 @@ class PrefixCompletionMatching final {
 
   Match FirstMatch() const { return first_match_; }
 
+  /**
+   * Limit the work of this matcher, once the budget is exhausted no further matches are returned.
+   *
+   * @param budget the budget, check it for truncation after iterating
+   */
+  void SetBudget(const util::traversal_budget_t& budget) { budget_ = budget; }
+
   Match NextMatch() {
     for (; traverser_ptr_ && *traverser_ptr_; (*traverser_ptr_)++) {
+      if (budget_ && !budget_->VisitState()) {
+        TRACE("budget exhausted, stop traversal");
+        return Match();
+      }
+
       traversal_stack_->resize(prefix_length_ + traverser_ptr_->GetDepth() - 1);
       traversal_stack_->push_back(traverser_ptr_->GetStateLabel());
       TRACE("Current depth %d (%d)", prefix_length_ + traverser_ptr_->GetDepth() - 1, traversal_stack_->size());
@@ -202,6 +215,7 @@ class PrefixCompletionMatching final {
  private:
   std::unique_ptr<innerTraverserType> traverser_ptr_;
   const Match first_match_;
+  util::traversal_budget_t budget_;
   std::unique_ptr<std::vector<unsigned char>> traversal_stack_;
   const size_t prefix_length_ = 0;
 
@@ -0,0 +1,250 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * regex_matching.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_MATCHING_REGEX_MATCHING_H_
+#define KEYVI_DICTIONARY_MATCHING_REGEX_MATCHING_H_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/fsa/state_traverser.h"
+#include "keyvi/dictionary/fsa/traverser_types.h"
+#include "keyvi/dictionary/fsa/zip_state_traverser.h"
+#include "keyvi/dictionary/match.h"
+#include "keyvi/dictionary/util/pattern_automaton.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace index {
+namespace internal {
+template <class MatcherT, class DeletedT>
+keyvi::dictionary::Match NextFilteredMatchSingle(const MatcherT&, const DeletedT&);
+template <class MatcherT, class DeletedT>
+keyvi::dictionary::Match NextFilteredMatch(const MatcherT&, const DeletedT&);
+}  // namespace internal
+}  // namespace index
+namespace dictionary {
+namespace matching {
+
+/**
+ * Matches keys against a regular expression or glob pattern by intersecting the pattern automaton with the fsa.
+ *
+ * The literal prefix of the pattern is walked exactly, afterwards the fsa is traversed in lexicographic order and
+ * every subtree the pattern automaton can not accept is pruned, so only the matching region of the fsa is visited.
+ */
+template <class innerTraverserType = fsa::StateTraverser<>>
+class RegexMatching final {
+ public:
+  /**
+   * Create a regex matcher from a single Fsa
+   *
+   * @param fsa the fsa
+   * @param pattern the compiled pattern
+   */
+  static RegexMatching FromSingleFsa(const fsa::automata_t& fsa, util::PatternAutomaton&& pattern) {
+    const std::string prefix = pattern.GetLiteralPrefix();
+    const uint64_t state = WalkPrefix(fsa, prefix);
+
+    if (state == 0) {
+      return RegexMatching();
+    }
+
+    Match first_match;
+    const int32_t pattern_state = WalkPattern(&pattern, prefix);
+
+    if (fsa->IsFinalState(state) && pattern.IsAccepting(pattern_state)) {
+      first_match = Match(0, prefix.size(), prefix, 0, fsa, fsa->GetStateValue(state));
+    }
+
+    return RegexMatching(std::make_unique<innerTraverserType>(fsa, state), std::move(pattern), prefix, pattern_state,
+                         std::move(first_match));
+  }
+
+  /**
+   * Create a regex matcher from multiple Fsas
+   *
+   * @param fsas a vector of fsas
+   * @param pattern the compiled pattern
+   */
+  template <class zipInnerTraverserType = fsa::StateTraverser<>>
+  static RegexMatching<fsa::ZipStateTraverser<zipInnerTraverserType>> FromMulipleFsas(
+      const std::vector<fsa::automata_t>& fsas, util::PatternAutomaton&& pattern) {
+    const std::string prefix = pattern.GetLiteralPrefix();
+
+    return FromMulipleFsas<zipInnerTraverserType>(FilterWithExactPrefix(fsas, prefix), std::move(pattern), prefix);
+  }
+
+  /**
+   * Create a regex matcher from multiple Fsas with already matched literal prefix.
+   *
+   * @param fsa_start_state_pairs pairs of fsa and the state after walking the prefix
+   * @param pattern the compiled pattern
+   * @param prefix the literal prefix of the pattern
+   */
+  template <class zipInnerTraverserType = fsa::StateTraverser<>>
+  static RegexMatching<fsa::ZipStateTraverser<zipInnerTraverserType>> FromMulipleFsas(
+      const std::vector<std::pair<fsa::automata_t, uint64_t>>& fsa_start_state_pairs,
+      util::PatternAutomaton&& pattern, const std::string& prefix) {
+    if (fsa_start_state_pairs.size() == 0) {
+      return RegexMatching<fsa::ZipStateTraverser<zipInnerTraverserType>>();
+    }
+
+    Match first_match;
+    const int32_t pattern_state = WalkPattern(&pattern, prefix);
+
+    if (pattern.IsAccepting(pattern_state)) {
+      // segments later in the list take precedence
+      for (auto it = fsa_start_state_pairs.crbegin(); it != fsa_start_state_pairs.crend(); ++it) {
+        if (it->first->IsFinalState(it->second)) {
+          first_match = Match(0, prefix.size(), prefix, 0, it->first, it->first->GetStateValue(it->second));
+          break;
+        }
+      }
+    }
+
+    return RegexMatching<fsa::ZipStateTraverser<zipInnerTraverserType>>(
+        std::make_unique<fsa::ZipStateTraverser<zipInnerTraverserType>>(fsa_start_state_pairs), std::move(pattern),
+        prefix, pattern_state, std::move(first_match));
+  }
+
+  static inline std::vector<std::pair<fsa::automata_t, uint64_t>> FilterWithExactPrefix(
+      const std::vector<fsa::automata_t>& fsas, const std::string& prefix) {
+    std::vector<std::pair<fsa::automata_t, uint64_t>> fsa_start_state_pairs;
+
+    for (const fsa::automata_t& fsa : fsas) {
+      const uint64_t state = WalkPrefix(fsa, prefix);
+      if (state) {
+        fsa_start_state_pairs.emplace_back(fsa, state);
+      }
+    }
+
+    return fsa_start_state_pairs;
+  }
+
+  Match FirstMatch() const { return first_match_; }
+
+  /**
+   * Limit the work of this matcher, once the budget is exhausted no further matches are returned.
+   *
+   * @param budget the budget, check it for truncation after iterating
+   */
+  void SetBudget(const util::traversal_budget_t& budget) { budget_ = budget; }
+
+  Match NextMatch() {
+    for (; traverser_ptr_ && *traverser_ptr_; (*traverser_ptr_)++) {
+      if (budget_ && !budget_->VisitState()) {
+        TRACE("budget exhausted, stop traversal");
+        return Match();
+      }
+
+      const size_t depth = traverser_ptr_->GetDepth();
+      pattern_states_.resize(depth);
+      candidate_.resize(prefix_length_ + depth - 1);
+
+      const int32_t pattern_state = pattern_.Step(pattern_states_.back(), traverser_ptr_->GetStateLabel());
+
+      // don't consider subtrees which can not be matched anyways
+      if (pattern_state == util::PatternAutomaton::DEAD_STATE) {
+        traverser_ptr_->Prune();
+        continue;
+      }
+
+      pattern_states_.push_back(pattern_state);
+      candidate_.push_back(traverser_ptr_->GetStateLabel());
+
+      if (traverser_ptr_->IsFinalState() && pattern_.IsAccepting(pattern_state)) {
+        TRACE("found match %s", candidate_.c_str());
+        Match m(0, candidate_.size(), candidate_, 0, traverser_ptr_->GetFsa(), traverser_ptr_->GetStateValue());
+        (*traverser_ptr_)++;
+        return m;
+      }
+    }
+
+    return Match();
+  }
+
+ private:
+  std::unique_ptr<innerTraverserType> traverser_ptr_;
+  util::PatternAutomaton pattern_;
+  // state of the pattern automaton per depth, index 0 is the state after the prefix
+  std::vector<int32_t> pattern_states_;
+  std::string candidate_;
+  const size_t prefix_length_;
+  const Match first_match_;
+  util::traversal_budget_t budget_;
+
+  RegexMatching(std::unique_ptr<innerTraverserType>&& traverser, util::PatternAutomaton&& pattern,
+                const std::string& prefix, const int32_t pattern_state, Match&& first_match)
+      : traverser_ptr_(std::move(traverser)),
+        pattern_(std::move(pattern)),
+        pattern_states_({pattern_state}),
+        candidate_(prefix),
+        prefix_length_(prefix.size()),
+        first_match_(std::move(first_match)) {}
+
+  RegexMatching() : pattern_(util::PatternAutomaton::FromRegex("")), prefix_length_(0) {}
+
+  template <class otherInnerTraverserType>
+  friend class RegexMatching;
+
+  static uint64_t WalkPrefix(const fsa::automata_t& fsa, const std::string& prefix) {
+    uint64_t state = fsa->GetStartState();
+
+    for (size_t i = 0; state != 0 && i < prefix.size(); ++i) {
+      state = fsa->TryWalkTransition(state, prefix[i]);
+    }
+
+    return state;
+  }
+
+  static int32_t WalkPattern(util::PatternAutomaton* pattern, const std::string& prefix) {
+    int32_t pattern_state = pattern->GetStartState();
+
+    for (const char c : prefix) {
+      pattern_state = pattern->Step(pattern_state, c);
+    }
+
+    return pattern_state;
+  }
+
+  // reset method for the index in the special case the match is deleted
+  template <class MatcherT, class DeletedT>
+  friend Match index::internal::NextFilteredMatchSingle(const MatcherT&, const DeletedT&);
+  template <class MatcherT, class DeletedT>
+  friend Match index::internal::NextFilteredMatch(const MatcherT&, const DeletedT&);
+
+  void ResetLastMatch() {}
+};
+
+} /* namespace matching */
+} /* namespace dictionary */
+} /* namespace keyvi */
+#endif  // KEYVI_DICTIONARY_MATCHING_REGEX_MATCHING_H_
@@ -0,0 +1,267 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * text_matching.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_MATCHING_TEXT_MATCHING_H_
+#define KEYVI_DICTIONARY_MATCHING_TEXT_MATCHING_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/match.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace matching {
+
+/**
+ * Matches dictionary entries in a text, matches start and end at token boundaries (space).
+ *
+ * A walk through the fsa starts at every token and all walks advance together character by character, so matches are
+ * returned as soon as they are known. Walks that reach the same state share their transitions, as they continue the
+ * same way. In leftmost-longest mode walks starting within a match of the leftmost walk are dropped as soon as that
+ * match is known, instead of walking them until they fail.
+ *
+ * Without shared states or overlapping matches every token still costs a walk of the length of its longest candidate,
+ * the same as LookupText.
+ */
+class TextMatching final {
+ public:
+  /**
+   * Create a text matcher from a single Fsa
+   *
+   * @param fsa the fsa
+   * @param text the text to match
+   * @param leftmost_longest if true return non-overlapping leftmost longest matches, otherwise all matches
+   */
+  static TextMatching FromSingleFsa(const fsa::automata_t& fsa, const std::string& text,
+                                    const bool leftmost_longest = true) {
+    return TextMatching(fsa, text, leftmost_longest);
+  }
+
+  Match NextMatch() {
+    while (matches_.empty() && Advance()) {
+    }
+
+    if (matches_.empty()) {
+      return Match();
+    }
+
+    Match m = std::move(matches_.front());
+    matches_.pop_front();
+    return m;
+  }
+
+ private:
+  struct Walk {
+    size_t start;
+    size_t match_end;
+    uint64_t match_state;
+    bool running;
+  };
+
+  // walks in the same state, given by their ids
+  struct WalkGroup {
+    uint64_t state;
+    std::vector<size_t> walks;
+  };
+
+  const fsa::automata_t fsa_;
+  const std::string text_;
+  const bool leftmost_longest_;
+  size_t position_ = 0;
+  // unresolved walks ordered by start position, the walk with id i is at i - first_walk_id_
+  std::deque<Walk> walks_;
+  size_t first_walk_id_ = 0;
+  std::vector<WalkGroup> groups_;
+  // matches ending at the current position: (start, state), only used for all matches
+  std::vector<std::pair<size_t, uint64_t>> current_matches_;
+  std::deque<Match> matches_;
+
+  TextMatching(const fsa::automata_t& fsa, const std::string& text, const bool leftmost_longest)
+      : fsa_(fsa), text_(text), leftmost_longest_(leftmost_longest) {}
+
+  /**
+   * Consume the next character.
+   *
+   * @return false if the text is exhausted
+   */
+  bool Advance() {
+    if (position_ == text_.size()) {
+      if (walks_.empty()) {
+        return false;
+      }
+
+      // end of text: all walks are finished
+      groups_.clear();
+      for (Walk& walk : walks_) {
+        walk.running = false;
+      }
+      ResolveWalks();
+      return true;
+    }
+
+    if ((position_ == 0 || text_[position_ - 1] == ' ') && !WithinLeftmostMatch(position_)) {
+      walks_.push_back(Walk{position_, 0, 0, true});
+      groups_.push_back(WalkGroup{fsa_->GetStartState(), {first_walk_id_ + walks_.size() - 1}});
+    }
+
+    const unsigned char c = text_[position_];
+    const bool at_boundary = position_ + 1 == text_.size() || text_[position_ + 1] == ' ';
+    size_t remaining = 0;
+
+    for (size_t i = 0; i < groups_.size(); ++i) {
+      WalkGroup& group = groups_[i];
+      RemoveStoppedWalks(&group.walks);
+      if (group.walks.empty()) {
+        continue;
+      }
+
+      group.state = fsa_->TryWalkTransition(group.state, c);
+
+      if (!group.state) {
+        for (const size_t id : group.walks) {
+          GetWalk(id).running = false;
+        }
+        continue;
+      }
+
+      if (at_boundary && fsa_->IsFinalState(group.state)) {
+        for (const size_t id : group.walks) {
+          Walk& walk = GetWalk(id);
+          if (leftmost_longest_) {
+            walk.match_end = position_ + 1;
+            walk.match_state = group.state;
+          } else {
+            current_matches_.emplace_back(walk.start, group.state);
+          }
+        }
+      }
+
+      if (remaining != i) {
+        groups_[remaining] = std::move(group);
+      }
+      ++remaining;
+    }
+
+    groups_.resize(remaining);
+    MergeGroups();
+
+    // all matches are ordered by end, then by start
+    std::sort(current_matches_.begin(), current_matches_.end());
+    for (const auto& match : current_matches_) {
+      AddMatch(match.first, position_ + 1, match.second);
+    }
+    current_matches_.clear();
+
+    ++position_;
+    ResolveWalks();
+
+    return true;
+  }
+
+  Walk& GetWalk(const size_t id) { return walks_[id - first_walk_id_]; }
+
+  void PopWalk() {
+    walks_.pop_front();
+    ++first_walk_id_;
+  }
+
+  /**
+   * Whether the position is within the match of the leftmost walk, so a walk starting there can not match.
+   */
+  bool WithinLeftmostMatch(const size_t position) const {
+    return leftmost_longest_ && !walks_.empty() && walks_.front().match_state && position < walks_.front().match_end;
+  }
+
+  void RemoveStoppedWalks(std::vector<size_t>* walks) {
+    walks->erase(std::remove_if(walks->begin(), walks->end(),
+                                [this](const size_t id) { return id < first_walk_id_ || !GetWalk(id).running; }),
+                 walks->end());
+  }
+
+  /**
+   * Join groups of walks that reached the same state.
+   */
+  void MergeGroups() {
+    if (groups_.size() < 2) {
+      return;
+    }
+
+    std::sort(groups_.begin(), groups_.end(),
+              [](const WalkGroup& lhs, const WalkGroup& rhs) { return lhs.state < rhs.state; });
+
+    size_t merged = 0;
+    for (size_t i = 1; i < groups_.size(); ++i) {
+      if (groups_[i].state == groups_[merged].state) {
+        groups_[merged].walks.insert(groups_[merged].walks.end(), groups_[i].walks.begin(), groups_[i].walks.end());
+      } else if (++merged != i) {
+        groups_[merged] = std::move(groups_[i]);
+      }
+    }
+
+    groups_.resize(merged + 1);
+  }
+
+  /**
+   * Emit the matches of finished walks, if no walk left of them is still running.
+   */
+  void ResolveWalks() {
+    while (!walks_.empty() && !walks_.front().running) {
+      const Walk walk = walks_.front();
+      PopWalk();
+
+      if (walk.match_state) {
+        AddMatch(walk.start, walk.match_end, walk.match_state);
+
+        // skip all walks overlapping with the match
+        while (!walks_.empty() && walks_.front().start < walk.match_end) {
+          PopWalk();
+        }
+      }
+    }
+
+    // the leftmost walk matches at least up to its current match, walks starting within it can stop
+    for (size_t i = 1; i < walks_.size() && WithinLeftmostMatch(walks_[i].start); ++i) {
+      walks_[i].running = false;
+    }
+  }
+
+  void AddMatch(const size_t start, const size_t end, const uint64_t state) {
+    TRACE("text match %d-%d", start, end);
+    matches_.emplace_back(start, end, text_.substr(start, end - start), 0, fsa_, fsa_->GetStateValue(state));
+  }
+};
+
+} /* namespace matching */
+} /* namespace dictionary */
+} /* namespace keyvi */
+#endif  // KEYVI_DICTIONARY_MATCHING_TEXT_MATCHING_H_
@@ -0,0 +1,242 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * qgram_index.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_QGRAM_INDEX_H_
+#define KEYVI_DICTIONARY_QGRAM_INDEX_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <queue>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "rapidjson/document.h"
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/match.h"
+#include "keyvi/dictionary/match_iterator.h"
+#include "keyvi/dictionary/qgram_index_compiler.h"
+#include "keyvi/dictionary/util/qgrams.h"
+#include "keyvi/stringdistance/levenshtein.h"
+#include "keyvi/util/serialization_utils.h"
+#include "keyvi/util/vint.h"
+#include "utf8.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+
+/**
+ * Fuzzy matching with a q-gram index, see QGramIndexCompiler.
+ *
+ * Candidates are the keys which share enough q-grams with the query (count filter), they are verified with the
+ * Damerau-Levenshtein metric afterwards. Unlike traversal, the cost depends on the length of the ordinal lists and not
+ * on the edit distance, which makes high edit distances on long strings feasible.
+ */
+class QGramIndex final {
+ public:
+  /**
+   * @param dictionary the dictionary
+   * @param file_name the q-gram index compiled for this dictionary
+   */
+  QGramIndex(const dictionary_t& dictionary, const std::string& file_name)
+      : QGramIndex(dictionary, std::make_shared<Dictionary>(file_name)) {}
+
+  /**
+   * Candidates are resolved by ordinal, so this computes the key counts of the dictionary (see
+   * Dictionary::ComputeKeyCounts).
+   *
+   * @param dictionary the dictionary
+   * @param qgram_index the q-gram index compiled for this dictionary
+   */
+  QGramIndex(const dictionary_t& dictionary, const dictionary_t& qgram_index)
+      : dictionary_(dictionary), qgram_index_(qgram_index) {
+    rapidjson::Document manifest;
+    manifest.Parse(qgram_index_->GetManifest().c_str());
+
+    if (manifest.HasParseError() || !manifest.IsObject() || !manifest.HasMember(QGRAM_INDEX_Q_PROPERTY)) {
+      throw std::invalid_argument("not a q-gram index");
+    }
+
+    q_ = keyvi::util::SerializationUtils::GetUint64FromValueOrString(manifest, QGRAM_INDEX_Q_PROPERTY);
+    const uint64_t number_of_keys =
+        keyvi::util::SerializationUtils::GetUint64FromValueOrString(manifest, QGRAM_INDEX_NUMBER_OF_KEYS_PROPERTY);
+
+    if (number_of_keys != dictionary_->GetFsa()->GetNumberOfKeys()) {
+      throw std::invalid_argument("q-gram index does not belong to this dictionary");
+    }
+
+    dictionary_->ComputeKeyCounts();
+  }
+
+  size_t GetQ() const { return q_; }
+
+  /**
+   * Match approximate given the query and edit distance.
+   *
+   * If the query is too short for the count filter to discard anything, this falls back to traversal.
+   *
+   * @param query the query
+   * @param max_edit_distance the maximum allowed edit distance
+   * @return a match iterator, matches are returned in lexicographic order
+   */
+  MatchIterator::MatchIteratorPair GetFuzzy(const std::string& query, const int32_t max_edit_distance) const {
+    std::vector<uint32_t> codepoints;
+    utf8::unchecked::utf8to32(query.begin(), query.end(), std::back_inserter(codepoints));
+
+    std::vector<std::string> qgrams;
+    util::QGrams::GetQGrams(codepoints, q_, &qgrams);
+    const size_t number_of_qgrams = qgrams.size();
+    std::sort(qgrams.begin(), qgrams.end());
+    qgrams.erase(std::unique(qgrams.begin(), qgrams.end()), qgrams.end());
+
+    // ordinal lists are sets, a q-gram which occurs n times in the query can only be counted once
+    const int64_t threshold = util::QGrams::GetCountFilterThreshold(codepoints.size(), q_, max_edit_distance) -
+                              static_cast<int64_t>(number_of_qgrams - qgrams.size());
+
+    if (threshold <= 0) {
+      TRACE("count filter not applicable, fall back to traversal");
+      return dictionary_->GetFuzzy(query, max_edit_distance, 0);
+    }
+
+    struct delegate_payload {
+      delegate_payload(std::vector<uint32_t>&& codepoints, const int32_t max_edit_distance)
+          : metric(codepoints, 20, max_edit_distance), query_length(codepoints.size()) {}
+
+      std::vector<OrdinalList> ordinal_lists;
+      std::priority_queue<std::pair<uint64_t, size_t>, std::vector<std::pair<uint64_t, size_t>>,
+                          std::greater<std::pair<uint64_t, size_t>>>
+          heap;
+      stringdistance::Levenshtein metric;
+      const size_t query_length;
+      std::vector<uint32_t> candidate;
+    };
+
+    auto data = std::make_shared<delegate_payload>(std::move(codepoints), max_edit_distance);
+
+    for (const std::string& qgram : qgrams) {
+      Match m = qgram_index_->operator[](qgram);
+      if (!m.IsEmpty()) {
+        data->ordinal_lists.emplace_back(m.GetValueAsString());
+        if (data->ordinal_lists.back().Next()) {
+          data->heap.emplace(data->ordinal_lists.back().GetOrdinal(), data->ordinal_lists.size() - 1);
+        }
+      }
+    }
+
+    TRACE("%lu of %lu q-grams found, threshold %ld", data->ordinal_lists.size(), qgrams.size(), threshold);
+
+    auto func = [data, dictionary = dictionary_, max_edit_distance, threshold]() {
+      while (!data->heap.empty()) {
+        const uint64_t ordinal = data->heap.top().first;
+        int64_t count = 0;
+
+        // count the lists containing the ordinal, the heap merges them in ordinal order
+        while (!data->heap.empty() && data->heap.top().first == ordinal) {
+          const size_t list = data->heap.top().second;
+          data->heap.pop();
+          ++count;
+
+          if (data->ordinal_lists[list].Next()) {
+            data->heap.emplace(data->ordinal_lists[list].GetOrdinal(), list);
+          }
+        }
+
+        if (count < threshold) {
+          continue;
+        }
+
+        // verify the candidate
+        Match m = dictionary->Select(ordinal);
+        const std::string& key = m.GetMatchedString();
+        data->candidate.clear();
+        utf8::unchecked::utf8to32(key.begin(), key.end(), std::back_inserter(data->candidate));
+
+        const size_t length_difference = data->candidate.size() > data->query_length
+                                             ? data->candidate.size() - data->query_length
+                                             : data->query_length - data->candidate.size();
+        if (length_difference > static_cast<size_t>(max_edit_distance)) {
+          continue;
+        }
+
+        for (size_t i = 0; i < data->candidate.size(); ++i) {
+          data->metric.Put(data->candidate[i], i);
+        }
+
+        if (data->metric.GetScore() <= max_edit_distance) {
+          TRACE("found match %s", key.c_str());
+          m.SetScore(data->metric.GetScore());
+          return m;
+        }
+      }
+
+      return Match();
+    };
+
+    return MatchIterator::MakeIteratorPair(func);
+  }
+
+ private:
+  /**
+   * Decoder for a delta and varint encoded ordinal list.
+   */
+  class OrdinalList final {
+   public:
+    explicit OrdinalList(std::string&& encoded_ordinals) : encoded_ordinals_(std::move(encoded_ordinals)) {}
+
+    bool Next() {
+      if (position_ == encoded_ordinals_.size()) {
+        return false;
+      }
+
+      const uint8_t* input = reinterpret_cast<const uint8_t*>(encoded_ordinals_.data()) + position_;
+      next_ordinal_ += keyvi::util::decodeVarInt(input);
+      position_ += keyvi::util::skipVarInt(encoded_ordinals_.data() + position_);
+      return true;
+    }
+
+    uint64_t GetOrdinal() const { return next_ordinal_ - 1; }
+
+   private:
+    std::string encoded_ordinals_;
+    size_t position_ = 0;
+    uint64_t next_ordinal_ = 0;
+  };
+
+  dictionary_t dictionary_;
+  dictionary_t qgram_index_;
+  size_t q_;
+};
+
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_QGRAM_INDEX_H_
@@ -0,0 +1,383 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * qgram_index_compiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_QGRAM_INDEX_COMPILER_H_
+#define KEYVI_DICTIONARY_QGRAM_INDEX_COMPILER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "rapidjson/stringbuffer.h"
+#include "rapidjson/writer.h"
+
+#include "keyvi/dictionary/dictionary_types.h"
+#include "keyvi/dictionary/fsa/automata.h"
+#include "keyvi/dictionary/fsa/entry_iterator.h"
+#include "keyvi/dictionary/util/qgrams.h"
+#include "keyvi/util/configuration.h"
+#include "keyvi/util/vint.h"
+#include "utf8.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+
+static const char QGRAM_INDEX_Q_PROPERTY[] = "q";
+static const char QGRAM_INDEX_NUMBER_OF_KEYS_PROPERTY[] = "number_of_keys";
+
+/**
+ * Compiles a q-gram index for a dictionary, mapping every padded q-gram to the ordinals of the keys containing it.
+ *
+ * The index is a string dictionary itself, the value of a q-gram is its ordinal list, delta and varint encoded. As the
+ * first delta is ordinal + 1 and ordinals are unique, no delta is 0 and the encoding never contains a 0 byte.
+ *
+ * Ordinals refer to the lexicographic order of the keys, the index is only valid for the dictionary it was built for.
+ *
+ * Half of the memory limit is used to buffer postings, if they exceed it they are written to temporary files as
+ * partial postings for consecutive ranges of ordinals and merged at the end. The other half is left to the compiler of
+ * the index.
+ */
+class QGramIndexCompiler final {
+ public:
+  /**
+   * @param fsa the dictionary to index
+   * @param q the length of a q-gram in code points
+   * @param params compiler parameters, e.g. memory limit and temporary path
+   */
+  explicit QGramIndexCompiler(const fsa::automata_t& fsa, const size_t q = 3,
+                              const keyvi::util::parameters_t& params = keyvi::util::parameters_t())
+      : fsa_(fsa), q_(q), params_(params) {
+    if (q_ < 2) {
+      throw std::invalid_argument("q must be at least 2");
+    }
+
+    const size_t memory_limit = keyvi::util::mapGetMemory(params_, MEMORY_LIMIT_KEY, DEFAULT_MEMORY_LIMIT_COMPILER);
+    if (memory_limit < 2 * 1024 * 1024) {
+      throw compiler_exception("Memory limit must be at least 2MB");
+    }
+
+    postings_memory_limit_ = memory_limit / 2;
+    params_[MEMORY_LIMIT_KEY] = std::to_string(memory_limit - postings_memory_limit_);
+
+    temporary_directory_ = keyvi::util::mapGetTemporaryPath(params_);
+    temporary_directory_ /= boost::filesystem::unique_path("keyvi-qgram-postings-%%%%-%%%%-%%%%-%%%%");
+  }
+
+  ~QGramIndexCompiler() {
+    if (number_of_partial_postings_ > 0) {
+      boost::filesystem::remove_all(temporary_directory_);
+    }
+  }
+
+  QGramIndexCompiler& operator=(QGramIndexCompiler const&) = delete;
+  QGramIndexCompiler(const QGramIndexCompiler& that) = delete;
+
+  void Compile() {
+    std::vector<uint32_t> codepoints;
+    std::vector<std::string> qgrams;
+    uint64_t ordinal = 0;
+
+    for (fsa::EntryIterator it(fsa_), end_it; it != end_it; ++it, ++ordinal) {
+      const std::string key = it.GetKey();
+      codepoints.clear();
+      utf8::unchecked::utf8to32(key.begin(), key.end(), std::back_inserter(codepoints));
+      util::QGrams::GetQGrams(codepoints, q_, &qgrams);
+
+      for (const std::string& qgram : qgrams) {
+        auto inserted = postings_.emplace(qgram, Posting());
+        Posting& posting = inserted.first->second;
+
+        if (inserted.second) {
+          memory_estimate_ += qgram.size() + POSTING_OVERHEAD;
+        }
+
+        // the q-gram occurs more than once in this key
+        if (posting.next_ordinal > ordinal) {
+          continue;
+        }
+
+        const size_t capacity = posting.ordinals.capacity();
+        size_t written_bytes;
+        keyvi::util::encodeVarInt(ordinal + 1 - posting.next_ordinal, &posting.ordinals, &written_bytes);
+        posting.next_ordinal = ordinal + 1;
+        memory_estimate_ += posting.ordinals.capacity() - capacity;
+      }
+
+      if (memory_estimate_ >= postings_memory_limit_) {
+        WritePartialPostings();
+      }
+    }
+
+    TRACE("indexed %lu keys, %lu partial postings", ordinal, number_of_partial_postings_);
+
+    compiler_.reset(new StringDictionaryCompiler(params_));
+    if (number_of_partial_postings_ == 0) {
+      for (auto it = postings_.begin(); it != postings_.end(); it = postings_.erase(it)) {
+        compiler_->Add(it->first, it->second.ordinals);
+      }
+    } else {
+      WritePartialPostings();
+      MergePartialPostings();
+    }
+
+    compiler_->Compile();
+    compiler_->SetManifest(GetManifest(ordinal));
+  }
+
+  void Write(std::ostream& stream) {
+    if (!compiler_) {
+      throw compiler_exception("not compiled yet");
+    }
+
+    compiler_->Write(stream);
+  }
+
+  void WriteToFile(const std::string& filename) {
+    if (!compiler_) {
+      throw compiler_exception("not compiled yet");
+    }
+
+    compiler_->WriteToFile(filename);
+  }
+
+ private:
+  // estimated memory of a posting apart from the q-gram and the ordinals: hash node, strings and bucket
+  static const size_t POSTING_OVERHEAD = 2 * sizeof(std::string) + sizeof(uint64_t) + 4 * sizeof(void*);
+
+  struct Posting {
+    std::string ordinals;
+    uint64_t next_ordinal = 0;
+  };
+
+  /**
+   * Reads partial postings written by WritePartialPostings in order of the q-grams.
+   */
+  class PartialPostingsReader final {
+   public:
+    explicit PartialPostingsReader(const std::string& filename) : in_stream_(filename, std::ios::binary) {
+      if (!in_stream_.good()) {
+        throw compiler_exception("failed to open partial postings");
+      }
+      Next();
+    }
+
+    bool HasPosting() const { return has_posting_; }
+
+    const std::string& GetQGram() const { return qgram_; }
+
+    const Posting& GetPosting() const { return posting_; }
+
+    void Next() {
+      uint64_t qgram_size;
+      has_posting_ = ReadVarInt(&qgram_size);
+      if (!has_posting_) {
+        return;
+      }
+
+      uint64_t ordinals_size;
+      qgram_.resize(qgram_size);
+      in_stream_.read(&qgram_[0], qgram_size);
+      if (!ReadVarInt(&posting_.next_ordinal) || !ReadVarInt(&ordinals_size)) {
+        throw compiler_exception("partial postings are corrupt(truncated)");
+      }
+      posting_.ordinals.resize(ordinals_size);
+      in_stream_.read(&posting_.ordinals[0], ordinals_size);
+
+      if (!in_stream_.good()) {
+        throw compiler_exception("partial postings are corrupt(truncated)");
+      }
+    }
+
+   private:
+    std::ifstream in_stream_;
+    bool has_posting_ = false;
+    std::string qgram_;
+    Posting posting_;
+
+    bool ReadVarInt(uint64_t* value) {
+      *value = 0;
+      for (size_t shift = 0; shift < 64; shift += 7) {
+        const int byte = in_stream_.get();
+        if (byte == std::char_traits<char>::eof()) {
+          return false;
+        }
+
+        *value |= static_cast<uint64_t>(byte & 127) << shift;
+        if (!(byte & 128)) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+  };
+
+  fsa::automata_t fsa_;
+  const size_t q_;
+  keyvi::util::parameters_t params_;
+  size_t postings_memory_limit_;
+  std::unordered_map<std::string, Posting> postings_;
+  size_t memory_estimate_ = 0;
+  boost::filesystem::path temporary_directory_;
+  size_t number_of_partial_postings_ = 0;
+  std::unique_ptr<StringDictionaryCompiler> compiler_;
+
+  std::string GetPartialPostingsFileName(const size_t number) const {
+    boost::filesystem::path filename(temporary_directory_);
+    filename /= "postings_";
+    filename += std::to_string(number);
+    return filename.string();
+  }
+
+  /**
+   * Write the buffered postings sorted by q-gram: q-gram, next ordinal and ordinals, strings are length prefixed.
+   */
+  void WritePartialPostings() {
+    if (number_of_partial_postings_ == 0) {
+      boost::filesystem::create_directory(temporary_directory_);
+    }
+
+    std::vector<std::unordered_map<std::string, Posting>::const_iterator> sorted_postings;
+    sorted_postings.reserve(postings_.size());
+    for (auto it = postings_.cbegin(); it != postings_.cend(); ++it) {
+      sorted_postings.push_back(it);
+    }
+    std::sort(sorted_postings.begin(), sorted_postings.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs->first < rhs->first; });
+
+    std::ofstream out_stream(GetPartialPostingsFileName(number_of_partial_postings_), std::ios::binary);
+    std::vector<uint8_t> buffer;
+    for (const auto& it : sorted_postings) {
+      size_t written_bytes;
+      buffer.clear();
+      keyvi::util::encodeVarInt(it->first.size(), &buffer, &written_bytes);
+      out_stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+      out_stream.write(it->first.data(), it->first.size());
+
+      buffer.clear();
+      keyvi::util::encodeVarInt(it->second.next_ordinal, &buffer, &written_bytes);
+      keyvi::util::encodeVarInt(it->second.ordinals.size(), &buffer, &written_bytes);
+      out_stream.write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+      out_stream.write(it->second.ordinals.data(), it->second.ordinals.size());
+    }
+
+    if (!out_stream.good()) {
+      throw compiler_exception("failed to write partial postings");
+    }
+
+    TRACE("wrote partial postings %lu with %lu q-grams", number_of_partial_postings_, postings_.size());
+    ++number_of_partial_postings_;
+    postings_.clear();
+    memory_estimate_ = 0;
+  }
+
+  /**
+   * Merge the partial postings and add them to the compiler.
+   *
+   * Partial postings cover consecutive ranges of ordinals, so the ordinals of a q-gram are concatenated in the order of
+   * the files, only the first delta of every partial posting gets rebased.
+   */
+  void MergePartialPostings() {
+    std::vector<std::unique_ptr<PartialPostingsReader>> readers;
+    for (size_t i = 0; i < number_of_partial_postings_; ++i) {
+      readers.emplace_back(new PartialPostingsReader(GetPartialPostingsFileName(i)));
+    }
+
+    std::string qgram;
+    std::string ordinals;
+    std::vector<uint8_t> buffer;
+
+    for (;;) {
+      const std::string* min_qgram = nullptr;
+      for (const auto& reader : readers) {
+        if (reader->HasPosting() && (min_qgram == nullptr || reader->GetQGram() < *min_qgram)) {
+          min_qgram = &reader->GetQGram();
+        }
+      }
+
+      if (min_qgram == nullptr) {
+        break;
+      }
+
+      qgram = *min_qgram;
+      ordinals.clear();
+      uint64_t next_ordinal = 0;
+
+      for (const auto& reader : readers) {
+        if (!reader->HasPosting() || reader->GetQGram() != qgram) {
+          continue;
+        }
+
+        const std::string& partial_ordinals = reader->GetPosting().ordinals;
+        const uint8_t* partial_ordinals_data = reinterpret_cast<const uint8_t*>(partial_ordinals.data());
+
+        // the first delta is relative to 0
+        const uint64_t first_delta = keyvi::util::decodeVarInt(partial_ordinals_data);
+        const size_t first_delta_length = keyvi::util::getVarIntLength(first_delta);
+
+        size_t written_bytes;
+        buffer.clear();
+        keyvi::util::encodeVarInt(first_delta - next_ordinal, &buffer, &written_bytes);
+        ordinals.append(buffer.begin(), buffer.end());
+        ordinals.append(partial_ordinals, first_delta_length, std::string::npos);
+
+        next_ordinal = reader->GetPosting().next_ordinal;
+        reader->Next();
+      }
+
+      compiler_->Add(qgram, ordinals);
+    }
+  }
+
+  std::string GetManifest(const uint64_t number_of_keys) const {
+    rapidjson::StringBuffer string_buffer;
+    rapidjson::Writer<rapidjson::StringBuffer> writer(string_buffer);
+
+    writer.StartObject();
+    writer.Key(QGRAM_INDEX_Q_PROPERTY);
+    writer.Uint64(q_);
+    writer.Key(QGRAM_INDEX_NUMBER_OF_KEYS_PROPERTY);
+    writer.Uint64(number_of_keys);
+    writer.EndObject();
+
+    return string_buffer.GetString();
+  }
+};
+
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_QGRAM_INDEX_COMPILER_H_
@@ -0,0 +1,144 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * key_arena.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_UTIL_KEY_ARENA_H_
+#define KEYVI_DICTIONARY_UTIL_KEY_ARENA_H_
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "keyvi/util/vint.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+static const size_t KEY_ARENA_DEFAULT_BLOCK_SIZE = 1024 * 1024;
+
+/**
+ * Append-only storage for keys, packed into large blocks instead of one allocation per key.
+ *
+ * Keys are stored length prefixed (varint), a key is referenced by a single pointer which stays valid until the arena
+ * is cleared. Keys larger than a quarter of a block get a block of their own.
+ */
+class KeyArena final {
+ public:
+  explicit KeyArena(const size_t block_size = KEY_ARENA_DEFAULT_BLOCK_SIZE) : block_size_(block_size) {}
+
+  KeyArena& operator=(KeyArena const&) = delete;
+  KeyArena(const KeyArena& that) = delete;
+
+  // references returned by Append stay valid, the moved from arena is empty
+  KeyArena(KeyArena&& other)
+      : block_size_(other.block_size_),
+        blocks_(std::move(other.blocks_)),
+        current_(std::exchange(other.current_, nullptr)),
+        remaining_(std::exchange(other.remaining_, 0)),
+        allocated_bytes_(std::exchange(other.allocated_bytes_, 0)) {
+    other.blocks_.clear();
+  }
+
+  /**
+   * Append a key.
+   *
+   * @param key the key
+   * @return a reference to the key, to be resolved with GetKey
+   */
+  const char* Append(const std::string& key) {
+    const size_t encoded_size = GetEncodedSize(key);
+    char* entry;
+
+    if (encoded_size > block_size_ / 4) {
+      blocks_.emplace_back(new char[encoded_size]);
+      entry = blocks_.back().get();
+      allocated_bytes_ += encoded_size;
+    } else {
+      if (encoded_size > remaining_) {
+        blocks_.emplace_back(new char[block_size_]);
+        current_ = blocks_.back().get();
+        remaining_ = block_size_;
+        allocated_bytes_ += block_size_;
+      }
+
+      entry = current_;
+      current_ += encoded_size;
+      remaining_ -= encoded_size;
+    }
+
+    size_t length_size;
+    keyvi::util::encodeVarInt(key.size(), reinterpret_cast<uint8_t*>(entry), &length_size);
+    std::memcpy(entry + length_size, key.data(), key.size());
+
+    return entry;
+  }
+
+  /**
+   * Resolve a key returned by Append.
+   */
+  static inline std::string_view GetKey(const char* entry) {
+    size_t length;
+    const char* key = keyvi::util::decodeVarIntString(entry, &length);
+    return std::string_view(key, length);
+  }
+
+  /**
+   * The number of bytes needed to store the given key.
+   */
+  static inline size_t GetEncodedSize(const std::string& key) {
+    return keyvi::util::getVarIntLength<uint64_t>(key.size()) + key.size();
+  }
+
+  size_t GetAllocatedBytes() const { return allocated_bytes_; }
+
+  /**
+   * Free all keys, references returned by Append become invalid.
+   */
+  void Clear() {
+    blocks_.clear();
+    current_ = nullptr;
+    remaining_ = 0;
+    allocated_bytes_ = 0;
+  }
+
+ private:
+  const size_t block_size_;
+  std::vector<std::unique_ptr<char[]>> blocks_;
+  char* current_ = nullptr;
+  size_t remaining_ = 0;
+  size_t allocated_bytes_ = 0;
+};
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_UTIL_KEY_ARENA_H_
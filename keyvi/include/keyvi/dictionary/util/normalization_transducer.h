@@ -0,0 +1,231 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * normalization_transducer.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_UTIL_NORMALIZATION_TRANSDUCER_H_
+#define KEYVI_DICTIONARY_UTIL_NORMALIZATION_TRANSDUCER_H_
+
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "utf8.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+/**
+ * A normalization transducer mapping every code point to a (possibly empty) sequence of code points, e.g. 'Ä' -> 'a',
+ * 'ß' -> "ss" or a combining diacritic to nothing.
+ *
+ * As the mapping works per code point, it can be applied while traversing a fsa, see NormalizedMatching. Rules are
+ * applied in the order they are added: a rule added later rewrites the output of the rules added before, e.g. after
+ * AddCaseFolding a mapping for 'ä' also applies to 'Ä'.
+ */
+class NormalizationTransducer final {
+ public:
+  /**
+   * Add simple case folding for Latin, Greek and Cyrillic, 'ß' is folded to "ss".
+   */
+  void AddCaseFolding() {
+    std::unordered_map<uint32_t, std::vector<uint32_t>> rules;
+
+    for (uint32_t c = 0x41; c <= 0x5a; ++c) {
+      rules[c] = {c + 0x20};
+    }
+    for (uint32_t c = 0xc0; c <= 0xde; ++c) {
+      if (c != 0xd7) {
+        rules[c] = {c + 0x20};
+      }
+    }
+    rules[0xdf] = {0x73, 0x73};
+    rules[0x1e9e] = {0x73, 0x73};
+
+    // Latin Extended-A pairs upper and lower case, the alignment changes in between
+    for (uint32_t c = 0x100; c <= 0x177; ++c) {
+      const bool upper = (c >= 0x139 && c <= 0x148) ? (c % 2 == 1) : (c % 2 == 0);
+      if (upper && c != 0x130 && c != 0x138) {
+        rules[c] = {c + 1};
+      }
+    }
+    rules[0x178] = {0xff};
+    for (uint32_t c = 0x179; c <= 0x17d; c += 2) {
+      rules[c] = {c + 1};
+    }
+
+    for (uint32_t c = 0x391; c <= 0x3ab; ++c) {
+      if (c != 0x3a2) {
+        rules[c] = {c + 0x20};
+      }
+    }
+    rules[0x3c2] = {0x3c3};
+
+    for (uint32_t c = 0x400; c <= 0x40f; ++c) {
+      rules[c] = {c + 0x50};
+    }
+    for (uint32_t c = 0x410; c <= 0x42f; ++c) {
+      rules[c] = {c + 0x20};
+    }
+
+    AddRules(rules);
+  }
+
+  /**
+   * Strip diacritics from Latin letters (Latin-1 Supplement and Latin Extended-A) and remove combining diacritical
+   * marks. Ligatures are expanded, e.g. 'æ' -> "ae".
+   */
+  void AddDiacriticStripping() {
+    // base letters for U+00C0 - U+00FF and U+0100 - U+017F, '?' marks code points which are handled separately
+    static const char latin1_supplement[] = "AAAAAA?CEEEEIIIIDNOOOOO?OUUUUY??aaaaaa?ceeeeiiiidnooooo?ouuuuy?y";
+    static const char latin_extended_a[] =
+        "AaAaAaCcCcCcCcDdDdEeEeEeEeEeGgGgGgGgHhHhIiIiIiIiIiIiJjKkkLlLlLlLlLlNnNnNnnNnOoOo"
+        "OoOoRrRrRrSsSsSsSsTtTtTtUuUuUuUuUuUuWwYyYZzZzZzs";
+    static_assert(sizeof(latin1_supplement) == 65 && sizeof(latin_extended_a) == 129, "incomplete mapping table");
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> rules;
+
+    for (uint32_t i = 0; i < 64; ++i) {
+      if (latin1_supplement[i] != '?') {
+        rules[0xc0 + i] = {static_cast<uint32_t>(latin1_supplement[i])};
+      }
+    }
+    for (uint32_t i = 0; i < 128; ++i) {
+      rules[0x100 + i] = {static_cast<uint32_t>(latin_extended_a[i])};
+    }
+
+    rules[0xc6] = {'A', 'E'};
+    rules[0xe6] = {'a', 'e'};
+    rules[0xde] = {'T', 'H'};
+    rules[0xfe] = {'t', 'h'};
+    rules[0x132] = {'I', 'J'};
+    rules[0x133] = {'i', 'j'};
+    rules[0x152] = {'O', 'E'};
+    rules[0x153] = {'o', 'e'};
+
+    for (uint32_t c = 0x300; c <= 0x36f; ++c) {
+      rules[c] = {};
+    }
+
+    AddRules(rules);
+  }
+
+  /**
+   * Add a custom mapping.
+   *
+   * @param from a single code point (utf-8 encoded)
+   * @param to the replacement (utf-8 encoded), can be empty to remove the code point
+   */
+  void AddMapping(const std::string& from, const std::string& to) {
+    std::vector<uint32_t> from_codepoints;
+    utf8::unchecked::utf8to32(from.begin(), from.end(), std::back_inserter(from_codepoints));
+
+    if (from_codepoints.size() != 1) {
+      throw std::invalid_argument("normalization mappings must map a single code point, got: " + from);
+    }
+
+    std::unordered_map<uint32_t, std::vector<uint32_t>> rules;
+    utf8::unchecked::utf8to32(to.begin(), to.end(), std::back_inserter(rules[from_codepoints[0]]));
+
+    AddRules(rules);
+  }
+
+  /**
+   * Get the replacement for the given code point.
+   *
+   * @param codepoint the code point
+   * @return the replacement or nullptr if the code point does not change
+   */
+  const std::vector<uint32_t>* Lookup(const uint32_t codepoint) const {
+    auto it = mappings_.find(codepoint);
+    return it == mappings_.end() ? nullptr : &it->second;
+  }
+
+  /**
+   * Normalize the given input.
+   *
+   * @param input the input (utf-8 encoded)
+   * @return the normalized code points
+   */
+  std::vector<uint32_t> Normalize(const std::string& input) const {
+    std::vector<uint32_t> codepoints;
+    utf8::unchecked::utf8to32(input.begin(), input.end(), std::back_inserter(codepoints));
+
+    std::vector<uint32_t> normalized;
+    normalized.reserve(codepoints.size());
+    Apply(codepoints, mappings_, &normalized);
+
+    return normalized;
+  }
+
+ private:
+  std::unordered_map<uint32_t, std::vector<uint32_t>> mappings_;
+
+  /**
+   * Compose the existing mappings with the given rules.
+   */
+  void AddRules(const std::unordered_map<uint32_t, std::vector<uint32_t>>& rules) {
+    std::vector<uint32_t> rewritten;
+
+    for (auto& mapping : mappings_) {
+      rewritten.clear();
+      Apply(mapping.second, rules, &rewritten);
+      mapping.second.swap(rewritten);
+    }
+
+    // emplace keeps existing mappings, their output has been rewritten already
+    for (const auto& rule : rules) {
+      mappings_.emplace(rule.first, rule.second);
+    }
+
+    TRACE("normalization transducer with %lu mappings", mappings_.size());
+  }
+
+  static void Apply(const std::vector<uint32_t>& input,
+                    const std::unordered_map<uint32_t, std::vector<uint32_t>>& rules, std::vector<uint32_t>* output) {
+    for (const uint32_t c : input) {
+      auto it = rules.find(c);
+      if (it == rules.end()) {
+        output->push_back(c);
+      } else {
+        output->insert(output->end(), it->second.begin(), it->second.end());
+      }
+    }
+  }
+};
+
+typedef std::shared_ptr<const NormalizationTransducer> normalization_transducer_t;
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_UTIL_NORMALIZATION_TRANSDUCER_H_
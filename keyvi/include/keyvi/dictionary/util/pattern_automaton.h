@@ -0,0 +1,774 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * pattern_automaton.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_UTIL_PATTERN_AUTOMATON_H_
+#define KEYVI_DICTIONARY_UTIL_PATTERN_AUTOMATON_H_
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "keyvi/dictionary/util/utf8_utils.h"
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+// upper bound for counted repetitions, e.g. a{1000}
+static const size_t PATTERN_MAX_REPETITION = 1000;
+// upper bound for the size of the NFA, as nested repetitions multiply, e.g. (a{1000}){1000}
+static const size_t PATTERN_MAX_NFA_STATES = 100000;
+
+/**
+ * A byte level automaton compiled from a regular expression or a glob pattern.
+ *
+ * The pattern is compiled into a NFA (Thompson construction), DFA states are created lazily by subset construction
+ * when they are visited. Intersecting with an fsa therefore only creates the states that the fsa can actually reach.
+ *
+ * Patterns always match the complete key. Supported regular expression syntax:
+ *
+ *  - literals, '.' (any code point), escapes '\d', '\w', '\s', '\D', '\W', '\S' and escaped meta characters
+ *  - classes '[a-z_]', negated classes '[^0-9]' (ranges and negated classes are restricted to ASCII)
+ *  - groups '(...)', alternation '|'
+ *  - quantifiers '*', '+', '?', '{m}', '{m,}', '{m,n}'
+ *
+ * Supported glob syntax: '*', '?', '[...]', '[!...]' and '\' for escaping.
+ *
+ * Patterns whose NFA would exceed PATTERN_MAX_NFA_STATES states are rejected with std::invalid_argument.
+ */
+class PatternAutomaton final {
+ public:
+  static constexpr int32_t DEAD_STATE = -1;
+
+  static PatternAutomaton FromRegex(const std::string& pattern) {
+    TRACE("compile regex %s", pattern.c_str());
+    return PatternAutomaton(pattern);
+  }
+
+  static PatternAutomaton FromGlob(const std::string& pattern) {
+    TRACE("compile glob %s", pattern.c_str());
+    return PatternAutomaton(GlobToRegex(pattern));
+  }
+
+  int32_t GetStartState() const { return 0; }
+
+  bool IsAccepting(const int32_t state) const { return state != DEAD_STATE && dfa_accepting_[state]; }
+
+  /**
+   * Get the state after consuming the given byte.
+   *
+   * @param state the current state
+   * @param c the byte to consume
+   * @return the next state or DEAD_STATE if no key can match anymore
+   */
+  int32_t Step(const int32_t state, const unsigned char c) {
+    if (state == DEAD_STATE) {
+      return DEAD_STATE;
+    }
+
+    int32_t next_state = dfa_transitions_[state][c];
+    if (next_state == UNKNOWN_STATE) {
+      std::vector<int32_t> seeds;
+      for (const int32_t nfa_state : dfa_sets_[state]) {
+        if (nfa_[nfa_state].type == NfaType::BYTES && nfa_[nfa_state].bytes[c]) {
+          seeds.push_back(nfa_[nfa_state].out);
+        }
+      }
+
+      next_state = seeds.empty() ? DEAD_STATE : AddDfaState(Closure(seeds));
+      dfa_transitions_[state][c] = next_state;
+    }
+
+    return next_state;
+  }
+
+  /**
+   * Get the prefix every match must start with.
+   *
+   * The prefix can be walked exactly, before the automaton gets intersected with the fsa.
+   */
+  std::string GetLiteralPrefix() {
+    std::string prefix;
+    std::set<int32_t> visited;
+    int32_t state = GetStartState();
+
+    while (!IsAccepting(state) && visited.insert(state).second) {
+      int32_t next_state = DEAD_STATE;
+      size_t alternatives = 0;
+      unsigned char label = 0;
+
+      for (size_t c = 0; c < 256 && alternatives < 2; ++c) {
+        const int32_t s = Step(state, static_cast<unsigned char>(c));
+        if (s != DEAD_STATE) {
+          next_state = s;
+          label = static_cast<unsigned char>(c);
+          ++alternatives;
+        }
+      }
+
+      if (alternatives != 1) {
+        break;
+      }
+
+      prefix.push_back(static_cast<char>(label));
+      state = next_state;
+    }
+
+    return prefix;
+  }
+
+  size_t GetNumberOfDfaStates() const { return dfa_sets_.size(); }
+
+ private:
+  static constexpr int32_t UNKNOWN_STATE = -2;
+
+  enum class NfaType : uint8_t { BYTES, EPSILON, MATCH };
+
+  struct NfaState {
+    NfaType type;
+    std::bitset<256> bytes;
+    int32_t out = -1;
+    int32_t out2 = -1;
+  };
+
+  struct Node {
+    enum class Type : uint8_t { BYTES, CONCAT, ALTERNATE, REPEAT };
+
+    Type type;
+    std::bitset<256> bytes;
+    std::vector<Node> children;
+    size_t min = 0;
+    size_t max = 0;
+
+    static Node Bytes(const std::bitset<256>& bytes) {
+      Node n{Type::BYTES};
+      n.bytes = bytes;
+      return n;
+    }
+
+    static Node Concat(std::vector<Node>&& children) {
+      Node n{Type::CONCAT};
+      n.children = std::move(children);
+      return n;
+    }
+
+    static Node Alternate(std::vector<Node>&& children) {
+      Node n{Type::ALTERNATE};
+      n.children = std::move(children);
+      return n;
+    }
+  };
+
+  // dangling outputs of a partially built NFA: state index and whether it is the 2nd output
+  typedef std::vector<std::pair<int32_t, bool>> outs_t;
+
+  struct Fragment {
+    int32_t start;
+    outs_t outs;
+  };
+
+  class Parser final {
+   public:
+    explicit Parser(const std::string& pattern) : pattern_(pattern) {}
+
+    Node Parse() {
+      if (position_ < pattern_.size() && pattern_[position_] == '^') {
+        ++position_;
+      }
+
+      Node node = ParseAlternation();
+
+      if (position_ != pattern_.size()) {
+        Error("unexpected ')'");
+      }
+      return node;
+    }
+
+   private:
+    const std::string& pattern_;
+    size_t position_ = 0;
+
+    [[noreturn]] void Error(const std::string& message) const {
+      throw std::invalid_argument("invalid pattern '" + pattern_ + "' at position " + std::to_string(position_) + ": " +
+                                  message);
+    }
+
+    bool AtEnd() const { return position_ == pattern_.size(); }
+
+    Node ParseAlternation() {
+      std::vector<Node> alternatives;
+      alternatives.push_back(ParseConcatenation());
+
+      while (!AtEnd() && pattern_[position_] == '|') {
+        ++position_;
+        alternatives.push_back(ParseConcatenation());
+      }
+
+      return alternatives.size() == 1 ? std::move(alternatives[0]) : Node::Alternate(std::move(alternatives));
+    }
+
+    Node ParseConcatenation() {
+      std::vector<Node> sequence;
+
+      while (!AtEnd() && pattern_[position_] != '|' && pattern_[position_] != ')') {
+        // '$' is only supported as last character, patterns are anchored anyway
+        if (pattern_[position_] == '$' && position_ + 1 == pattern_.size()) {
+          ++position_;
+          break;
+        }
+        sequence.push_back(ParseRepetition());
+      }
+
+      return Node::Concat(std::move(sequence));
+    }
+
+    Node ParseRepetition() {
+      Node node = ParseAtom();
+
+      while (!AtEnd()) {
+        size_t min = 0;
+        size_t max = std::numeric_limits<size_t>::max();
+
+        switch (pattern_[position_]) {
+          case '*':
+            ++position_;
+            break;
+          case '+':
+            ++position_;
+            min = 1;
+            break;
+          case '?':
+            ++position_;
+            max = 1;
+            break;
+          case '{':
+            ++position_;
+            min = ParseNumber();
+            if (!AtEnd() && pattern_[position_] == ',') {
+              ++position_;
+              if (!AtEnd() && pattern_[position_] != '}') {
+                max = ParseNumber();
+              }
+            } else {
+              max = min;
+            }
+            if (AtEnd() || pattern_[position_] != '}') {
+              Error("expected '}'");
+            }
+            ++position_;
+            if (max < min || min > PATTERN_MAX_REPETITION ||
+                (max != std::numeric_limits<size_t>::max() && max > PATTERN_MAX_REPETITION)) {
+              Error("invalid repetition");
+            }
+            break;
+          default:
+            return node;
+        }
+
+        Node repetition{Node::Type::REPEAT};
+        repetition.children.push_back(std::move(node));
+        repetition.min = min;
+        repetition.max = max;
+        node = std::move(repetition);
+      }
+
+      return node;
+    }
+
+    size_t ParseNumber() {
+      size_t start = position_;
+      size_t number = 0;
+      while (!AtEnd() && pattern_[position_] >= '0' && pattern_[position_] <= '9' && position_ - start < 6) {
+        number = number * 10 + (pattern_[position_++] - '0');
+      }
+
+      if (start == position_) {
+        Error("expected a number");
+      }
+      return number;
+    }
+
+    Node ParseAtom() {
+      const char c = pattern_[position_];
+
+      switch (c) {
+        case '(': {
+          ++position_;
+          Node node = ParseAlternation();
+          if (AtEnd() || pattern_[position_] != ')') {
+            Error("missing ')'");
+          }
+          ++position_;
+          return node;
+        }
+        case '[':
+          ++position_;
+          return ParseClass();
+        case '.':
+          ++position_;
+          return AnyCodePoint(AsciiRange(0, 0x7f));
+        case '\\':
+          ++position_;
+          if (AtEnd()) {
+            Error("trailing '\\'");
+          }
+          return ParseEscape(false).first;
+        case '*':
+        case '+':
+        case '?':
+        case '{':
+          Error("nothing to repeat");
+        default:
+          return ParseLiteral();
+      }
+    }
+
+    /**
+     * Parse an escape sequence.
+     *
+     * @return the node and whether it is a class (\d, \w, ...) rather than a single character
+     */
+    std::pair<Node, bool> ParseEscape(const bool in_class) {
+      const char c = pattern_[position_++];
+      std::bitset<256> bytes;
+
+      switch (c) {
+        case 'd':
+        case 'D':
+          bytes = AsciiRange('0', '9');
+          break;
+        case 'w':
+        case 'W':
+          bytes = AsciiRange('a', 'z') | AsciiRange('A', 'Z') | AsciiRange('0', '9') | AsciiRange('_', '_');
+          break;
+        case 's':
+        case 'S':
+          bytes = AsciiRange(' ', ' ') | AsciiRange('\t', '\r');
+          break;
+        case 't':
+          return {Node::Bytes(AsciiRange('\t', '\t')), false};
+        case 'n':
+          return {Node::Bytes(AsciiRange('\n', '\n')), false};
+        case 'r':
+          return {Node::Bytes(AsciiRange('\r', '\r')), false};
+        default:
+          if (c >= '0' && c <= '9') {
+            Error("back references are not supported");
+          }
+          --position_;
+          return {ParseLiteral(), false};
+      }
+
+      if (c >= 'A' && c <= 'Z') {
+        if (in_class) {
+          Error("negated escapes are not supported in classes");
+        }
+        return {AnyCodePoint(~bytes & AsciiRange(0, 0x7f)), true};
+      }
+
+      return {Node::Bytes(bytes), true};
+    }
+
+    /**
+     * Parse a single (possibly multi byte) character.
+     */
+    Node ParseLiteral() {
+      const size_t length = std::min(Utf8Utils::GetCharLength(pattern_[position_]), pattern_.size() - position_);
+      std::vector<Node> sequence;
+
+      for (size_t i = 0; i < length; ++i) {
+        const unsigned char byte = pattern_[position_++];
+        sequence.push_back(Node::Bytes(std::bitset<256>().set(byte)));
+      }
+
+      return sequence.size() == 1 ? std::move(sequence[0]) : Node::Concat(std::move(sequence));
+    }
+
+    Node ParseClass() {
+      bool negated = false;
+      if (!AtEnd() && pattern_[position_] == '^') {
+        negated = true;
+        ++position_;
+      }
+
+      std::bitset<256> ascii;
+      std::vector<Node> multi_byte;
+      bool first = true;
+
+      while (!AtEnd() && (pattern_[position_] != ']' || first)) {
+        first = false;
+        const unsigned char c = pattern_[position_];
+
+        if (c == '\\') {
+          ++position_;
+          if (AtEnd()) {
+            Error("trailing '\\'");
+          }
+          std::pair<Node, bool> escaped = ParseEscape(true);
+          if (escaped.first.type == Node::Type::BYTES) {
+            ascii |= escaped.first.bytes;
+          } else if (negated) {
+            Error("negated classes are restricted to ASCII");
+          } else {
+            multi_byte.push_back(std::move(escaped.first));
+          }
+          continue;
+        }
+
+        if (c >= 0x80) {
+          if (negated) {
+            Error("negated classes are restricted to ASCII");
+          }
+          multi_byte.push_back(ParseLiteral());
+          if (!AtEnd() && pattern_[position_] == '-' && position_ + 1 < pattern_.size() &&
+              pattern_[position_ + 1] != ']') {
+            Error("ranges are restricted to ASCII");
+          }
+          continue;
+        }
+
+        ++position_;
+        if (position_ + 1 < pattern_.size() && pattern_[position_] == '-' && pattern_[position_ + 1] != ']') {
+          const unsigned char upper = pattern_[position_ + 1];
+          if (upper >= 0x80 || upper == '\\' || upper < c) {
+            Error("invalid range");
+          }
+          position_ += 2;
+          ascii |= AsciiRange(c, upper);
+        } else {
+          ascii.set(c);
+        }
+      }
+
+      if (AtEnd()) {
+        Error("missing ']'");
+      }
+      ++position_;
+
+      if (negated) {
+        return AnyCodePoint(~ascii & AsciiRange(0, 0x7f));
+      }
+
+      if (multi_byte.empty()) {
+        return Node::Bytes(ascii);
+      }
+
+      if (ascii.any()) {
+        multi_byte.push_back(Node::Bytes(ascii));
+      }
+      return Node::Alternate(std::move(multi_byte));
+    }
+
+    static std::bitset<256> AsciiRange(const unsigned char lower, const unsigned char upper) {
+      std::bitset<256> bytes;
+      for (size_t c = lower; c <= upper; ++c) {
+        bytes.set(c);
+      }
+      return bytes;
+    }
+
+    /**
+     * Matches the given ASCII characters or any multi byte code point.
+     */
+    static Node AnyCodePoint(const std::bitset<256>& ascii) {
+      const std::bitset<256> continuation = AsciiRange(0x80, 0xbf);
+      std::vector<Node> alternatives;
+
+      alternatives.push_back(Node::Bytes(ascii));
+      alternatives.push_back(Node::Concat({Node::Bytes(AsciiRange(0xc2, 0xdf)), Node::Bytes(continuation)}));
+      alternatives.push_back(Node::Concat(
+          {Node::Bytes(AsciiRange(0xe0, 0xef)), Node::Bytes(continuation), Node::Bytes(continuation)}));
+      alternatives.push_back(Node::Concat({Node::Bytes(AsciiRange(0xf0, 0xf4)), Node::Bytes(continuation),
+                                           Node::Bytes(continuation), Node::Bytes(continuation)}));
+
+      return Node::Alternate(std::move(alternatives));
+    }
+  };
+
+  std::vector<NfaState> nfa_;
+  int32_t nfa_start_ = 0;
+  std::vector<std::vector<int32_t>> dfa_sets_;
+  std::vector<std::array<int32_t, 256>> dfa_transitions_;
+  std::vector<bool> dfa_accepting_;
+  std::map<std::vector<int32_t>, int32_t> dfa_ids_;
+
+  explicit PatternAutomaton(const std::string& regex) {
+    Node root = Parser(regex).Parse();
+
+    Fragment fragment = Compile(root);
+    Patch(fragment.outs, AddNfaState(NfaType::MATCH));
+    nfa_start_ = fragment.start;
+
+    AddDfaState(Closure({nfa_start_}));
+  }
+
+  static std::string GlobToRegex(const std::string& pattern) {
+    std::string regex;
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+      const char c = pattern[i];
+
+      switch (c) {
+        case '*':
+          regex.append(".*");
+          break;
+        case '?':
+          regex.push_back('.');
+          break;
+        case '[': {
+          // copy the class, translating negation
+          size_t end = i + 1;
+          if (end < pattern.size() && (pattern[end] == '!' || pattern[end] == '^')) {
+            ++end;
+          }
+          if (end < pattern.size() && pattern[end] == ']') {
+            ++end;
+          }
+          while (end < pattern.size() && pattern[end] != ']') {
+            ++end;
+          }
+          if (end == pattern.size()) {
+            throw std::invalid_argument("invalid pattern '" + pattern + "': missing ']'");
+          }
+
+          regex.push_back('[');
+          size_t j = i + 1;
+          if (pattern[j] == '!' || pattern[j] == '^') {
+            regex.push_back('^');
+            ++j;
+          }
+          for (; j < end; ++j) {
+            if (pattern[j] == '\\' || pattern[j] == '[') {
+              regex.push_back('\\');
+            }
+            regex.push_back(pattern[j]);
+          }
+          regex.push_back(']');
+          i = end;
+          break;
+        }
+        case '\\':
+          if (i + 1 == pattern.size()) {
+            throw std::invalid_argument("invalid pattern '" + pattern + "': trailing '\\'");
+          }
+          ++i;
+          if (std::isalnum(static_cast<unsigned char>(pattern[i]))) {
+            regex.push_back(pattern[i]);
+          } else {
+            regex.push_back('\\');
+            regex.push_back(pattern[i]);
+          }
+          break;
+        case '.':
+        case '^':
+        case '$':
+        case '|':
+        case '(':
+        case ')':
+        case ']':
+        case '{':
+        case '}':
+        case '+':
+          regex.push_back('\\');
+          regex.push_back(c);
+          break;
+        default:
+          regex.push_back(c);
+      }
+    }
+
+    TRACE("glob %s translated to regex %s", pattern.c_str(), regex.c_str());
+    return regex;
+  }
+
+  int32_t AddNfaState(const NfaType type, const std::bitset<256>& bytes = std::bitset<256>()) {
+    if (nfa_.size() == PATTERN_MAX_NFA_STATES) {
+      throw std::invalid_argument("pattern too complex, it exceeds " + std::to_string(PATTERN_MAX_NFA_STATES) +
+                                  " automaton states");
+    }
+
+    NfaState state;
+    state.type = type;
+    state.bytes = bytes;
+    nfa_.push_back(state);
+    return static_cast<int32_t>(nfa_.size() - 1);
+  }
+
+  void Patch(const outs_t& outs, const int32_t target) {
+    for (const auto& out : outs) {
+      if (out.second) {
+        nfa_[out.first].out2 = target;
+      } else {
+        nfa_[out.first].out = target;
+      }
+    }
+  }
+
+  Fragment Compile(const Node& node) {
+    switch (node.type) {
+      case Node::Type::BYTES: {
+        const int32_t state = AddNfaState(NfaType::BYTES, node.bytes);
+        return Fragment{state, {{state, false}}};
+      }
+      case Node::Type::CONCAT: {
+        if (node.children.empty()) {
+          const int32_t state = AddNfaState(NfaType::EPSILON);
+          return Fragment{state, {{state, false}}};
+        }
+
+        Fragment fragment = Compile(node.children[0]);
+        for (size_t i = 1; i < node.children.size(); ++i) {
+          Fragment next = Compile(node.children[i]);
+          Patch(fragment.outs, next.start);
+          fragment.outs = std::move(next.outs);
+        }
+        return fragment;
+      }
+      case Node::Type::ALTERNATE: {
+        Fragment fragment = Compile(node.children[0]);
+        for (size_t i = 1; i < node.children.size(); ++i) {
+          Fragment next = Compile(node.children[i]);
+          const int32_t split = AddNfaState(NfaType::EPSILON);
+          nfa_[split].out = fragment.start;
+          nfa_[split].out2 = next.start;
+          fragment.start = split;
+          fragment.outs.insert(fragment.outs.end(), next.outs.begin(), next.outs.end());
+        }
+        return fragment;
+      }
+      case Node::Type::REPEAT:
+      default:
+        return CompileRepetition(node);
+    }
+  }
+
+  Fragment CompileRepetition(const Node& node) {
+    const Node& child = node.children[0];
+
+    // start with an empty fragment
+    const int32_t start = AddNfaState(NfaType::EPSILON);
+    Fragment fragment{start, {{start, false}}};
+
+    // mandatory repetitions
+    for (size_t i = 0; i < node.min; ++i) {
+      Fragment next = Compile(child);
+      Patch(fragment.outs, next.start);
+      fragment.outs = std::move(next.outs);
+    }
+
+    if (node.max == std::numeric_limits<size_t>::max()) {
+      // loop: split -> child -> split
+      const int32_t split = AddNfaState(NfaType::EPSILON);
+      Fragment loop = Compile(child);
+      nfa_[split].out = loop.start;
+      Patch(loop.outs, split);
+      Patch(fragment.outs, split);
+      fragment.outs = {{split, true}};
+      return fragment;
+    }
+
+    // optional repetitions
+    for (size_t i = node.min; i < node.max; ++i) {
+      const int32_t split = AddNfaState(NfaType::EPSILON);
+      Fragment optional = Compile(child);
+      nfa_[split].out = optional.start;
+      Patch(fragment.outs, split);
+      fragment.outs = std::move(optional.outs);
+      fragment.outs.emplace_back(split, true);
+    }
+
+    return fragment;
+  }
+
+  /**
+   * Epsilon closure, only states consuming input or matching are part of the result.
+   */
+  std::vector<int32_t> Closure(const std::vector<int32_t>& seeds) const {
+    std::vector<int32_t> result;
+    std::vector<int32_t> stack(seeds);
+    std::vector<bool> visited(nfa_.size(), false);
+
+    while (!stack.empty()) {
+      const int32_t state = stack.back();
+      stack.pop_back();
+
+      if (state < 0 || visited[state]) {
+        continue;
+      }
+      visited[state] = true;
+
+      if (nfa_[state].type == NfaType::EPSILON) {
+        stack.push_back(nfa_[state].out2);
+        stack.push_back(nfa_[state].out);
+      } else {
+        result.push_back(state);
+      }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  int32_t AddDfaState(std::vector<int32_t>&& nfa_states) {
+    auto it = dfa_ids_.find(nfa_states);
+    if (it != dfa_ids_.end()) {
+      return it->second;
+    }
+
+    const int32_t id = static_cast<int32_t>(dfa_sets_.size());
+    bool accepting = false;
+    for (const int32_t nfa_state : nfa_states) {
+      accepting = accepting || nfa_[nfa_state].type == NfaType::MATCH;
+    }
+
+    std::array<int32_t, 256> transitions;
+    transitions.fill(UNKNOWN_STATE);
+
+    dfa_ids_.emplace(nfa_states, id);
+    dfa_sets_.push_back(std::move(nfa_states));
+    dfa_transitions_.push_back(transitions);
+    dfa_accepting_.push_back(accepting);
+
+    TRACE("new dfa state %d accepting %d", id, accepting);
+    return id;
+  }
+};
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_UTIL_PATTERN_AUTOMATON_H_
@@ -0,0 +1,86 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * qgrams.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_UTIL_QGRAMS_H_
+#define KEYVI_DICTIONARY_UTIL_QGRAMS_H_
+
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "utf8.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+// code point used to pad the string at the beginning and the end
+static const uint32_t QGRAM_PADDING = 0x01;
+
+class QGrams final {
+ public:
+  /**
+   * Get the q-grams of a string of code points, padded with q - 1 padding characters on both sides.
+   *
+   * A string of length n has n + q - 1 padded q-grams. Every q-gram is returned as utf-8, duplicates are kept.
+   *
+   * @param codepoints the string as code points
+   * @param q the length of a q-gram in code points
+   * @param qgrams output
+   */
+  static void GetQGrams(const std::vector<uint32_t>& codepoints, const size_t q, std::vector<std::string>* qgrams) {
+    std::vector<uint32_t> padded(q - 1, QGRAM_PADDING);
+    padded.insert(padded.end(), codepoints.begin(), codepoints.end());
+    padded.insert(padded.end(), q - 1, QGRAM_PADDING);
+
+    qgrams->clear();
+    for (size_t i = 0; i + q <= padded.size(); ++i) {
+      std::string qgram;
+      utf8::unchecked::utf32to8(padded.begin() + i, padded.begin() + i + q, std::back_inserter(qgram));
+      qgrams->push_back(std::move(qgram));
+    }
+  }
+
+  /**
+   * Lower bound of the number of padded q-grams 2 strings share if their (Damerau-)Levenshtein distance is at most
+   * max_edit_distance, given the length of one of them.
+   *
+   * An insertion, deletion or substitution destroys at most q q-grams, a transposition q + 1.
+   *
+   * @param length the length of one string in code points
+   * @param q the length of a q-gram
+   * @param max_edit_distance the maximum edit distance
+   * @return the minimum number of shared q-grams, <= 0 if the count filter can not be applied
+   */
+  static int64_t GetCountFilterThreshold(const size_t length, const size_t q, const int32_t max_edit_distance) {
+    return static_cast<int64_t>(length + q - 1) - static_cast<int64_t>(max_edit_distance) * (q + 1);
+  }
+};
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_UTIL_QGRAMS_H_
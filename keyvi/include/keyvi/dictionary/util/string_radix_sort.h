@@ -0,0 +1,276 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * string_radix_sort.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_UTIL_STRING_RADIX_SORT_H_
+#define KEYVI_DICTIONARY_UTIL_STRING_RADIX_SORT_H_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+// ranges smaller than this are sorted with insertion sort
+static const size_t STRING_RADIX_SORT_INSERTION_SORT_THRESHOLD = 32;
+
+// before sorting in parallel, ranges are split until there are at least this many work items per thread
+static const size_t STRING_RADIX_SORT_WORK_ITEMS_PER_THREAD = 8;
+
+/**
+ * MSD radix sort for byte strings, producing the LCP array as a by-product.
+ *
+ * Ranges are distributed into 256 buckets per byte (plus one for keys ending at this depth), so every byte of a shared
+ * prefix is only looked at once per key instead of once per comparison. The sort is stable: equal keys keep their
+ * insertion order.
+ *
+ * For every bucket boundary the longest common prefix with the previous key is the current depth, so the LCP array
+ * comes for free and can be passed to the generator.
+ *
+ * Items are moved during distribution, they should be small, e.g. a pointer to the key and a value.
+ */
+class StringRadixSort final {
+ public:
+  /**
+   * Sort the given items by key.
+   *
+   * @param items the items to sort
+   * @param get_key function returning the key of an item, a type providing data() and size(), e.g. std::string
+   * @param lcp output: lcp[i] is the length of the longest common prefix of key i and key i - 1, lcp[0] is 0
+   * @param threads the number of threads to use
+   */
+  template <typename ItemT, typename KeyGetterT>
+  static void Sort(std::vector<ItemT>* items, KeyGetterT get_key, std::vector<size_t>* lcp, const size_t threads = 1) {
+    const size_t size = items->size();
+    std::vector<ItemT> buffer(size);
+    lcp->assign(size, 0);
+
+    Sorter<ItemT, KeyGetterT> sorter{items->data(), buffer.data(), lcp->data(), get_key};
+
+    if (threads <= 1 || size < threads * STRING_RADIX_SORT_INSERTION_SORT_THRESHOLD) {
+      std::vector<Range> stack = {Range{0, size, 0}};
+      sorter.SortRanges(&stack);
+    } else {
+      sorter.SortParallel(size, threads);
+    }
+  }
+
+ private:
+  // a range of items which share a common prefix of length depth
+  struct Range {
+    size_t begin;
+    size_t end;
+    size_t depth;
+  };
+
+  template <typename ItemT, typename KeyGetterT>
+  struct Sorter {
+    ItemT* items;
+    ItemT* buffer;
+    size_t* lcp;
+    KeyGetterT get_key;
+
+    inline size_t Bucket(const ItemT& item, const size_t depth) const {
+      const auto& key = get_key(item);
+      return depth < key.size() ? static_cast<unsigned char>(key.data()[depth]) + 1 : 0;
+    }
+
+    void SortParallel(const size_t size, const size_t threads) {
+      // split the largest ranges until there is enough work to distribute
+      const size_t max_range_size = std::max(size / (threads * STRING_RADIX_SORT_WORK_ITEMS_PER_THREAD),
+                                             STRING_RADIX_SORT_INSERTION_SORT_THRESHOLD);
+      std::vector<Range> to_split = {Range{0, size, 0}};
+      std::vector<Range> work_items;
+      std::array<size_t, 257> counts;
+
+      while (!to_split.empty()) {
+        const Range range = to_split.back();
+        to_split.pop_back();
+
+        if (range.end - range.begin <= max_range_size) {
+          work_items.push_back(range);
+          continue;
+        }
+
+        Distribute(range, &counts, &to_split);
+      }
+
+      // largest work items first for better load balancing
+      std::sort(work_items.begin(), work_items.end(),
+                [](const Range& a, const Range& b) { return a.end - a.begin > b.end - b.begin; });
+
+      TRACE("sort %lu work items using %lu threads", work_items.size(), threads);
+
+      std::atomic<size_t> next_work_item{0};
+      std::vector<std::thread> workers;
+
+      for (size_t i = 0; i < threads; ++i) {
+        workers.emplace_back([this, &work_items, &next_work_item]() {
+          std::vector<Range> stack;
+          for (size_t item = next_work_item++; item < work_items.size(); item = next_work_item++) {
+            stack.push_back(work_items[item]);
+            SortRanges(&stack);
+          }
+        });
+      }
+
+      for (std::thread& worker : workers) {
+        worker.join();
+      }
+    }
+
+    void SortRanges(std::vector<Range>* stack) {
+      std::array<size_t, 257> counts;
+
+      // iterative to not depend on the stack size, keys can share very long prefixes
+      while (!stack->empty()) {
+        const Range range = stack->back();
+        stack->pop_back();
+
+        if (range.end - range.begin < STRING_RADIX_SORT_INSERTION_SORT_THRESHOLD) {
+          InsertionSort(range);
+        } else {
+          Distribute(range, &counts, stack);
+        }
+      }
+    }
+
+    /**
+     * Distribute the range into buckets by the byte at the depth of the range, buckets which still need sorting are
+     * pushed to the stack.
+     */
+    void Distribute(const Range& range, std::array<size_t, 257>* counts, std::vector<Range>* stack) {
+      counts->fill(0);
+      for (size_t i = range.begin; i < range.end; ++i) {
+        ++(*counts)[Bucket(items[i], range.depth)];
+      }
+
+      const size_t size = range.end - range.begin;
+
+      // shared prefix, nothing to distribute
+      const size_t first_bucket = Bucket(items[range.begin], range.depth);
+      if ((*counts)[first_bucket] == size) {
+        if (first_bucket == 0) {
+          // equal keys
+          std::fill(lcp + range.begin + 1, lcp + range.end, range.depth);
+        } else {
+          stack->push_back(Range{range.begin, range.end, range.depth + 1});
+        }
+        return;
+      }
+
+      // turn counts into offsets
+      size_t offset = range.begin;
+      for (size_t& count : *counts) {
+        const size_t bucket_size = count;
+        count = offset;
+        offset += bucket_size;
+      }
+
+      for (size_t i = range.begin; i < range.end; ++i) {
+        const size_t bucket = Bucket(items[i], range.depth);
+        buffer[(*counts)[bucket]++] = std::move(items[i]);
+      }
+      std::move(buffer + range.begin, buffer + range.end, items + range.begin);
+
+      // counts now point to the end of the buckets
+      size_t bucket_begin = range.begin;
+      for (size_t bucket = 0; bucket < counts->size(); ++bucket) {
+        const size_t bucket_end = (*counts)[bucket];
+        if (bucket_begin == bucket_end) {
+          continue;
+        }
+
+        if (bucket_begin != range.begin) {
+          lcp[bucket_begin] = range.depth;
+        }
+
+        if (bucket == 0) {
+          std::fill(lcp + bucket_begin + 1, lcp + bucket_end, range.depth);
+        } else if (bucket_end - bucket_begin > 1) {
+          stack->push_back(Range{bucket_begin, bucket_end, range.depth + 1});
+        }
+
+        bucket_begin = bucket_end;
+      }
+    }
+
+    void InsertionSort(const Range& range) {
+      for (size_t i = range.begin + 1; i < range.end; ++i) {
+        ItemT item = std::move(items[i]);
+        size_t j = i;
+
+        // strictly greater keeps the sort stable
+        while (j > range.begin && Compare(items[j - 1], item, range.depth) > 0) {
+          items[j] = std::move(items[j - 1]);
+          --j;
+        }
+        items[j] = std::move(item);
+      }
+
+      for (size_t i = range.begin + 1; i < range.end; ++i) {
+        lcp[i] = GetCommonPrefixLength(items[i - 1], items[i], range.depth);
+      }
+    }
+
+    inline size_t GetCommonPrefixLength(const ItemT& a, const ItemT& b, size_t depth) const {
+      const auto& key_a = get_key(a);
+      const auto& key_b = get_key(b);
+      const size_t length = std::min(key_a.size(), key_b.size());
+
+      while (depth < length && key_a.data()[depth] == key_b.data()[depth]) {
+        ++depth;
+      }
+      return depth;
+    }
+
+    inline int Compare(const ItemT& a, const ItemT& b, const size_t depth) const {
+      const auto& key_a = get_key(a);
+      const auto& key_b = get_key(b);
+      const size_t common_prefix_length = GetCommonPrefixLength(a, b, depth);
+
+      if (common_prefix_length < key_a.size() && common_prefix_length < key_b.size()) {
+        return static_cast<int>(static_cast<unsigned char>(key_a.data()[common_prefix_length])) -
+               static_cast<int>(static_cast<unsigned char>(key_b.data()[common_prefix_length]));
+      }
+
+      return key_a.size() == key_b.size() ? 0 : (key_a.size() < key_b.size() ? -1 : 1);
+    }
+  };
+};
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_UTIL_STRING_RADIX_SORT_H_
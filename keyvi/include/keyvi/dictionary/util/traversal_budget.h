@@ -0,0 +1,126 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * traversal_budget.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_DICTIONARY_UTIL_TRAVERSAL_BUDGET_H_
+#define KEYVI_DICTIONARY_UTIL_TRAVERSAL_BUDGET_H_
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+// the clock is only read every n visited states, must be a power of 2
+static const uint64_t TRAVERSAL_BUDGET_DEADLINE_CHECK_INTERVAL = 256;
+
+/**
+ * A work budget for a single query, limiting the number of visited states and/or the time spent.
+ *
+ * Matchers charge every state they visit, once the budget is exhausted they stop and return no further matches. The
+ * matches returned so far are valid, IsTruncated tells whether the result is incomplete.
+ *
+ * A budget is not thread-safe and should not be shared across queries.
+ */
+class TraversalBudget final {
+ public:
+  TraversalBudget() {}
+
+  /**
+   * @param max_states the maximum number of states to visit
+   */
+  explicit TraversalBudget(const uint64_t max_states) : max_states_(max_states) {}
+
+  /**
+   * @param max_states the maximum number of states to visit
+   * @param timeout the maximum time to spend, starting now
+   */
+  TraversalBudget(const uint64_t max_states, const std::chrono::steady_clock::duration timeout)
+      : max_states_(max_states), deadline_(std::chrono::steady_clock::now() + timeout), has_deadline_(true) {}
+
+  void SetMaxStates(const uint64_t max_states) { max_states_ = max_states; }
+
+  void SetDeadline(const std::chrono::steady_clock::time_point deadline) {
+    deadline_ = deadline;
+    has_deadline_ = true;
+  }
+
+  void SetTimeout(const std::chrono::steady_clock::duration timeout) {
+    SetDeadline(std::chrono::steady_clock::now() + timeout);
+  }
+
+  /**
+   * Charge the visit of a state.
+   *
+   * @return false if the budget is exhausted and traversal should stop
+   */
+  inline bool VisitState() {
+    if (truncated_) {
+      return false;
+    }
+
+    if (++visited_states_ > max_states_) {
+      TRACE("budget exhausted after %lu states", max_states_);
+      truncated_ = true;
+      return false;
+    }
+
+    if (has_deadline_ && (visited_states_ & (TRAVERSAL_BUDGET_DEADLINE_CHECK_INTERVAL - 1)) == 1 &&
+        std::chrono::steady_clock::now() >= deadline_) {
+      TRACE("deadline reached after %lu states", visited_states_);
+      truncated_ = true;
+      return false;
+    }
+
+    return true;
+  }
+
+  /**
+   * Whether traversal stopped because the budget got exhausted, in this case the result is incomplete.
+   */
+  bool IsTruncated() const { return truncated_; }
+
+  uint64_t GetVisitedStates() const { return visited_states_; }
+
+ private:
+  uint64_t max_states_ = std::numeric_limits<uint64_t>::max();
+  std::chrono::steady_clock::time_point deadline_;
+  bool has_deadline_ = false;
+  uint64_t visited_states_ = 0;
+  bool truncated_ = false;
+};
+
+// shared pointer, the caller keeps it to check for truncation after iterating
+typedef std::shared_ptr<TraversalBudget> traversal_budget_t;
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
+
+#endif  // KEYVI_DICTIONARY_UTIL_TRAVERSAL_BUDGET_H_
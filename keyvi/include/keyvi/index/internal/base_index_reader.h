@@ -38,6 +38,9 @@
 #include "keyvi/dictionary/match_iterator.h"
 #include "keyvi/dictionary/matching/fuzzy_matching.h"
 #include "keyvi/dictionary/matching/near_matching.h"
+#include "keyvi/dictionary/matching/regex_matching.h"
+#include "keyvi/dictionary/util/pattern_automaton.h"
+#include "keyvi/dictionary/util/traversal_budget.h"
 #include "keyvi/index/internal/index_lookup_util.h"
 #include "keyvi/index/internal/read_only_segment.h"
 
@@ -106,10 +109,12 @@ class BaseIndexReader {
    * @param query a query to match against
    * @param minimum_exact_prefix prefix length to be matched exact
    * @param greedy if true matches everything below minimum prefix
+   * @param budget optional budget to limit the traversal
    *
    */
-  dictionary::MatchIterator::MatchIteratorPair GetNear(const std::string& query, const size_t minimum_exact_prefix = 2,
-                                                       const bool greedy = false) {
+  dictionary::MatchIterator::MatchIteratorPair GetNear(
+      const std::string& query, const size_t minimum_exact_prefix = 2, const bool greedy = false,
+      const dictionary::util::traversal_budget_t& budget = dictionary::util::traversal_budget_t()) {
     TRACE("matching near: %s minimum prefix %ld", query.c_str(), minimum_exact_prefix);
     const_segments_t segments = payload_.Segments();
 
@@ -134,6 +139,7 @@ class BaseIndexReader {
           std::make_shared<dictionary::matching::NearMatching<>>(dictionary::matching::NearMatching<>::FromSingleFsa(
               std::get<0>(fsa_start_state_payloads[0]), std::get<1>(fsa_start_state_payloads[0]), query,
               minimum_exact_prefix, greedy));
+      near_matcher->SetBudget(budget);
 
       for (auto it = segments->crbegin(); it != segments->crend(); it++) {
         if ((*it)->GetDictionary()->GetFsa() == std::get<0>(fsa_start_state_payloads[0])) {
@@ -158,6 +164,7 @@ class BaseIndexReader {
         dictionary::matching::NearMatching<dictionary::fsa::ZipStateTraverser<dictionary::fsa::NearStateTraverser>>>(
         dictionary::matching::NearMatching<dictionary::fsa::ZipStateTraverser<dictionary::fsa::NearStateTraverser>>::
             FromMulipleFsas(std::move(fsa_start_state_payloads), query, minimum_exact_prefix, greedy));
+    near_matcher->SetBudget(budget);
 
     if (deleted_keys_map.size() == 0) {
       auto func = [near_matcher]() { return near_matcher->NextMatch(); };
@@ -175,9 +182,11 @@ class BaseIndexReader {
    * @param query a query to match against
    * @param max_edit_distance the max edit distance allowed for a single match
    * @param minimum_exact_prefix prefix length to be matched exact
+   * @param budget optional budget to limit the traversal
    */
-  dictionary::MatchIterator::MatchIteratorPair GetFuzzy(const std::string& query, const int32_t max_edit_distance,
-                                                        const size_t minimum_exact_prefix = 2) {
+  dictionary::MatchIterator::MatchIteratorPair GetFuzzy(
+      const std::string& query, const int32_t max_edit_distance, const size_t minimum_exact_prefix = 2,
+      const dictionary::util::traversal_budget_t& budget = dictionary::util::traversal_budget_t()) {
     TRACE("matching fuzzy: %s max edit distance %ld minimum prefix %ld", query.c_str(), max_edit_distance,
           minimum_exact_prefix);
     const_segments_t segments = payload_.Segments();
@@ -203,6 +212,7 @@ class BaseIndexReader {
           dictionary::matching::FuzzyMatching<>::FromSingleFsa<>(fsa_start_state_pairs[0].first,
                                                                  fsa_start_state_pairs[0].second, query,
                                                                  max_edit_distance, minimum_exact_prefix));
+      fuzzy_matcher->SetBudget(budget);
 
       for (auto it = segments->crbegin(); it != segments->crend(); it++) {
         if ((*it)->GetDictionary()->GetFsa() == fsa_start_state_pairs[0].first) {
@@ -235,6 +245,7 @@ class BaseIndexReader {
         dictionary::matching::FuzzyMatching<dictionary::fsa::ZipStateTraverser<dictionary::fsa::StateTraverser<>>>::
             FromMulipleFsas<dictionary::fsa::StateTraverser<>>(fsa_start_state_pairs, query, max_edit_distance,
                                                                minimum_exact_prefix));
+    fuzzy_matcher->SetBudget(budget);
 
     if (deleted_keys_map.size() == 0) {
       auto func = [fuzzy_matcher]() { return fuzzy_matcher->NextMatch(); };
@@ -246,12 +257,77 @@ class BaseIndexReader {
     return dictionary::MatchIterator::MakeIteratorPair(func, FirstFilteredMatch(fuzzy_matcher, deleted_keys_map));
   }
 
+  /**
+   * Match all keys against a regular expression
+   *
+   * @param pattern the regular expression, it must match the complete key
+   * @param budget optional budget to limit the traversal
+   */
+  dictionary::MatchIterator::MatchIteratorPair GetRegex(
+      const std::string& pattern,
+      const dictionary::util::traversal_budget_t& budget = dictionary::util::traversal_budget_t()) {
+    TRACE("matching regex: %s", pattern.c_str());
+    return GetPatternMatches(dictionary::util::PatternAutomaton::FromRegex(pattern), budget);
+  }
+
+  /**
+   * Match all keys against a glob pattern
+   *
+   * @param pattern the glob pattern, supporting '*', '?' and classes
+   * @param budget optional budget to limit the traversal
+   */
+  dictionary::MatchIterator::MatchIteratorPair GetGlob(
+      const std::string& pattern,
+      const dictionary::util::traversal_budget_t& budget = dictionary::util::traversal_budget_t()) {
+    TRACE("matching glob: %s", pattern.c_str());
+    return GetPatternMatches(dictionary::util::PatternAutomaton::FromGlob(pattern), budget);
+  }
+
  protected:
   PayloadT& Payload() { return payload_; }
 
  private:
   PayloadT payload_;
 
+  dictionary::MatchIterator::MatchIteratorPair GetPatternMatches(dictionary::util::PatternAutomaton&& pattern,
+                                                                 const dictionary::util::traversal_budget_t& budget) {
+    const_segments_t segments = payload_.Segments();
+
+    if (segments->size() == 0) {
+      return dictionary::MatchIterator::EmptyIteratorPair();
+    }
+
+    std::vector<dictionary::fsa::automata_t> fsas;
+    for (auto it = segments->cbegin(); it != segments->cend(); it++) {
+      fsas.push_back((*it)->GetDictionary()->GetFsa());
+    }
+
+    const std::string prefix = pattern.GetLiteralPrefix();
+    std::vector<std::pair<dictionary::fsa::automata_t, uint64_t>> fsa_start_state_pairs =
+        dictionary::matching::RegexMatching<>::FilterWithExactPrefix(fsas, prefix);
+
+    if (fsa_start_state_pairs.size() == 0) {
+      return dictionary::MatchIterator::EmptyIteratorPair();
+    }
+
+    // segments and filtered fsa's must have the same order
+    auto deleted_keys_map = CreatedDeletedKeysMap(segments, fsa_start_state_pairs);
+
+    auto regex_matcher = std::make_shared<
+        dictionary::matching::RegexMatching<dictionary::fsa::ZipStateTraverser<dictionary::fsa::StateTraverser<>>>>(
+        dictionary::matching::RegexMatching<>::FromMulipleFsas(fsa_start_state_pairs, std::move(pattern), prefix));
+    regex_matcher->SetBudget(budget);
+
+    if (deleted_keys_map.size() == 0) {
+      auto func = [regex_matcher]() { return regex_matcher->NextMatch(); };
+      return dictionary::MatchIterator::MakeIteratorPair(func, regex_matcher->FirstMatch());
+    }
+
+    auto func = [regex_matcher, deleted_keys_map]() { return NextFilteredMatch(regex_matcher, deleted_keys_map); };
+    // check if first match is a deleted key and reset in case
+    return dictionary::MatchIterator::MakeIteratorPair(func, FirstFilteredMatch(regex_matcher, deleted_keys_map));
+  }
+
   // friend for unit testing only
   friend class keyvi::index::unit_test::IndexFriend;
 };
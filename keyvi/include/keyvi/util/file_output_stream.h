@@ -0,0 +1,144 @@
+/* * keyvi - A key value store.
+ *
+ * Copyright 2026 The keyvi authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * file_output_stream.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#ifndef KEYVI_UTIL_FILE_OUTPUT_STREAM_H_
+#define KEYVI_UTIL_FILE_OUTPUT_STREAM_H_
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstddef>
+#include <fstream>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <system_error>  // NOLINT
+
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+
+// #define ENABLE_TRACING
+#include "keyvi/dictionary/util/trace.h"
+
+namespace keyvi {
+namespace util {
+
+/**
+ * Output file stream that knows its file, so that files can be appended without copying them through user space.
+ *
+ * On Linux copy_file_range copies inside the kernel, filesystems with reflink support might share the extents instead
+ * of copying them.
+ */
+class FileOutputStream final : public std::ofstream {
+ public:
+  explicit FileOutputStream(const std::string& filename)
+      : std::ofstream(filename, std::ios::binary), filename_(filename) {
+    if (!good()) {
+      throw std::invalid_argument((boost::format("Failed to open stream for %1%") % filename).str());
+    }
+  }
+
+  const std::string& GetFilename() const { return filename_; }
+
+  /**
+   * Append a file at the current position using an in-kernel copy.
+   *
+   * @param source the file to append
+   * @param length the number of bytes to append, the file must have at least this size
+   * @return true if appended, false if not supported, in which case nothing has been written
+   */
+  bool AppendFile(const boost::filesystem::path& source, const size_t length) {
+#if defined(__linux__) && defined(SYS_copy_file_range)
+    if (length == 0) {
+      return true;
+    }
+
+    flush();
+    const std::streampos position = tellp();
+    if (!good() || position < 0) {
+      return false;
+    }
+
+    int source_fd = ::open(source.native().c_str(), O_RDONLY);
+    if (source_fd == -1) {
+      return false;
+    }
+
+    int target_fd = ::open(filename_.c_str(), O_WRONLY);
+    if (target_fd == -1) {
+      ::close(source_fd);
+      return false;
+    }
+
+    loff_t source_offset = 0;
+    loff_t target_offset = static_cast<loff_t>(position);
+    size_t remaining = length;
+    int error = 0;
+
+    while (remaining > 0) {
+      ssize_t copied =
+          ::syscall(SYS_copy_file_range, source_fd, &source_offset, target_fd, &target_offset, remaining, 0u);
+
+      if (copied <= 0) {
+        error = copied == 0 ? EIO : errno;
+        break;
+      }
+
+      remaining -= copied;
+    }
+
+    ::close(source_fd);
+    ::close(target_fd);
+
+    TRACE("appended %ld bytes of %s, remaining %ld", length - remaining, source.native().c_str(), remaining);
+
+    if (remaining == length) {
+      // nothing has been copied, e.g. kernel or filesystem without support
+      return false;
+    }
+
+    if (remaining > 0) {
+      const std::string reason = std::generic_category().message(error);
+      throw std::ios_base::failure((boost::format("Failed to append %1%: %2%") % source.native() % reason).str());
+    }
+
+    seekp(position + static_cast<std::streamoff>(length));
+    return good();
+#else
+    return false;
+#endif
+  }
+
+ private:
+  std::string filename_;
+};
+
+} /* namespace util */
+} /* namespace keyvi */
+
+#endif  // KEYVI_UTIL_FILE_OUTPUT_STREAM_H_
@@ -31,6 +31,7 @@
 #include "keyvi/util/msgpack_util.h"
 #include "msgpack.hpp"
 #include "rapidjson/document.h"
+#include "rapidjson/reader.h"
 #include "rapidjson/stringbuffer.h"
 #include "rapidjson/writer.h"
 
@@ -64,15 +65,16 @@ inline void EncodeJsonValue(std::function<void(compression::buffer_t*, const cha
                             size_t compression_threshold = 32) {
   msgpack_buffer->clear();
 
-  rapidjson::Document json_document;
-  json_document.Parse<rapidjson::kParseNanAndInfFlag>(raw_value.c_str());
+  // transcode while parsing, if the value turns out to be no json, the partial output is thrown away
+  rapidjson::Reader reader;
+  rapidjson::StringStream json_stream(raw_value.c_str());
+  JsonToMsgPackHandler handler(msgpack_buffer, single_precision_float);
 
-  if (!json_document.HasParseError()) {
+  if (!reader.Parse<rapidjson::kParseNanAndInfFlag>(json_stream, handler).IsError()) {
     TRACE("Got json");
-    msgpack::packer<msgpack::sbuffer> packer(msgpack_buffer);
-    JsonToMsgPack(json_document, &packer, single_precision_float);
   } else {
     TRACE("Got a normal string");
+    msgpack_buffer->clear();
     msgpack::pack(msgpack_buffer, raw_value);
   }
   // compression
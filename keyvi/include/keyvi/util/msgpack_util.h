@@ -24,10 +24,13 @@
 
 #ifndef KEYVI_UTIL_MSGPACK_UTIL_H_
 #define KEYVI_UTIL_MSGPACK_UTIL_H_
+#include <cstring>
 #include <limits>
+#include <vector>
 
 #include "msgpack.hpp"
 #include "rapidjson/document.h"
+#include "rapidjson/reader.h"
 #include "rapidjson/writer.h"
 
 /**
@@ -88,6 +91,138 @@ inline void JsonToMsgPack(const rapidjson::Value& value, msgpack::packer<msgpack
   }
 }
 
+/**
+ * rapidjson reader handler that transcodes json to msgpack while parsing, without building a document first.
+ *
+ * The output is the same as JsonToMsgPack on the parsed document. The number of elements of an array or object is only
+ * known at its end, so a 1 byte header is reserved at the start and the content gets moved if the final header is
+ * longer (more than 15 elements).
+ */
+class JsonToMsgPackHandler final {
+ public:
+  JsonToMsgPackHandler(msgpack::sbuffer* msgpack_buffer, bool single_precision_float)
+      : msgpack_buffer_(msgpack_buffer), msgpack_packer_(*msgpack_buffer),
+        single_precision_float_(single_precision_float) {}
+
+  bool Null() {
+    msgpack_packer_.pack_nil();
+    return true;
+  }
+
+  bool Bool(bool b) {
+    if (b) {
+      msgpack_packer_.pack_true();
+    } else {
+      msgpack_packer_.pack_false();
+    }
+    return true;
+  }
+
+  // non-negative integers are packed as unsigned, like in JsonToMsgPack
+  bool Int(int i) { return Int64(i); }
+
+  bool Uint(unsigned u) { return Uint64(u); }
+
+  bool Int64(int64_t i) {
+    if (i >= 0) {
+      msgpack_packer_.pack_uint64(static_cast<uint64_t>(i));
+    } else {
+      msgpack_packer_.pack_int64(i);
+    }
+    return true;
+  }
+
+  bool Uint64(uint64_t u) {
+    msgpack_packer_.pack_uint64(u);
+    return true;
+  }
+
+  bool Double(double d) {
+    if (single_precision_float_ == false || d < std::numeric_limits<float>::min() ||
+        d > std::numeric_limits<float>::max()) {
+      msgpack_packer_.pack_double(d);
+    } else {
+      msgpack_packer_.pack_float(static_cast<float>(d));
+    }
+    return true;
+  }
+
+  // only called with kParseNumbersAsStringsFlag
+  bool RawNumber(const char* str, rapidjson::SizeType length, bool copy) { return String(str, length, copy); }
+
+  bool String(const char* str, rapidjson::SizeType length, bool copy) {
+    msgpack_packer_.pack_str(length);
+    msgpack_packer_.pack_str_body(str, length);
+    return true;
+  }
+
+  bool StartObject() {
+    ReserveHeader();
+    return true;
+  }
+
+  bool Key(const char* str, rapidjson::SizeType length, bool copy) { return String(str, length, copy); }
+
+  bool EndObject(rapidjson::SizeType member_count) {
+    HeaderBuffer header;
+    msgpack::packer<HeaderBuffer> header_packer(header);
+    header_packer.pack_map(member_count);
+    WriteHeader(header);
+    return true;
+  }
+
+  bool StartArray() {
+    ReserveHeader();
+    return true;
+  }
+
+  bool EndArray(rapidjson::SizeType element_count) {
+    HeaderBuffer header;
+    msgpack::packer<HeaderBuffer> header_packer(header);
+    header_packer.pack_array(element_count);
+    WriteHeader(header);
+    return true;
+  }
+
+ private:
+  // array and map headers take 1, 3 or 5 bytes
+  struct HeaderBuffer {
+    char data[5];
+    size_t size = 0;
+
+    void write(const char* buf, size_t len) {
+      std::memcpy(data + size, buf, len);
+      size += len;
+    }
+  };
+
+  msgpack::sbuffer* msgpack_buffer_;
+  msgpack::packer<msgpack::sbuffer> msgpack_packer_;
+  bool single_precision_float_;
+  std::vector<size_t> header_offsets_;
+
+  void ReserveHeader() {
+    header_offsets_.push_back(msgpack_buffer_->size());
+    const char placeholder = 0;
+    msgpack_buffer_->write(&placeholder, 1);
+  }
+
+  void WriteHeader(const HeaderBuffer& header) {
+    const size_t offset = header_offsets_.back();
+    header_offsets_.pop_back();
+
+    if (header.size > 1) {
+      const size_t content_size = msgpack_buffer_->size() - offset - 1;
+      // grow the buffer, the bytes get overwritten
+      msgpack_buffer_->write(header.data + 1, header.size - 1);
+      std::memmove(msgpack_buffer_->data() + offset + header.size, msgpack_buffer_->data() + offset + 1,
+                   content_size);
+    }
+
+    std::memcpy(msgpack_buffer_->data() + offset, header.data, header.size);
+  }
+};
+
 template <typename Writer>
 inline void MsgPackDump(Writer* writer, const msgpack::object& o) {
   switch (o.type) {
@@ -28,6 +28,7 @@
 #include <cstddef>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <string>
 
 #include <boost/lexical_cast.hpp>
@@ -46,10 +47,21 @@ class SerializationUtils {
   static void ReadLengthPrefixedJsonRecord(std::istream& stream, rapidjson::Document* record) {
     uint32_t header_size;
     stream.read(reinterpret_cast<char*>(&header_size), sizeof(int));
+    if (!stream.good()) {
+      throw std::invalid_argument("file is corrupt(truncated)");
+    }
+
     header_size = be32toh(header_size);
     auto buffer_ptr = std::unique_ptr<char[]>(new char[header_size]);
     stream.read(buffer_ptr.get(), header_size);
+    if (static_cast<size_t>(stream.gcount()) != header_size) {
+      throw std::invalid_argument("file is corrupt(truncated)");
+    }
+
     record->Parse(buffer_ptr.get(), header_size);
+    if (record->HasParseError() || !record->IsObject()) {
+      throw std::invalid_argument("file is corrupt(invalid header)");
+    }
   }
 
   // utility methods to retrieve numeric values
@@ -0,0 +1,102 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * completion_session_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/completion/completion_session.h"
+#include "keyvi/dictionary/completion/prefix_completion.h"
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace completion {
+
+BOOST_AUTO_TEST_SUITE(CompletionSessionTests)
+
+std::vector<std::string> ToStrings(MatchIterator::MatchIteratorPair matches) {
+  std::vector<std::string> result;
+  for (auto m : matches) {
+    result.push_back(m.GetMatchedString());
+  }
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(TypeAhead) {
+  std::vector<std::pair<std::string, uint32_t>> test_data = {
+      {"angel", 22},       {"angeli", 24},      {"angelina", 444}, {"angela merkel", 200},
+      {"angela merk", 180}, {"angelo merk", 10}, {"aabc", 22},      {"aabcül", 55},
+  };
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  PrefixCompletion prefix_completion(d);
+  CompletionSession session(d);
+
+  // type character by character and compare with completing the full query
+  const std::string query = "angela merkel";
+  for (size_t i = 0; i < query.size(); ++i) {
+    session.Append(query.substr(i, 1));
+    BOOST_CHECK_EQUAL(query.substr(0, i + 1), session.GetQuery());
+    BOOST_CHECK(ToStrings(prefix_completion.GetCompletions(session.GetQuery())) ==
+                ToStrings(session.GetCompletions()));
+  }
+
+  // leave the automaton and come back
+  session.Append("xy");
+  BOOST_CHECK(!session.HasCompletions());
+  BOOST_CHECK(ToStrings(session.GetCompletions()).empty());
+  BOOST_CHECK(session.Backspace());
+  BOOST_CHECK(session.Backspace());
+  BOOST_CHECK(session.HasCompletions());
+  BOOST_CHECK(ToStrings(session.GetCompletions()) == std::vector<std::string>{"angela merkel"});
+
+  session.SetQuery("angelo");
+  BOOST_CHECK_EQUAL("angelo", session.GetQuery());
+  BOOST_CHECK(ToStrings(session.GetCompletions()) == std::vector<std::string>{"angelo merk"});
+
+  session.SetQuery("ang");
+  BOOST_CHECK(ToStrings(prefix_completion.GetCompletions("ang", 3)) == ToStrings(session.GetCompletions(3)));
+
+  // backspace removes a whole code point
+  session.SetQuery("aabcü");
+  BOOST_CHECK(ToStrings(session.GetCompletions()) == std::vector<std::string>{"aabcül"});
+  BOOST_CHECK(session.Backspace());
+  BOOST_CHECK_EQUAL("aabc", session.GetQuery());
+
+  session.Clear();
+  BOOST_CHECK_EQUAL("", session.GetQuery());
+  BOOST_CHECK(!session.Backspace());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace completion */
+} /* namespace dictionary */
+} /* namespace keyvi */
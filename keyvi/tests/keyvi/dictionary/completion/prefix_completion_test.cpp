@@ -168,6 +168,41 @@ BOOST_AUTO_TEST_CASE(approxWithExactPrefix) {
   BOOST_CHECK(expected_it == expected_output.end());
 }
 
+BOOST_AUTO_TEST_CASE(budget) {
+  std::vector<std::pair<std::string, uint32_t>> test_data;
+  for (size_t i = 0; i < 1000; ++i) {
+    test_data.emplace_back("abc" + std::to_string(i), i);
+  }
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+  PrefixCompletion prefix_completion(d);
+
+  auto budget = std::make_shared<util::TraversalBudget>(5);
+  size_t matches = 0;
+  for (auto m : prefix_completion.GetCompletions("abc", 100, budget)) {
+    ++matches;
+  }
+  BOOST_CHECK(budget->IsTruncated());
+  BOOST_CHECK_LE(matches, 5);
+
+  budget = std::make_shared<util::TraversalBudget>(5);
+  matches = 0;
+  for (auto m : prefix_completion.GetFuzzyCompletions("abd", 1, 2, budget)) {
+    ++matches;
+  }
+  BOOST_CHECK(budget->IsTruncated());
+  BOOST_CHECK_LE(matches, 5);
+
+  budget = std::make_shared<util::TraversalBudget>();
+  matches = 0;
+  for (auto m : prefix_completion.GetFuzzyCompletions("abd", 1, 2, budget)) {
+    ++matches;
+  }
+  BOOST_CHECK(!budget->IsTruncated());
+  BOOST_CHECK_EQUAL(1000, matches);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace completion */
@@ -23,6 +23,12 @@
  *      Author: hendrik
  */
 
+#include <algorithm>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
 
 #include "keyvi/dictionary/dictionary.h"
@@ -238,6 +244,119 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(MultipleKeyUpdateAndCompile, DictT, json_types) {
   BOOST_CHECK_THROW(compiler.Add("a", "1"), compiler_exception);
 }
 
+BOOST_AUTO_TEST_CASE(sortedInput) {
+  keyvi::dictionary::DictionaryCompiler<dictionary_type_t::JSON> compiler(
+      keyvi::util::parameters_t({{SORTED_INPUT_KEY, "true"}}));
+
+  BOOST_CHECK_THROW(compiler.WriteToFile("never-written"), compiler_exception);
+
+  compiler.Add("", "{\"id\":0}");
+  compiler.Add("abc", "{\"id\":1}");
+  compiler.Add("abcd", "{\"id\":2}");
+  compiler.Add("abcd", "{\"id\":3}");
+  compiler.Add("abd", "{\"id\":4}");
+  compiler.Add("\xc3\xa4ndern", "{\"id\":5}");
+  BOOST_CHECK_THROW(compiler.Add("abe", "{\"id\":6}"), compiler_exception);
+  compiler.Compile();
+  BOOST_CHECK_THROW(compiler.Add("zoo", "{\"id\":7}"), compiler_exception);
+
+  boost::filesystem::path temp_path = boost::filesystem::temp_directory_path();
+  temp_path /= boost::filesystem::unique_path("dictionary-unit-test-dictionarycompiler-%%%%-%%%%-%%%%-%%%%");
+  std::string file_name = temp_path.string();
+
+  compiler.WriteToFile(file_name);
+
+  Dictionary d(file_name.c_str());
+  BOOST_CHECK_EQUAL(4, d.GetSize());
+  BOOST_CHECK_EQUAL("{\"id\":1}", d["abc"].GetValueAsString());
+  BOOST_CHECK_EQUAL("{\"id\":3}", d["abcd"].GetValueAsString());
+  BOOST_CHECK_EQUAL("{\"id\":4}", d["abd"].GetValueAsString());
+  BOOST_CHECK_EQUAL("{\"id\":5}", d["\xc3\xa4ndern"].GetValueAsString());
+  BOOST_CHECK(d["abe"].IsEmpty());
+
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(sortedInputEqualsUnsorted) {
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 5000; ++i) {
+    keys.push_back("key-" + std::to_string(i));
+  }
+  std::sort(keys.begin(), keys.end());
+
+  keyvi::dictionary::DictionaryCompiler<dictionary_type_t::INT_WITH_WEIGHTS> sorted_compiler(
+      keyvi::util::parameters_t({{SORTED_INPUT_KEY, "true"}, {EXPECTED_SIZE_OF_KEYS_KEY, "50000"}}));
+  keyvi::dictionary::DictionaryCompiler<dictionary_type_t::INT_WITH_WEIGHTS> compiler;
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    sorted_compiler.Add(keys[i], i);
+    compiler.Add(keys[keys.size() - i - 1], keys.size() - i - 1);
+  }
+
+  sorted_compiler.Compile();
+  compiler.Compile();
+
+  std::stringstream sorted_stream;
+  std::stringstream stream;
+  sorted_compiler.Write(sorted_stream);
+  compiler.Write(stream);
+
+  BOOST_CHECK(sorted_stream.str() == stream.str());
+}
+
+BOOST_AUTO_TEST_CASE(duplicateKeysLastValueWins) {
+  const std::string long_prefix = "loooooooooooooooonnnnnnnngggggggg_key-";
+
+  for (const keyvi::util::parameters_t& params :
+       {keyvi::util::parameters_t(), keyvi::util::parameters_t({{MEMORY_LIMIT_KEY, std::to_string(1024 * 1024)}}),
+        keyvi::util::parameters_t({{MEMORY_LIMIT_KEY, std::to_string(1024 * 1024)}, {PARALLEL_CHUNK_BUILDS_KEY, "2"}}),
+        keyvi::util::parameters_t({{VALUE_ENCODING_THREADS_KEY, "2"}})}) {
+    keyvi::dictionary::DictionaryCompiler<dictionary_type_t::JSON> compiler(params);
+
+    compiler.Add("a", "\"first\"");
+    compiler.Add("b", "\"b\"");
+
+    // with a small memory limit, keys span several chunks
+    for (size_t i = 0; i < 50000; ++i) {
+      compiler.Add(long_prefix + std::to_string(i), "{\"id\":" + std::to_string(i) + "}");
+      if (i == 100) {
+        // in the same chunk
+        compiler.Add("c", "\"first\"");
+        compiler.Add("c", "\"second\"");
+        compiler.Add("c", "\"third\"");
+      }
+    }
+    compiler.Add("a", "\"second\"");
+    compiler.Add(long_prefix + "7", "\"last\"");
+    compiler.Compile();
+
+    std::stringstream stream;
+    compiler.Write(stream);
+    const std::string buffer = stream.str();
+    Dictionary d(std::make_shared<fsa::Automata>(buffer.data(), buffer.size()));
+
+    BOOST_CHECK_EQUAL(50003, d.GetSize());
+    BOOST_CHECK_EQUAL("\"second\"", d["a"].GetValueAsString());
+    BOOST_CHECK_EQUAL("\"b\"", d["b"].GetValueAsString());
+    BOOST_CHECK_EQUAL("\"third\"", d["c"].GetValueAsString());
+    BOOST_CHECK_EQUAL("\"last\"", d[long_prefix + "7"].GetValueAsString());
+    BOOST_CHECK_EQUAL("{\"id\":8}", d[long_prefix + "8"].GetValueAsString());
+  }
+
+  keyvi::dictionary::DictionaryCompiler<dictionary_type_t::JSON> sorted_compiler(
+      keyvi::util::parameters_t({{SORTED_INPUT_KEY, "true"}}));
+  sorted_compiler.Add("a", "\"first\"");
+  sorted_compiler.Add("a", "\"second\"");
+  sorted_compiler.Add("b", "\"b\"");
+  sorted_compiler.Compile();
+
+  std::stringstream stream;
+  sorted_compiler.Write(stream);
+  const std::string buffer = stream.str();
+  Dictionary d(std::make_shared<fsa::Automata>(buffer.data(), buffer.size()));
+  BOOST_CHECK_EQUAL("\"second\"", d["a"].GetValueAsString());
+}
+
 void bigger_compile_test(const keyvi::util::parameters_t& params = keyvi::util::parameters_t(), size_t keys = 5000) {
   keyvi::dictionary::DictionaryCompiler<dictionary_type_t::JSON> compiler(params);
 
@@ -269,6 +388,14 @@ BOOST_AUTO_TEST_CASE(bigger_compile_1MB_50k) {
   bigger_compile_test({{MEMORY_LIMIT_KEY, std::to_string(1024 * 1024)}}, 50000);
 }
 
+BOOST_AUTO_TEST_CASE(bigger_compile_1MB_50k_parallel_chunk_build) {
+  bigger_compile_test({{MEMORY_LIMIT_KEY, std::to_string(1024 * 1024)}, {PARALLEL_CHUNK_BUILDS_KEY, "1"}}, 50000);
+}
+
+BOOST_AUTO_TEST_CASE(bigger_compile_4MB_50k_parallel_chunk_builds) {
+  bigger_compile_test({{MEMORY_LIMIT_KEY, std::to_string(4 * 1024 * 1024)}, {PARALLEL_CHUNK_BUILDS_KEY, "3"}}, 50000);
+}
+
 BOOST_AUTO_TEST_CASE(bigger_compile_parallel_1MB) {
   bigger_compile_test({{MEMORY_LIMIT_KEY, std::to_string(1024 * 1024)}, {PARALLEL_SORT_THRESHOLD_KEY, "1"}});
 }
@@ -304,6 +431,130 @@ BOOST_AUTO_TEST_CASE(float_dictionary) {
   std::remove(file_name.c_str());
 }
 
+template <typename CompilerT, typename ValueT>
+std::string compile_to_string(const keyvi::util::parameters_t& params, const std::vector<std::string>& keys,
+                              const std::vector<ValueT>& values) {
+  CompilerT compiler(params);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    compiler.Add(keys[i], values[i]);
+  }
+  compiler.Compile();
+
+  std::stringstream stream;
+  compiler.Write(stream);
+  return stream.str();
+}
+
+BOOST_AUTO_TEST_CASE(parallelValueEncoding) {
+  std::vector<std::string> keys;
+  std::vector<std::string> json_values;
+  std::vector<std::vector<float>> float_values;
+
+  for (size_t i = 0; i < 20000; ++i) {
+    keys.push_back("key-" + std::to_string((i * 7919) % 20000));
+    // duplicated values, some of them long enough to get compressed
+    json_values.push_back("{\"id\":" + std::to_string(i % 1000) + ", \"text\": \"" + std::string(i % 50, 'x') + "\"}");
+    float_values.push_back({static_cast<float>(i % 100), 0.5, 1.5});
+  }
+
+  for (keyvi::util::parameters_t params :
+       {keyvi::util::parameters_t({{COMPRESSION_KEY, "zlib"}}),
+        keyvi::util::parameters_t({{MEMORY_LIMIT_KEY, std::to_string(1024 * 1024)}}),
+        keyvi::util::parameters_t({{MINIMIZATION_KEY, "off"}})}) {
+    keyvi::util::parameters_t parallel_params(params);
+    parallel_params[VALUE_ENCODING_THREADS_KEY] = "4";
+
+    // values are added in the same order, so the results are identical
+    BOOST_CHECK(compile_to_string<DictionaryCompiler<dictionary_type_t::JSON>>(params, keys, json_values) ==
+                compile_to_string<DictionaryCompiler<dictionary_type_t::JSON>>(parallel_params, keys, json_values));
+    BOOST_CHECK(compile_to_string<DictionaryCompiler<dictionary_type_t::STRING>>(params, keys, json_values) ==
+                compile_to_string<DictionaryCompiler<dictionary_type_t::STRING>>(parallel_params, keys, json_values));
+
+    params[VECTOR_SIZE_KEY] = "3";
+    parallel_params[VECTOR_SIZE_KEY] = "3";
+    BOOST_CHECK(
+        compile_to_string<DictionaryCompiler<dictionary_type_t::FLOAT_VECTOR>>(params, keys, float_values) ==
+        compile_to_string<DictionaryCompiler<dictionary_type_t::FLOAT_VECTOR>>(parallel_params, keys, float_values));
+  }
+
+  std::vector<std::string> sorted_keys;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    sorted_keys.push_back("key-" + std::to_string(100000 + i));
+  }
+
+  BOOST_CHECK(compile_to_string<DictionaryCompiler<dictionary_type_t::JSON>>({{SORTED_INPUT_KEY, "true"}},
+                                                                            sorted_keys, json_values) ==
+              compile_to_string<DictionaryCompiler<dictionary_type_t::JSON>>(
+                  {{SORTED_INPUT_KEY, "true"}, {VALUE_ENCODING_THREADS_KEY, "3"}}, sorted_keys, json_values));
+}
+
+BOOST_AUTO_TEST_CASE(sortedInputParallelValueEncoding) {
+  keyvi::dictionary::DictionaryCompiler<dictionary_type_t::JSON> compiler(
+      keyvi::util::parameters_t({{SORTED_INPUT_KEY, "true"}, {VALUE_ENCODING_THREADS_KEY, "2"}}));
+
+  compiler.Add("abc", "{\"id\":1}");
+  compiler.Add("abd", "{\"id\":2}");
+  // reported right away, not when the pending values get encoded
+  BOOST_CHECK_THROW(compiler.Add("abc", "{\"id\":3}"), compiler_exception);
+  compiler.Add("abd", "{\"id\":4}");
+  compiler.Add("abe", "{\"id\":5}");
+  compiler.Compile();
+
+  std::stringstream stream;
+  compiler.Write(stream);
+  const std::string buffer = stream.str();
+  Dictionary d(std::make_shared<fsa::Automata>(buffer.data(), buffer.size()));
+
+  BOOST_CHECK_EQUAL(3, d.GetSize());
+  BOOST_CHECK_EQUAL("{\"id\":1}", d["abc"].GetValueAsString());
+  BOOST_CHECK_EQUAL("{\"id\":4}", d["abd"].GetValueAsString());
+  BOOST_CHECK_EQUAL("{\"id\":5}", d["abe"].GetValueAsString());
+}
+
+BOOST_AUTO_TEST_CASE(sortedInputParallelValueEncodingError) {
+  DictionaryCompiler<dictionary_type_t::FLOAT_VECTOR> compiler(keyvi::util::parameters_t(
+      {{VECTOR_SIZE_KEY, "2"}, {SORTED_INPUT_KEY, "true"}, {VALUE_ENCODING_THREADS_KEY, "2"}}));
+
+  compiler.Add("a", {1.0, 2.0});
+  compiler.Add("b", {1.0, 2.0, 3.0});
+  compiler.Add("c", {3.0, 4.0});
+  BOOST_CHECK_THROW(compiler.Compile(), std::invalid_argument);
+
+  // the failed value is dropped, compiling again adds the remaining keys
+  compiler.Compile();
+
+  std::stringstream stream;
+  compiler.Write(stream);
+  const std::string buffer = stream.str();
+  Dictionary d(std::make_shared<fsa::Automata>(buffer.data(), buffer.size()));
+
+  BOOST_CHECK_EQUAL(2, d.GetSize());
+  BOOST_CHECK(!d["a"].IsEmpty());
+  BOOST_CHECK(d["b"].IsEmpty());
+  BOOST_CHECK(!d["c"].IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(parallelValueEncodingError) {
+  DictionaryCompiler<dictionary_type_t::FLOAT_VECTOR> compiler(
+      keyvi::util::parameters_t({{VECTOR_SIZE_KEY, "2"}, {VALUE_ENCODING_THREADS_KEY, "2"}}));
+
+  compiler.Add("a", {1.0, 2.0});
+  compiler.Add("b", {1.0, 2.0, 3.0});
+  compiler.Add("c", {3.0, 4.0});
+  BOOST_CHECK_THROW(compiler.Compile(), std::invalid_argument);
+
+  compiler.Compile();
+
+  std::stringstream stream;
+  compiler.Write(stream);
+  const std::string buffer = stream.str();
+  Dictionary d(std::make_shared<fsa::Automata>(buffer.data(), buffer.size()));
+
+  BOOST_CHECK_EQUAL(2, d.GetSize());
+  BOOST_CHECK(d["b"].IsEmpty());
+  BOOST_CHECK_EQUAL("3, 4", d["c"].GetValueAsString());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace dictionary */
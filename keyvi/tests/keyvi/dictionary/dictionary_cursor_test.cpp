@@ -0,0 +1,176 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * dictionary_cursor_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/dictionary_cursor.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+
+BOOST_AUTO_TEST_SUITE(DictionaryCursorTests)
+
+std::vector<std::string> Collect(DictionaryCursor* cursor) {
+  std::vector<std::string> keys;
+  while (!cursor->AtEnd()) {
+    keys.push_back(cursor->GetKey());
+    cursor->Next();
+  }
+  return keys;
+}
+
+BOOST_AUTO_TEST_CASE(IterateAll) {
+  std::vector<std::string> test_data = {"aaaa", "aabb", "aabc", "aacd", "bbcd", "bb", "b", "\xc3\xa4", "zz"};
+  testing::TempDictionary dictionary(&test_data);
+  Dictionary d(dictionary.GetFsa());
+
+  std::sort(test_data.begin(), test_data.end());
+
+  DictionaryCursor cursor = d.GetCursor();
+  std::vector<std::string> keys = Collect(&cursor);
+  BOOST_CHECK_EQUAL_COLLECTIONS(test_data.begin(), test_data.end(), keys.begin(), keys.end());
+  BOOST_CHECK(!cursor.Next());
+  BOOST_CHECK(cursor.GetMatch().IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(Seek) {
+  std::vector<std::string> test_data = {"aaaa", "aabb", "aabc", "aacd", "bbcd", "bb", "b", "zz"};
+  testing::TempDictionary dictionary(&test_data);
+  Dictionary d(dictionary.GetFsa());
+  DictionaryCursor cursor = d.GetCursor();
+
+  // exact
+  BOOST_CHECK(cursor.Seek("aabc"));
+  BOOST_CHECK_EQUAL("aabc", cursor.GetKey());
+  BOOST_CHECK(cursor.Next());
+  BOOST_CHECK_EQUAL("aacd", cursor.GetKey());
+
+  // prefix of a key
+  BOOST_CHECK(cursor.Seek("aab"));
+  BOOST_CHECK_EQUAL("aabb", cursor.GetKey());
+
+  // in between
+  BOOST_CHECK(cursor.Seek("aabbb"));
+  BOOST_CHECK_EQUAL("aabc", cursor.GetKey());
+  BOOST_CHECK(cursor.Seek("aad"));
+  BOOST_CHECK_EQUAL("b", cursor.GetKey());
+  BOOST_CHECK(cursor.Seek("bbd"));
+  BOOST_CHECK_EQUAL("zz", cursor.GetKey());
+  BOOST_CHECK(cursor.Seek(""));
+  BOOST_CHECK_EQUAL("aaaa", cursor.GetKey());
+
+  // after the last key
+  BOOST_CHECK(!cursor.Seek("zzz"));
+  BOOST_CHECK(cursor.AtEnd());
+  BOOST_CHECK(!cursor.Seek("\xff"));
+
+  // seek back after exhaustion
+  BOOST_CHECK(cursor.Seek("bb"));
+  BOOST_CHECK_EQUAL("bb", cursor.GetKey());
+}
+
+BOOST_AUTO_TEST_CASE(SeekAgainstSortedKeys) {
+  std::vector<std::string> test_data;
+  for (size_t i = 0; i < 500; ++i) {
+    test_data.push_back(std::to_string(i * 7));
+  }
+  testing::TempDictionary dictionary(&test_data);
+  Dictionary d(dictionary.GetFsa());
+  std::sort(test_data.begin(), test_data.end());
+
+  DictionaryCursor cursor = d.GetCursor();
+  for (size_t i = 0; i < 3600; i += 13) {
+    const std::string key = std::to_string(i);
+    auto expected = std::lower_bound(test_data.begin(), test_data.end(), key);
+
+    BOOST_CHECK_EQUAL(expected != test_data.end(), cursor.Seek(key));
+    if (expected != test_data.end()) {
+      BOOST_CHECK_EQUAL(*expected, cursor.GetKey());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Range) {
+  std::vector<std::pair<std::string, std::string>> test_data = {
+      {"abc", "1"}, {"abd", "2"}, {"abde", "3"}, {"b", "4"}, {"bcd", "5"}, {"c", "6"}};
+  testing::TempDictionary dictionary(&test_data);
+  Dictionary d(dictionary.GetFsa());
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  for (auto m : d.GetRange("abd", "bcd")) {
+    keys.push_back(m.GetMatchedString());
+    values.push_back(m.GetValueAsString());
+  }
+
+  std::vector<std::string> expected_keys = {"abd", "abde", "b"};
+  std::vector<std::string> expected_values = {"2", "3", "4"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_keys.begin(), expected_keys.end(), keys.begin(), keys.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_values.begin(), expected_values.end(), values.begin(), values.end());
+
+  keys.clear();
+  for (auto m : d.GetRange("b")) {
+    keys.push_back(m.GetMatchedString());
+  }
+  expected_keys = {"b", "bcd", "c"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_keys.begin(), expected_keys.end(), keys.begin(), keys.end());
+
+  size_t count = 0;
+  for (auto m : d.GetRange("abd", "abd")) {
+    ++count;
+  }
+  for (auto m : d.GetRange("x")) {
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(0, count);
+
+  // pagination
+  DictionaryCursor cursor = d.GetCursor("c");
+  std::vector<std::string> page;
+  for (size_t i = 0; i < 2 && !cursor.AtEnd(); ++i, cursor.Next()) {
+    page.push_back(cursor.GetKey());
+  }
+  expected_keys = {"abc", "abd"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_keys.begin(), expected_keys.end(), page.begin(), page.end());
+
+  // resume from the last key of the page
+  cursor.Seek(page.back());
+  cursor.Next();
+  std::vector<std::string> rest = Collect(&cursor);
+  expected_keys = {"abde", "b", "bcd"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_keys.begin(), expected_keys.end(), rest.begin(), rest.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,177 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * dictionary_set_operation_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/dictionary_set_operation.h"
+#include "keyvi/dictionary/fsa/entry_iterator.h"
+#include "keyvi/dictionary/fsa/generator.h"
+#include "keyvi/dictionary/fsa/internal/sparse_array_persistence.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+
+BOOST_AUTO_TEST_SUITE(DictionarySetOperationTests)
+
+std::vector<std::string> Keys(const std::vector<std::pair<std::string, std::string>>& data) {
+  std::vector<std::string> keys;
+  for (const auto& entry : data) {
+    keys.push_back(entry.first);
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+std::vector<std::string> Collect(MatchIterator::MatchIteratorPair matches) {
+  std::vector<std::string> keys;
+  for (auto m : matches) {
+    keys.push_back(m.GetMatchedString());
+  }
+  return keys;
+}
+
+BOOST_AUTO_TEST_CASE(SetOperations) {
+  std::vector<std::pair<std::string, std::string>> test_data_a = {
+      {"a", "a1"}, {"abc", "a2"}, {"abcd", "a3"}, {"b", "a4"}, {"bcd", "a5"}, {"\xc3\xa4", "a6"}, {"zz", "a7"}};
+  std::vector<std::pair<std::string, std::string>> test_data_b = {
+      {"ab", "b1"}, {"abc", "b2"}, {"abcde", "b3"}, {"b", "b4"}, {"bce", "b5"}, {"\xc3\xa4", "b6"}, {"zzz", "b7"}};
+  for (size_t i = 0; i < 300; ++i) {
+    test_data_a.emplace_back("key" + std::to_string(i * 2), "a");
+    test_data_b.emplace_back("key" + std::to_string(i * 3), "b");
+  }
+
+  testing::TempDictionary dictionary_a(&test_data_a);
+  testing::TempDictionary dictionary_b(&test_data_b);
+  Dictionary a(dictionary_a.GetFsa());
+  Dictionary b(dictionary_b.GetFsa());
+
+  const std::vector<std::string> keys_a = Keys(test_data_a);
+  const std::vector<std::string> keys_b = Keys(test_data_b);
+  std::vector<std::string> expected;
+
+  std::set_intersection(keys_a.begin(), keys_a.end(), keys_b.begin(), keys_b.end(), std::back_inserter(expected));
+  std::vector<std::string> keys = Collect(a.GetIntersection(b));
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), keys.begin(), keys.end());
+
+  expected.clear();
+  std::set_difference(keys_a.begin(), keys_a.end(), keys_b.begin(), keys_b.end(), std::back_inserter(expected));
+  keys = Collect(a.GetDifference(b));
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), keys.begin(), keys.end());
+
+  expected.clear();
+  std::set_difference(keys_b.begin(), keys_b.end(), keys_a.begin(), keys_a.end(), std::back_inserter(expected));
+  keys = Collect(b.GetDifference(a));
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), keys.begin(), keys.end());
+
+  expected.clear();
+  std::set_union(keys_a.begin(), keys_a.end(), keys_b.begin(), keys_b.end(), std::back_inserter(expected));
+  keys = Collect(a.GetUnion(b));
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), keys.begin(), keys.end());
+
+  // with itself
+  keys = Collect(a.GetIntersection(a));
+  BOOST_CHECK_EQUAL_COLLECTIONS(keys_a.begin(), keys_a.end(), keys.begin(), keys.end());
+  BOOST_CHECK(Collect(a.GetDifference(a)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(BothValues) {
+  std::vector<std::pair<std::string, std::string>> test_data_a = {{"abc", "a1"}, {"abd", "a2"}, {"b", "a3"}};
+  std::vector<std::pair<std::string, std::string>> test_data_b = {{"abc", "b1"}, {"abe", "b2"}, {"b", "b3"}};
+
+  testing::TempDictionary dictionary_a(&test_data_a);
+  testing::TempDictionary dictionary_b(&test_data_b);
+
+  DictionarySetOperation set_operation(dictionary_a.GetFsa(), dictionary_b.GetFsa(), set_union);
+
+  std::vector<std::string> values;
+  while (!set_operation.AtEnd()) {
+    const std::string value_a = set_operation.InA() ? set_operation.GetMatchA().GetValueAsString() : "-";
+    const std::string value_b = set_operation.InB() ? set_operation.GetMatchB().GetValueAsString() : "-";
+    values.push_back(set_operation.GetKey() + ":" + value_a + ":" + value_b);
+    set_operation.Next();
+  }
+
+  std::vector<std::string> expected = {"abc:a1:b1", "abd:a2:-", "abe:-:b2", "b:a3:b3"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), values.begin(), values.end());
+  BOOST_CHECK(!set_operation.Next());
+  BOOST_CHECK(set_operation.GetMatch().IsEmpty());
+
+  // union takes the value of A if the key is in both
+  std::map<std::string, std::string> union_values;
+  for (auto m : Dictionary(dictionary_a.GetFsa()).GetUnion(Dictionary(dictionary_b.GetFsa()))) {
+    union_values[m.GetMatchedString()] = m.GetValueAsString();
+  }
+  BOOST_CHECK_EQUAL("a1", union_values["abc"]);
+  BOOST_CHECK_EQUAL("b2", union_values["abe"]);
+}
+
+BOOST_AUTO_TEST_CASE(FeedIntoGenerator) {
+  std::vector<std::string> test_data_a = {"aaaa", "aabb", "aabc", "aacd", "bbcd"};
+  std::vector<std::string> test_data_b = {"aab", "aabc", "bb", "bbcd", "cc"};
+
+  testing::TempDictionary dictionary_a(&test_data_a);
+  testing::TempDictionary dictionary_b(&test_data_b);
+
+  // the result is sorted, so it can be fed directly into the generator
+  fsa::Generator<fsa::internal::SparseArrayPersistence<>> g(keyvi::util::parameters_t({{"memory_limit_mb", "10"}}));
+  DictionarySetOperation set_operation(dictionary_a.GetFsa(), dictionary_b.GetFsa(), set_union);
+  for (; !set_operation.AtEnd(); set_operation.Next()) {
+    g.Add(set_operation.GetKey());
+  }
+  g.CloseFeeding();
+
+  const std::string file_name =
+      (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  std::ofstream out_stream(file_name, std::ios::binary);
+  g.Write(out_stream);
+  out_stream.close();
+
+  fsa::automata_t f(new fsa::Automata(file_name));
+  std::vector<std::string> keys;
+  for (fsa::EntryIterator it(f), end_it; it != end_it; ++it) {
+    keys.push_back(it.GetKey());
+  }
+
+  std::vector<std::string> expected = {"aaaa", "aab", "aabb", "aabc", "aacd", "bb", "bbcd", "cc"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected.begin(), expected.end(), keys.begin(), keys.end());
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace dictionary */
+} /* namespace keyvi */
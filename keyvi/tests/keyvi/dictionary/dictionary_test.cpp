@@ -23,6 +23,22 @@
  *      Author: hendrik
  */
 
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -297,6 +313,404 @@ BOOST_AUTO_TEST_CASE(DictGetPrefixCompletionCustomFilter) {
   BOOST_CHECK_EQUAL(expected_matches.size(), i);
 }
 
+BOOST_AUTO_TEST_CASE(DictLookupTextStreaming) {
+  std::vector<std::pair<std::string, uint32_t>> test_data = {
+      {"new", 1}, {"new york", 2}, {"new york city", 3}, {"york", 4}, {"city", 5}, {"city hall", 6}, {"hall", 7},
+  };
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  const std::string text = "the new york city hall is in new yorkshire";
+
+  std::vector<std::string> matches;
+  std::vector<size_t> starts;
+  for (auto m : d->LookupTextStreaming(text)) {
+    matches.push_back(m.GetMatchedString());
+    starts.push_back(m.GetStart());
+    BOOST_CHECK_EQUAL(m.GetMatchedString(), text.substr(m.GetStart(), m.GetEnd() - m.GetStart()));
+  }
+
+  std::vector<std::string> expected_matches = {"new york city", "hall", "new"};
+  std::vector<size_t> expected_starts = {4, 18, 29};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_matches.begin(), expected_matches.end(), matches.begin(), matches.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_starts.begin(), expected_starts.end(), starts.begin(), starts.end());
+
+  matches.clear();
+  for (auto m : d->LookupTextStreaming(text, false)) {
+    matches.push_back(m.GetMatchedString());
+  }
+
+  expected_matches = {"new", "new york", "york", "new york city", "city", "city hall", "hall", "new"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_matches.begin(), expected_matches.end(), matches.begin(), matches.end());
+
+  // all matches contain the leftmost longest matches of LookupText
+  std::vector<std::string> lookup_text_matches;
+  for (auto m : d->LookupText(text)) {
+    lookup_text_matches.push_back(m.GetMatchedString());
+  }
+  for (const std::string& m : std::vector<std::string>{"new york city", "hall"}) {
+    BOOST_CHECK(std::find(lookup_text_matches.begin(), lookup_text_matches.end(), m) != lookup_text_matches.end());
+  }
+
+  size_t count = 0;
+  for (auto m : d->LookupTextStreaming("")) {
+    ++count;
+  }
+  for (auto m : d->LookupTextStreaming("yorkshire  cityhall")) {
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(0, count);
+
+  for (auto m : d->LookupTextStreaming("city")) {
+    BOOST_CHECK_EQUAL("5", boost::get<std::string>(m.GetAttribute("weight")));
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(1, count);
+}
+
+BOOST_AUTO_TEST_CASE(DictLookupTextStreamingCompareWithBruteForce) {
+  const std::vector<std::string> tokens = {"a", "b", "ab", "ba", "aa"};
+  std::srand(42);
+  auto random_phrase = [&tokens](const size_t max_tokens) {
+    std::string phrase = tokens[std::rand() % tokens.size()];
+    for (size_t i = std::rand() % max_tokens; i > 0; --i) {
+      phrase += " " + tokens[std::rand() % tokens.size()];
+    }
+    return phrase;
+  };
+
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 40; ++i) {
+    keys.push_back(random_phrase(4));
+  }
+  testing::TempDictionary dictionary(&keys);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  for (size_t i = 0; i < 200; ++i) {
+    const std::string text = random_phrase(20);
+
+    std::vector<size_t> token_starts;
+    std::vector<size_t> token_ends;
+    for (size_t position = 0; position < text.size(); ++position) {
+      if (position == 0 || text[position - 1] == ' ') {
+        token_starts.push_back(position);
+      }
+      if (position + 1 == text.size() || text[position + 1] == ' ') {
+        token_ends.push_back(position + 1);
+      }
+    }
+
+    auto contains = [&d](const std::string& key) { return d->Contains(key); };
+
+    // all matches, ordered by end, then by start
+    std::vector<std::pair<size_t, size_t>> expected;
+    for (const size_t end : token_ends) {
+      for (const size_t start : token_starts) {
+        if (start < end && contains(text.substr(start, end - start))) {
+          expected.emplace_back(start, end);
+        }
+      }
+    }
+
+    std::vector<std::pair<size_t, size_t>> actual;
+    for (auto m : d->LookupTextStreaming(text, false)) {
+      actual.emplace_back(m.GetStart(), m.GetEnd());
+    }
+    BOOST_CHECK_MESSAGE(expected == actual, "all matches: " + text);
+
+    // leftmost longest
+    expected.clear();
+    size_t last_end = 0;
+    for (const size_t start : token_starts) {
+      if (start < last_end) {
+        continue;
+      }
+      for (auto end = token_ends.rbegin(); end != token_ends.rend(); ++end) {
+        if (start < *end && contains(text.substr(start, *end - start))) {
+          expected.emplace_back(start, *end);
+          last_end = *end;
+          break;
+        }
+      }
+    }
+
+    actual.clear();
+    for (auto m : d->LookupTextStreaming(text)) {
+      actual.emplace_back(m.GetStart(), m.GetEnd());
+    }
+    BOOST_CHECK_MESSAGE(expected == actual, "leftmost longest: " + text);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(DictGetRegexAndGlob) {
+  std::vector<std::pair<std::string, std::string>> test_data = {
+      {"abc-1", "1"},    {"abc-12", "2"}, {"abd-3", "3"},      {"abcd-4", "4"}, {"foobar", "5"},
+      {"foo-bar", "6"},  {"foo", "7"},    {"foo-baz", "8"},    {"xyz-99", "9"}, {"st\xc3\xb6re", "10"},
+      {"abc-", "11"},    {"ab", "12"},
+  };
+  for (size_t i = 0; i < 500; ++i) {
+    test_data.emplace_back("key" + std::to_string(i), std::to_string(i));
+  }
+
+  testing::TempDictionary dictionary = testing::TempDictionary::makeTempDictionaryFromJson(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  auto collect = [](MatchIterator::MatchIteratorPair matches) {
+    std::vector<std::string> result;
+    for (auto m : matches) {
+      result.push_back(m.GetMatchedString());
+    }
+    return result;
+  };
+
+  // compare with filtering all items
+  auto expected = [&d](const std::string& regex) {
+    std::vector<std::string> result;
+    for (auto m : d->GetAllItems()) {
+      if (std::regex_match(m.GetMatchedString(), std::regex(regex))) {
+        result.push_back(m.GetMatchedString());
+      }
+    }
+    return result;
+  };
+
+  for (const std::string regex : {"[a-z]{3}-\\d+", "foo.*bar", "ab.*", "key1[0-9]?", "key(1|22|33)\\d", "foo",
+                                  "f?o+", "ab", "x.*z", ".*9", "zzz"}) {
+    BOOST_CHECK(expected(regex) == collect(d->GetRegex(regex)));
+  }
+
+  std::vector<std::string> matches = collect(d->GetRegex("st.re"));
+  BOOST_CHECK(std::vector<std::string>{"st\xc3\xb6re"} == matches);
+
+  matches = collect(d->GetGlob("foo*bar"));
+  BOOST_CHECK(std::vector<std::string>({"foo-bar", "foobar"}) == matches);
+
+  matches = collect(d->GetGlob("key4?"));
+  BOOST_CHECK_EQUAL(10, matches.size());
+
+  matches = collect(d->GetGlob("*"));
+  BOOST_CHECK_EQUAL(test_data.size(), matches.size());
+
+  for (auto m : d->GetGlob("foo")) {
+    BOOST_CHECK_EQUAL("7", m.GetValueAsString());
+  }
+
+  BOOST_CHECK_THROW(d->GetRegex("(foo"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(DictTraversalBudget) {
+  std::vector<std::pair<std::string, uint32_t>> test_data;
+  for (size_t i = 0; i < 2000; ++i) {
+    test_data.emplace_back("key" + std::to_string(i), i);
+  }
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  auto collect = [](MatchIterator::MatchIteratorPair matches) {
+    std::vector<std::string> result;
+    for (auto m : matches) {
+      result.push_back(m.GetMatchedString());
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+  };
+
+  // check that a limited budget truncates and returns a subset of the full result
+  auto check_truncated = [&collect](const std::vector<std::string>& all_matches,
+                                    std::function<MatchIterator::MatchIteratorPair(util::traversal_budget_t)> query) {
+    auto unlimited_budget = std::make_shared<util::TraversalBudget>();
+    std::vector<std::string> matches = collect(query(unlimited_budget));
+    BOOST_CHECK(!unlimited_budget->IsTruncated());
+    BOOST_CHECK(all_matches == matches);
+
+    auto budget = std::make_shared<util::TraversalBudget>(10);
+    matches = collect(query(budget));
+    BOOST_CHECK(budget->IsTruncated());
+    BOOST_CHECK_EQUAL(11, budget->GetVisitedStates());
+    BOOST_CHECK_LT(matches.size(), all_matches.size());
+    BOOST_CHECK(std::includes(all_matches.begin(), all_matches.end(), matches.begin(), matches.end()));
+
+    auto expired_budget = std::make_shared<util::TraversalBudget>();
+    expired_budget->SetDeadline(std::chrono::steady_clock::now());
+    matches = collect(query(expired_budget));
+    BOOST_CHECK(expired_budget->IsTruncated());
+    BOOST_CHECK_LE(matches.size(), 1);
+  };
+
+  check_truncated(collect(d->GetFuzzy("key1000", 3)),
+                  [&d](util::traversal_budget_t budget) { return d->GetFuzzy("key1000", 3, 2, budget); });
+  check_truncated(collect(d->GetNear("key1", 3, true)),
+                  [&d](util::traversal_budget_t budget) { return d->GetNear("key1", 3, true, budget); });
+  check_truncated(collect(d->GetPrefixCompletion("key")),
+                  [&d](util::traversal_budget_t budget) { return d->GetPrefixCompletion("key", budget); });
+  check_truncated(collect(d->GetPrefixCompletion("key", 20)),
+                  [&d](util::traversal_budget_t budget) { return d->GetPrefixCompletion("key", 20, budget); });
+  check_truncated(collect(d->GetMultiwordCompletion("key")), [&d](util::traversal_budget_t budget) {
+    return d->GetMultiwordCompletion("key", 0x1b, budget);
+  });
+  check_truncated(collect(d->GetRegex("key1.*")),
+                  [&d](util::traversal_budget_t budget) { return d->GetRegex("key1.*", budget); });
+
+  // a generous budget does not change the result
+  auto budget = std::make_shared<util::TraversalBudget>(1000000, std::chrono::hours(1));
+  BOOST_CHECK(collect(d->GetFuzzy("key1000", 1)) == collect(d->GetFuzzy("key1000", 1, 2, budget)));
+  BOOST_CHECK(!budget->IsTruncated());
+}
+
+BOOST_AUTO_TEST_CASE(DictCountRankSelect) {
+  std::vector<std::string> test_data = {"a", "aa", "aaa", "aab", "ab", "abc", "b", "bbb", "bbc", "cbb", "\xc3\xa4"};
+  for (size_t i = 0; i < 300; ++i) {
+    test_data.push_back("key" + std::to_string(i * 3));
+  }
+
+  testing::TempDictionary dictionary(&test_data);
+  Dictionary d(dictionary.GetFsa());
+  std::sort(test_data.begin(), test_data.end());
+
+  BOOST_CHECK(!dictionary.GetFsa()->HasKeyCounts());
+  BOOST_CHECK_THROW(d.CountPrefix("a"), std::logic_error);
+  BOOST_CHECK_THROW(d.Select(0), std::logic_error);
+
+  d.ComputeKeyCounts();
+  d.ComputeKeyCounts();
+  BOOST_CHECK(dictionary.GetFsa()->HasKeyCounts());
+
+  BOOST_CHECK_EQUAL(test_data.size(), d.CountPrefix(""));
+  BOOST_CHECK_EQUAL(6, d.CountPrefix("a"));
+  BOOST_CHECK_EQUAL(3, d.CountPrefix("aa"));
+  BOOST_CHECK_EQUAL(1, d.CountPrefix("abc"));
+  BOOST_CHECK_EQUAL(2, d.CountPrefix("bb"));
+  BOOST_CHECK_EQUAL(300, d.CountPrefix("key"));
+  BOOST_CHECK_EQUAL(36, d.CountPrefix("key1"));
+  BOOST_CHECK_EQUAL(0, d.CountPrefix("abcd"));
+  BOOST_CHECK_EQUAL(0, d.CountPrefix("x"));
+
+  for (size_t i = 0; i < test_data.size(); ++i) {
+    BOOST_CHECK_EQUAL(i, d.Rank(test_data[i]));
+    BOOST_CHECK_EQUAL(test_data[i], d.Select(i).GetMatchedString());
+  }
+
+  BOOST_CHECK_EQUAL(-1, d.Rank("bb"));
+  BOOST_CHECK_EQUAL(-1, d.Rank("abcd"));
+  BOOST_CHECK_EQUAL(-1, d.Rank(""));
+  BOOST_CHECK(d.Select(test_data.size()).IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(DictShardedIteration) {
+  std::vector<std::string> test_data;
+  for (size_t i = 0; i < 2000; ++i) {
+    test_data.push_back(std::to_string(i * 7919 % 100003));
+  }
+  test_data.push_back("a");
+  test_data.push_back("ab");
+
+  testing::TempDictionary dictionary(&test_data);
+  Dictionary d(dictionary.GetFsa());
+  std::sort(test_data.begin(), test_data.end());
+
+  for (const size_t number_of_shards : {1, 3, 8, 50}) {
+    if (number_of_shards == 50) {
+      // balance by key counts
+      d.ComputeKeyCounts();
+    }
+
+    const std::vector<std::string> boundaries = d.GetShardBoundaries(number_of_shards);
+    BOOST_CHECK_GE(number_of_shards, boundaries.size());
+    BOOST_CHECK(std::is_sorted(boundaries.begin(), boundaries.end()));
+
+    std::vector<std::string> keys;
+    size_t largest_shard = 0;
+    for (auto& shard : d.GetAllItemsSharded(number_of_shards)) {
+      size_t shard_size = 0;
+      for (auto m : shard) {
+        keys.push_back(m.GetMatchedString());
+        ++shard_size;
+      }
+      largest_shard = std::max(largest_shard, shard_size);
+    }
+
+    BOOST_CHECK_EQUAL_COLLECTIONS(test_data.begin(), test_data.end(), keys.begin(), keys.end());
+    if (number_of_shards > 1) {
+      BOOST_CHECK_EQUAL(number_of_shards, boundaries.size());
+      BOOST_CHECK_LT(largest_shard, 2 * test_data.size() / number_of_shards);
+    }
+  }
+
+  std::vector<std::string> small_data = {"a"};
+  testing::TempDictionary small_dictionary(&small_data);
+  Dictionary small_d(small_dictionary.GetFsa());
+  BOOST_CHECK_EQUAL(1, small_d.GetShardBoundaries(4).size());
+}
+
+std::string ReadFile(const std::string& file_name) {
+  std::ifstream in_stream(file_name, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(in_stream), std::istreambuf_iterator<char>());
+}
+
+BOOST_AUTO_TEST_CASE(DictFromBuffer) {
+  std::vector<std::pair<std::string, std::string>> test_data = {
+      {"abc", "{\"a\":1}"}, {"abbc", "{\"b\":2}"}, {"abbcd", "{\"c\":3}"}, {"abcde", "{\"a\":1}"}};
+  testing::TempDictionary dictionary = testing::TempDictionary::makeTempDictionaryFromJson(&test_data);
+
+  std::shared_ptr<std::string> buffer = std::make_shared<std::string>(ReadFile(dictionary.GetFileName()));
+
+  Dictionary d(buffer->data(), buffer->size(), buffer);
+  BOOST_CHECK(d.Contains("abbc"));
+  BOOST_CHECK(!d.Contains("ab"));
+  BOOST_CHECK_EQUAL("{\"c\":3}", d["abbcd"].GetValueAsString());
+  BOOST_CHECK_EQUAL(4, d.GetSize());
+
+  size_t count = 0;
+  for (auto m : d.GetPrefixCompletion("abc")) {
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(2, count);
+
+  // the dictionary keeps the buffer alive
+  buffer.reset();
+  BOOST_CHECK_EQUAL("{\"b\":2}", d["abbc"].GetValueAsString());
+
+  const std::string truncated = ReadFile(dictionary.GetFileName()).substr(0, 100);
+  BOOST_CHECK_THROW(Dictionary(truncated.data(), truncated.size()), std::invalid_argument);
+  BOOST_CHECK_THROW(Dictionary("not a dictionary", 16), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(DictFromFileDescriptor) {
+  std::vector<std::pair<std::string, std::string>> test_data1 = {{"abc", "x"}, {"abd", "yy"}};
+  std::vector<std::string> test_data2 = {"aaaa", "aabb", "bbcc"};
+  testing::TempDictionary dictionary1(&test_data1);
+  testing::TempDictionary dictionary2(&test_data2);
+
+  const std::string content1 = ReadFile(dictionary1.GetFileName());
+  const std::string content2 = ReadFile(dictionary2.GetFileName());
+
+  // pack both dictionaries into 1 file, the 2nd one at an unaligned offset
+  const std::string packed_file_name =
+      (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  {
+    std::ofstream out_stream(packed_file_name, std::ios::binary);
+    out_stream << content2 << "xyz" << content1;
+  }
+
+  const int fd = open(packed_file_name.c_str(), O_RDONLY);
+  BOOST_CHECK(fd != -1);
+
+  Dictionary d1(fd, content2.size() + 3);
+  Dictionary d2(fd, 0, content2.size());
+  close(fd);
+
+  BOOST_CHECK_EQUAL("yy", d1["abd"].GetValueAsString());
+  BOOST_CHECK(!d1.Contains("aabb"));
+  BOOST_CHECK(d2.Contains("aabb"));
+  BOOST_CHECK_EQUAL(3, d2.GetSize());
+
+  BOOST_CHECK_THROW(Dictionary(-1, 0), std::invalid_argument);
+
+  boost::filesystem::remove(packed_file_name);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace dictionary */
@@ -0,0 +1,95 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * anonymous_memory_region_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/fsa/internal/anonymous_memory_region.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+BOOST_AUTO_TEST_SUITE(AnonymousMemoryRegionTests)
+
+BOOST_AUTO_TEST_CASE(Allocate) {
+  AnonymousMemoryRegion region(10000);
+  BOOST_CHECK_EQUAL(10000, region.get_size());
+  BOOST_CHECK(region.get_address() != nullptr);
+
+  std::memset(region.get_address(), 'x', region.get_size());
+  BOOST_CHECK_EQUAL('x', static_cast<char*>(region.get_address())[9999]);
+
+  AnonymousMemoryRegion empty_region(0);
+  BOOST_CHECK_EQUAL(0, empty_region.get_size());
+}
+
+BOOST_AUTO_TEST_CASE(AllocateOnNode) {
+  const std::vector<int> nodes = AnonymousMemoryRegion::GetNumaNodes();
+  const int node = nodes.size() > 0 ? nodes[0] : 0;
+
+  AnonymousMemoryRegion region(4096, node);
+  std::memset(region.get_address(), 'x', region.get_size());
+}
+
+void CheckLoadingStrategy(loading_strategy_types strategy, const keyvi::util::parameters_t& params = {}) {
+  std::vector<std::pair<std::string, std::string>> test_data = {
+      {"abc", "{\"a\":1}"}, {"abbc", "{\"b\":2}"}, {"abbcd", "{\"c\":3}"}, {"abcde", "{\"a\":1}"}, {"abdd", "{}"}};
+
+  testing::TempDictionary dictionary = testing::TempDictionary::makeTempDictionaryFromJson(&test_data);
+  Dictionary d(dictionary.GetFileName(), strategy, params);
+
+  BOOST_CHECK(d.Contains("abc"));
+  BOOST_CHECK(d.Contains("abdd"));
+  BOOST_CHECK(!d.Contains("abd"));
+  BOOST_CHECK_EQUAL("{\"c\":3}", d["abbcd"].GetValueAsString());
+
+  size_t count = 0;
+  for (auto m : d.GetPrefixCompletion("ab")) {
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(5, count);
+}
+
+BOOST_AUTO_TEST_CASE(LoadingStrategies) {
+  CheckLoadingStrategy(loading_strategy_types::populate_key_part_locked);
+  CheckLoadingStrategy(loading_strategy_types::populate_locked);
+  CheckLoadingStrategy(loading_strategy_types::anonymous_key_part);
+  CheckLoadingStrategy(loading_strategy_types::anonymous_key_part, {{NUMA_NODE_KEY, "0"}});
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
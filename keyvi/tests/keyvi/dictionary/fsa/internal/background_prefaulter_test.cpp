@@ -0,0 +1,98 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * background_prefaulter_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/fsa/internal/background_prefaulter.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+BOOST_AUTO_TEST_SUITE(BackgroundPrefaulterTests)
+
+BOOST_AUTO_TEST_CASE(PrefaultRegions) {
+  std::vector<char> buffer1(5 * PREFAULT_CHUNK_SIZE + 17, 'x');
+  std::vector<char> buffer2(42, 'y');
+
+  BackgroundPrefaulter prefaulter({{buffer1.data() + 3, buffer1.size() - 3}, {buffer2.data(), buffer2.size()}}, 3,
+                                  PREFAULT_IO_PRIORITY_IDLE);
+
+  prefaulter.GetFuture().wait();
+  BOOST_CHECK(prefaulter.IsDone());
+}
+
+BOOST_AUTO_TEST_CASE(NoRegions) {
+  BackgroundPrefaulter prefaulter({}, 4);
+
+  prefaulter.GetFuture().wait();
+  BOOST_CHECK(prefaulter.IsDone());
+}
+
+BOOST_AUTO_TEST_CASE(LoadDictionaryInBackground) {
+  std::vector<std::pair<std::string, std::string>> test_data = {
+      {"abc", "{\"a\":1}"}, {"abbc", "{\"b\":2}"}, {"abbcd", "{\"c\":3}"}, {"abcde", "{\"a\":1}"}};
+
+  testing::TempDictionary dictionary = testing::TempDictionary::makeTempDictionaryFromJson(&test_data);
+
+  keyvi::util::parameters_t params = {{PREFAULT_THREADS_KEY, "4"}, {PREFAULT_IO_PRIORITY_KEY, "low"}};
+  Dictionary d(dictionary.GetFileName(), loading_strategy_types::populate_background, params);
+
+  // the dictionary can be used while loading
+  BOOST_CHECK(d.Contains("abbcd"));
+
+  d.GetFsa()->GetLoadingFuture().wait();
+  BOOST_CHECK(d.GetFsa()->IsFullyLoaded());
+  BOOST_CHECK_EQUAL("{\"c\":3}", d["abbcd"].GetValueAsString());
+
+  // other strategies are loaded immediately
+  Dictionary d2(dictionary.GetFileName(), loading_strategy_types::lazy);
+  BOOST_CHECK(d2.GetFsa()->IsFullyLoaded());
+  d2.GetFsa()->GetLoadingFuture().wait();
+}
+
+BOOST_AUTO_TEST_CASE(DestroyWhileLoading) {
+  std::vector<std::string> test_data = {"aaaa", "aabb", "aabc", "bbbb"};
+  testing::TempDictionary dictionary(&test_data);
+
+  for (size_t i = 0; i < 10; ++i) {
+    Dictionary d(dictionary.GetFileName(), loading_strategy_types::populate_background);
+    BOOST_CHECK(d.Contains("aabc"));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -23,6 +23,8 @@
  *      Author: hendrik
  */
 
+#include <stdexcept>
+
 #include <boost/test/unit_test.hpp>
 
 #include "keyvi/dictionary/fsa/internal/lru_generation_cache.h"
@@ -102,6 +104,42 @@ BOOST_AUTO_TEST_CASE(generation) {
   BOOST_CHECK(p1 == cache.Get(p1_1));
 }
 
+BOOST_AUTO_TEST_CASE(generationFilter) {
+  LeastRecentlyUsedGenerationsCache<> cache{100, 4};
+  const size_t memory_usage = cache.GetMemoryUsage();
+
+  for (uint32_t i = 1; i <= 1000; ++i) {
+    cache.Add(PackedState<>{i, static_cast<int32_t>(i * 7919), 1});
+  }
+
+  BOOST_CHECK(cache.GetMemoryUsage() > memory_usage);
+
+  // the current and 3 older generations with 100 entries each
+  for (uint32_t i = 1; i <= 600; ++i) {
+    PackedState<> key{i, static_cast<int32_t>(i * 7919), 1};
+    BOOST_CHECK(cache.Get(key).IsEmpty());
+  }
+
+  for (uint32_t i = 601; i <= 1000; ++i) {
+    PackedState<> key{i, static_cast<int32_t>(i * 7919), 1};
+    BOOST_CHECK_EQUAL(i, cache.Get(key).GetOffset());
+  }
+
+  // found again after they have been moved to the current generation
+  for (uint32_t i = 601; i <= 1000; ++i) {
+    PackedState<> key{i, static_cast<int32_t>(i * 7919), 1};
+    BOOST_CHECK_EQUAL(i, cache.Get(key).GetOffset());
+  }
+
+  cache.Clear();
+  PackedState<> key{1000, static_cast<int32_t>(1000 * 7919), 1};
+  BOOST_CHECK(cache.Get(key).IsEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(tooManyGenerations) {
+  BOOST_CHECK_THROW(LeastRecentlyUsedGenerationsCache<>(5, 9), std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace internal */
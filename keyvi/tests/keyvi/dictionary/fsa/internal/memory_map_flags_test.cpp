@@ -155,6 +155,40 @@ BOOST_AUTO_TEST_CASE(MemoryMapFlagsTestpopulate_key_part_no_readahead_value_part
   BOOST_CHECK(value_advise_flags == boost::interprocess::mapped_region::advice_types::advice_random);
 }
 
+BOOST_AUTO_TEST_CASE(MemoryMapFlagsTestlazy_access_profile) {
+  loading_strategy_types strategy = loading_strategy_types::lazy_access_profile;
+  auto key_advise_flags = MemoryMapFlags::FSAGetMemoryMapAdvices(strategy);
+  auto value_advise_flags = MemoryMapFlags::ValuesGetMemoryMapAdvices(strategy);
+
+#if not defined(OS_MACOSX)
+  int key_flags = MemoryMapFlags::FSAGetMemoryMapOptions(strategy);
+  int value_flags = MemoryMapFlags::ValuesGetMemoryMapOptions(strategy);
+  // no map populate, pages get read ahead using the profile
+  BOOST_CHECK((key_flags & MAP_POPULATE) == 0);
+  BOOST_CHECK((value_flags & MAP_POPULATE) == 0);
+#endif
+
+  BOOST_CHECK(key_advise_flags == boost::interprocess::mapped_region::advice_types::advice_normal);
+  BOOST_CHECK(value_advise_flags == boost::interprocess::mapped_region::advice_types::advice_normal);
+}
+
+BOOST_AUTO_TEST_CASE(MemoryMapFlagsTestpopulate_background) {
+  loading_strategy_types strategy = loading_strategy_types::populate_background;
+  auto key_advise_flags = MemoryMapFlags::FSAGetMemoryMapAdvices(strategy);
+  auto value_advise_flags = MemoryMapFlags::ValuesGetMemoryMapAdvices(strategy);
+
+#if not defined(OS_MACOSX)
+  int key_flags = MemoryMapFlags::FSAGetMemoryMapOptions(strategy);
+  int value_flags = MemoryMapFlags::ValuesGetMemoryMapOptions(strategy);
+  // no map populate, pages get populated in the background
+  BOOST_CHECK((key_flags & MAP_POPULATE) == 0);
+  BOOST_CHECK((value_flags & MAP_POPULATE) == 0);
+#endif
+
+  BOOST_CHECK(key_advise_flags == boost::interprocess::mapped_region::advice_types::advice_normal);
+  BOOST_CHECK(value_advise_flags == boost::interprocess::mapped_region::advice_types::advice_normal);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace internal */
@@ -24,10 +24,13 @@
  */
 
 #include <cstring>
+#include <fstream>
+#include <sstream>
 
 #include <boost/test/unit_test.hpp>
 
 #include "keyvi/dictionary/fsa/internal/memory_map_manager.h"
+#include "keyvi/util/file_output_stream.h"
 
 namespace keyvi {
 namespace dictionary {
@@ -198,6 +201,40 @@ BOOST_AUTO_TEST_CASE(Appendchunkoverflow) {
   boost::filesystem::remove_all(path);
 }
 
+BOOST_AUTO_TEST_CASE(ReserveAndSetBuffer) {
+  size_t chunkSize = 4096;
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path();
+  path /= boost::filesystem::unique_path("dictionary-fsa-unittest-%%%%-%%%%-%%%%-%%%%");
+  boost::filesystem::create_directory(path);
+  MemoryMapManager m(chunkSize, path, "reserve test");
+
+  char buffer[5000];
+  std::fill(buffer, buffer + 1000, 'x');
+  m.Append(buffer, 1000);
+
+  m.Reserve(5000);
+  BOOST_CHECK_EQUAL(6000, m.GetSize());
+  BOOST_CHECK_EQUAL(2, m.GetNumberOfChunks());
+
+  // write across the chunk border
+  std::fill(buffer, buffer + 5000, 'y');
+  m.SetBuffer(1000, buffer, 5000);
+
+  std::fill(buffer, buffer + 1000, 'z');
+  m.Append(buffer, 1000);
+
+  BOOST_CHECK_EQUAL('x', (static_cast<char*>(m.GetAddress(999))[0]));
+  BOOST_CHECK_EQUAL('y', (static_cast<char*>(m.GetAddress(1000))[0]));
+  BOOST_CHECK_EQUAL('y', (static_cast<char*>(m.GetAddress(4095))[0]));
+  BOOST_CHECK_EQUAL('y', (static_cast<char*>(m.GetAddress(4096))[0]));
+  BOOST_CHECK_EQUAL('y', (static_cast<char*>(m.GetAddress(5999))[0]));
+  BOOST_CHECK_EQUAL('z', (static_cast<char*>(m.GetAddress(6000))[0]));
+  BOOST_CHECK_EQUAL(7000, m.GetSize());
+
+  boost::filesystem::remove_all(path);
+}
+
 BOOST_AUTO_TEST_CASE(chunkbehindtail) {
   size_t chunkSize = 4096;
 
@@ -257,6 +294,50 @@ BOOST_AUTO_TEST_CASE(Persist) {
   boost::filesystem::remove_all(path);
 }
 
+BOOST_AUTO_TEST_CASE(WriteToFileOutputStream) {
+  size_t chunkSize = 4096;
+
+  boost::filesystem::path path = boost::filesystem::temp_directory_path();
+  path /= boost::filesystem::unique_path("dictionary-fsa-unittest-%%%%-%%%%-%%%%-%%%%");
+  boost::filesystem::create_directory(path);
+  MemoryMapManager m(chunkSize, path, "write to file test");
+
+  char buffer[3000];
+  for (size_t i = 0; i < 3; ++i) {
+    std::fill(buffer, buffer + 3000, 'a' + i);
+    m.Append(buffer, 3000);
+  }
+
+  std::ostringstream expected_stream;
+  expected_stream << "header";
+  m.Write(expected_stream, m.GetSize());
+  expected_stream << "footer";
+
+  // before and after persisting
+  for (size_t i = 0; i < 2; ++i) {
+    if (i == 1) {
+      m.Persist();
+    }
+
+    auto filename = path;
+    filename /= "out";
+    {
+      keyvi::util::FileOutputStream out_stream(filename.string());
+      out_stream << "header";
+      m.Write(out_stream, m.GetSize());
+      BOOST_CHECK_EQUAL(9006, out_stream.tellp());
+      out_stream << "footer";
+    }
+
+    std::ifstream in_stream(filename.native(), std::ios::binary);
+    std::stringstream actual_stream;
+    actual_stream << in_stream.rdbuf();
+    BOOST_CHECK(expected_stream.str() == actual_stream.str());
+  }
+
+  boost::filesystem::remove_all(path);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace internal */
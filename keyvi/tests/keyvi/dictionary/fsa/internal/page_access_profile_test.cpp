@@ -0,0 +1,200 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * page_access_profile_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/fsa/internal/page_access_profile.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+BOOST_AUTO_TEST_SUITE(PageAccessProfileTests)
+
+BOOST_AUTO_TEST_CASE(SampleAndReplay) {
+  const size_t page_size = boost::interprocess::mapped_region::get_page_size();
+  std::vector<char> buffer(4 * page_size, 'x');
+
+  PageAccessProfile profile;
+  profile.Sample(buffer.data(), buffer.size(), 2 * page_size);
+
+  // the buffer has been touched, so it must be resident
+  BOOST_CHECK(profile.HasPage(2));
+  BOOST_CHECK(profile.HasPage(5));
+  BOOST_CHECK(!profile.HasPage(1));
+  BOOST_CHECK(!profile.HasPage(7));
+
+  // just check that it does not fail
+  profile.Replay(buffer.data(), buffer.size(), 2 * page_size);
+}
+
+BOOST_AUTO_TEST_CASE(WriteAndRead) {
+  const size_t page_size = boost::interprocess::mapped_region::get_page_size();
+  std::vector<char> buffer(3 * page_size, 'x');
+
+  PageAccessProfile profile;
+  profile.Sample(buffer.data(), page_size, 0);
+  profile.Sample(buffer.data(), 3 * page_size, 10 * page_size);
+  profile.Sample(buffer.data(), page_size, 1000 * page_size);
+  const size_t number_of_pages = profile.GetNumberOfPages();
+
+  BOOST_CHECK(number_of_pages >= 5);
+
+  boost::filesystem::path temp_path = boost::filesystem::temp_directory_path();
+  temp_path /= boost::filesystem::unique_path("page-access-profile-unit-test-%%%%-%%%%-%%%%-%%%%");
+
+  profile.WriteToFile(temp_path.string());
+  PageAccessProfile profile_read = PageAccessProfile::FromFile(temp_path.string(), 1002 * page_size);
+  std::remove(temp_path.string().c_str());
+
+  BOOST_CHECK_EQUAL(number_of_pages, profile_read.GetNumberOfPages());
+  for (size_t i = 0; i < 1002; ++i) {
+    BOOST_CHECK_EQUAL(profile.HasPage(i), profile_read.HasPage(i));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ReadClampedToFileSize) {
+  const size_t page_size = boost::interprocess::mapped_region::get_page_size();
+  std::vector<char> buffer(page_size, 'x');
+
+  PageAccessProfile profile;
+  profile.Sample(buffer.data(), page_size, 0);
+  profile.Sample(buffer.data(), page_size, 8 * page_size);
+  profile.Sample(buffer.data(), page_size, 1000000 * page_size);
+
+  boost::filesystem::path temp_path = boost::filesystem::temp_directory_path();
+  temp_path /= boost::filesystem::unique_path("page-access-profile-unit-test-%%%%-%%%%-%%%%-%%%%");
+
+  profile.WriteToFile(temp_path.string());
+  PageAccessProfile profile_read = PageAccessProfile::FromFile(temp_path.string(), 8 * page_size + 1);
+  std::remove(temp_path.string().c_str());
+
+  BOOST_CHECK(profile_read.HasPage(0));
+  BOOST_CHECK(profile_read.HasPage(8));
+  BOOST_CHECK(!profile_read.HasPage(9));
+  BOOST_CHECK(!profile_read.HasPage(1000000));
+}
+
+BOOST_AUTO_TEST_CASE(ReadCorrupt) {
+  const size_t page_size = boost::interprocess::mapped_region::get_page_size();
+  std::vector<char> buffer(page_size, 'x');
+
+  PageAccessProfile profile;
+  profile.Sample(buffer.data(), page_size, 1000 * page_size);
+
+  std::stringstream stream;
+  profile.Write(stream);
+  std::string data = stream.str();
+
+  boost::filesystem::path temp_path = boost::filesystem::temp_directory_path();
+  temp_path /= boost::filesystem::unique_path("page-access-profile-unit-test-%%%%-%%%%-%%%%-%%%%");
+
+  // truncated in the middle of a varint
+  {
+    std::ofstream out_stream(temp_path.string(), std::ios::binary);
+    out_stream.write(data.data(), data.size() - 2);
+  }
+  BOOST_CHECK_THROW(PageAccessProfile::FromFile(temp_path.string(), 2000 * page_size), std::invalid_argument);
+
+  // a huge range
+  {
+    std::ofstream out_stream(temp_path.string(), std::ios::binary);
+    out_stream.write(data.data(), data.size() - 2);
+    out_stream.write("\xff\xff\xff\xff\xff\xff\xff\x7f\x01", 9);
+  }
+  profile = PageAccessProfile::FromFile(temp_path.string(), 2000 * page_size);
+  BOOST_CHECK_EQUAL(0, profile.GetNumberOfPages());
+
+  std::remove(temp_path.string().c_str());
+}
+
+BOOST_AUTO_TEST_CASE(NotAProfile) {
+  std::vector<std::string> test_data = {"aaaa", "aabb"};
+  testing::TempDictionary dictionary(&test_data);
+
+  BOOST_CHECK_THROW(PageAccessProfile::FromFile(dictionary.GetFileName(), 1024), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_CASE(LoadWithProfile) {
+  std::vector<std::pair<std::string, std::string>> test_data = {
+      {"abc", "{\"a\":1}"},   {"abbc", "{\"b\":2}"}, {"abbcd", "{\"c\":3}"},
+      {"abcde", "{\"a\":1}"}, {"abdd", "{\"b\":2}"}};
+
+  testing::TempDictionary dictionary = testing::TempDictionary::makeTempDictionaryFromJson(&test_data);
+  const std::string profile_file_name = PageAccessProfile::GetProfileFileName(dictionary.GetFileName());
+
+  // without a profile
+  {
+    Dictionary d(dictionary.GetFileName(), loading_strategy_types::lazy_access_profile);
+    BOOST_CHECK(d.Contains("abbcd"));
+  }
+
+  {
+    Dictionary d(dictionary.GetFileName());
+    BOOST_CHECK_EQUAL("{\"c\":3}", d["abbcd"].GetValueAsString());
+
+    PageAccessProfile profile;
+    d.GetFsa()->SamplePageAccessProfile(&profile);
+    BOOST_CHECK(profile.GetNumberOfPages() > 0);
+    profile.WriteToFile(profile_file_name);
+  }
+
+  {
+    Dictionary d(dictionary.GetFileName(), loading_strategy_types::lazy_access_profile);
+    BOOST_CHECK(d.Contains("abbcd"));
+    BOOST_CHECK_EQUAL("{\"a\":1}", d["abcde"].GetValueAsString());
+  }
+
+  // a damaged profile falls back to lazy loading
+  {
+    std::ofstream out_stream(profile_file_name, std::ios::binary);
+    out_stream.write(PAGE_ACCESS_PROFILE_MAGIC, PAGE_ACCESS_PROFILE_MAGIC_LEN);
+    out_stream.write("\xff\xff", 2);
+  }
+
+  {
+    Dictionary d(dictionary.GetFileName(), loading_strategy_types::lazy_access_profile);
+    BOOST_CHECK(d.Contains("abbcd"));
+  }
+
+  std::remove(profile_file_name.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,213 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * page_cache_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <fstream>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/fsa/internal/page_cache.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+BOOST_AUTO_TEST_SUITE(PageCacheTests)
+
+class TempFile final {
+ public:
+  explicit TempFile(const std::string& content) {
+    file_name_ = (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+    std::ofstream out(file_name_, std::ios::binary);
+    out.write(content.data(), content.size());
+  }
+
+  ~TempFile() { boost::filesystem::remove(file_name_); }
+
+  const std::string& GetFileName() const { return file_name_; }
+
+ private:
+  std::string file_name_;
+};
+
+std::string MakeContent(size_t size) {
+  std::string content(size, 0);
+  for (size_t i = 0; i < size; ++i) {
+    content[i] = static_cast<char>('a' + (i * 7 % 26));
+  }
+  return content;
+}
+
+BOOST_AUTO_TEST_CASE(ReadAcrossPages) {
+  const std::string content = MakeContent(5 * PAGE_CACHE_PAGE_SIZE + 123);
+  TempFile file(content);
+
+  // capacity for 1 page per shard
+  PageCache cache(file.GetFileName(), 0);
+  BOOST_CHECK_EQUAL(content.size(), cache.GetFileSize());
+  BOOST_CHECK_EQUAL(PAGE_CACHE_NUMBER_OF_SHARDS * PAGE_CACHE_PAGE_SIZE, cache.GetCapacity());
+
+  std::string buffer(3 * PAGE_CACHE_PAGE_SIZE, 0);
+  cache.Read(PAGE_CACHE_PAGE_SIZE - 10, buffer.size(), &buffer[0]);
+  BOOST_CHECK(content.substr(PAGE_CACHE_PAGE_SIZE - 10, buffer.size()) == buffer);
+  BOOST_CHECK_EQUAL(4, cache.GetMisses());
+
+  cache.Read(PAGE_CACHE_PAGE_SIZE, 10, &buffer[0]);
+  BOOST_CHECK_EQUAL(1, cache.GetHits());
+
+  // tail of the file
+  cache.Read(content.size() - 100, 100, &buffer[0]);
+  BOOST_CHECK(content.substr(content.size() - 100) == buffer.substr(0, 100));
+
+  cache.ReadUncached(17, 2 * PAGE_CACHE_PAGE_SIZE, &buffer[0]);
+  BOOST_CHECK(content.substr(17, 2 * PAGE_CACHE_PAGE_SIZE) == buffer.substr(0, 2 * PAGE_CACHE_PAGE_SIZE));
+
+  BOOST_CHECK_THROW(cache.Read(content.size() - 10, 11, &buffer[0]), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction) {
+  const size_t number_of_pages = 4 * PAGE_CACHE_NUMBER_OF_SHARDS;
+  const std::string content = MakeContent(number_of_pages * PAGE_CACHE_PAGE_SIZE);
+  TempFile file(content);
+
+  PageCache cache(file.GetFileName(), 0);
+
+  char c;
+  for (size_t i = 0; i < number_of_pages; ++i) {
+    cache.Read(i * PAGE_CACHE_PAGE_SIZE, 1, &c);
+    BOOST_CHECK_EQUAL(content[i * PAGE_CACHE_PAGE_SIZE], c);
+  }
+
+  // only the last page per shard survived
+  cache.Read(0, 1, &c);
+  cache.Read((number_of_pages - 1) * PAGE_CACHE_PAGE_SIZE, 1, &c);
+  BOOST_CHECK_EQUAL(number_of_pages + 1, cache.GetMisses());
+  BOOST_CHECK_EQUAL(1, cache.GetHits());
+}
+
+BOOST_AUTO_TEST_CASE(ReadStrings) {
+  std::string content = MakeContent(PAGE_CACHE_PAGE_SIZE - 5);
+  content.push_back(0);
+  const std::string long_string = MakeContent(200);
+  // varint encoded length of 200
+  content.push_back(static_cast<char>((200 & 127) | 128));
+  content.push_back(static_cast<char>(200 >> 7));
+  content.append(long_string);
+  content.push_back(3);
+  content.append("abc");
+  content.append("xyz");
+  TempFile file(content);
+
+  PageCache cache(file.GetFileName(), 1024 * 1024);
+
+  BOOST_CHECK(content.substr(0, PAGE_CACHE_PAGE_SIZE - 5) == cache.ReadZeroTerminatedString(0));
+  BOOST_CHECK_EQUAL("xyz", cache.ReadZeroTerminatedString(content.size() - 3));
+  BOOST_CHECK(long_string == cache.ReadVarIntString(PAGE_CACHE_PAGE_SIZE - 4));
+  BOOST_CHECK_EQUAL("abc", cache.ReadVarIntString(PAGE_CACHE_PAGE_SIZE - 4 + 202));
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentReads) {
+  const std::string content = MakeContent(64 * PAGE_CACHE_PAGE_SIZE);
+  TempFile file(content);
+
+  PageCache cache(file.GetFileName(), 8 * PAGE_CACHE_NUMBER_OF_SHARDS * PAGE_CACHE_PAGE_SIZE);
+  std::vector<std::thread> threads;
+  std::vector<size_t> errors(4, 0);
+
+  for (size_t t = 0; t < errors.size(); ++t) {
+    threads.emplace_back([&, t]() {
+      std::string buffer(1000, 0);
+      for (size_t i = 0; i < 2000; ++i) {
+        const size_t offset = (i * 7919 + t * 104729) % (content.size() - buffer.size());
+        cache.Read(offset, buffer.size(), &buffer[0]);
+        if (content.compare(offset, buffer.size(), buffer) != 0) {
+          ++errors[t];
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const size_t e : errors) {
+    BOOST_CHECK_EQUAL(0, e);
+  }
+}
+
+void CheckPreadLoading(loading_strategy_types strategy) {
+  std::vector<std::pair<std::string, std::string>> test_data = {
+      {"abc", "{\"a\":1}"}, {"abbc", "{\"b\":2}"}, {"abbcd", "{\"c\":3}"}, {"abcde", "{\"a\":1}"}, {"abdd", "{}"}};
+
+  testing::TempDictionary dictionary = testing::TempDictionary::makeTempDictionaryFromJson(&test_data);
+  Dictionary d(dictionary.GetFileName(), strategy, {{PAGE_CACHE_SIZE_KEY, "1"}});
+
+  BOOST_CHECK(d.Contains("abc"));
+  BOOST_CHECK(!d.Contains("abd"));
+  BOOST_CHECK_EQUAL("{\"c\":3}", d["abbcd"].GetValueAsString());
+  BOOST_CHECK_EQUAL("{}", d["abdd"].GetValueAsString());
+
+  size_t count = 0;
+  for (auto m : d.GetPrefixCompletion("ab")) {
+    ++count;
+  }
+  BOOST_CHECK_EQUAL(5, count);
+
+  std::vector<std::pair<std::string, std::string>> string_data = {{"abc", "x"}, {"abd", "yy"}, {"bcd", "zzz"}};
+  testing::TempDictionary string_dictionary(&string_data);
+  Dictionary d2(string_dictionary.GetFileName(), strategy);
+
+  BOOST_CHECK_EQUAL("yy", d2["abd"].GetValueAsString());
+  BOOST_CHECK_EQUAL("zzz", d2["bcd"].GetValueAsString());
+
+  std::vector<std::pair<std::string, std::vector<float>>> float_data = {{"abc", {1.0f, 2.5f}}, {"abd", {3.0f, 4.0f}}};
+  testing::TempDictionary float_dictionary = testing::TempDictionary::makeTempDictionaryFromFloats(&float_data);
+  Dictionary d3(float_dictionary.GetFileName(), strategy);
+
+  Dictionary d4(float_dictionary.GetFileName(), loading_strategy_types::lazy);
+
+  BOOST_CHECK_EQUAL(d4["abd"].GetValueAsString(), d3["abd"].GetValueAsString());
+  BOOST_CHECK_EQUAL(d4["abc"].GetValueAsString(), d3["abc"].GetValueAsString());
+}
+
+BOOST_AUTO_TEST_CASE(LoadingStrategies) {
+  CheckPreadLoading(loading_strategy_types::pread_value_part);
+  CheckPreadLoading(loading_strategy_types::pread);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
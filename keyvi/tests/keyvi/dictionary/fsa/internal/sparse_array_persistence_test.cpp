@@ -55,27 +55,41 @@ BOOST_AUTO_TEST_CASE(basic) {
   BOOST_CHECK_EQUAL(p.ReadTransitionLabel(200), 44);
   BOOST_CHECK_EQUAL(p.ReadTransitionValue(200), 45);
 }
-/*
-BOOST_AUTO_TEST_CASE( bruteforcewriteandread )
-{
+
+BOOST_AUTO_TEST_CASE(writeandreadacrossflushes) {
   size_t memoryLimit = 1024 * 10;
 
-  SparseArrayPersistence p(memoryLimit, boost::filesystem::temp_directory_path());
-  for (int i = 0; i < 20 * memoryLimit; ++i){
-    if (i%200 == 0){
+  SparseArrayPersistence<> p(memoryLimit, boost::filesystem::temp_directory_path());
+  for (size_t i = 0; i < 20 * memoryLimit; ++i) {
+    if (i % 200 == 0) {
       // simulate new state
       p.BeginNewState(i);
     }
 
     p.WriteTransition(i, i % 256, i % 10000);
+
+    // read back from the in-memory buffer, the window that is being flushed and external memory
+    BOOST_CHECK_EQUAL(p.ReadTransitionLabel(i / 2), (i / 2) % 256);
+    BOOST_CHECK_EQUAL(p.ReadTransitionValue(i / 2), (i / 2) % 10000);
   }
 
-  for (int i = 0; i < 20 * memoryLimit; ++i){
-      BOOST_CHECK_EQUAL(p.ReadTransitionLabel(i), i%256);
-      BOOST_CHECK_EQUAL(p.ReadTransitionValue(i), i%10000);
-    }
+  // write below the in-memory buffer, the flushed window gets written directly
+  p.WriteTransition(20 * memoryLimit + 1, 1, 1);
+  p.BeginNewState(30 * memoryLimit);
+  p.WriteTransition(20 * memoryLimit + 1, 42, 43);
+  BOOST_CHECK_EQUAL(p.ReadTransitionLabel(20 * memoryLimit + 1), 42);
+  BOOST_CHECK_EQUAL(p.ReadTransitionValue(20 * memoryLimit + 1), 43);
+
+  p.Flush();
+
+  for (size_t i = 0; i < 20 * memoryLimit; ++i) {
+    BOOST_CHECK_EQUAL(p.ReadTransitionLabel(i), i % 256);
+    BOOST_CHECK_EQUAL(p.ReadTransitionValue(i), i % 10000);
+  }
+  BOOST_CHECK_EQUAL(p.ReadTransitionLabel(20 * memoryLimit + 1), 42);
+  BOOST_CHECK_EQUAL(p.ReadTransitionValue(20 * memoryLimit + 1), 43);
 }
-*/
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace internal */
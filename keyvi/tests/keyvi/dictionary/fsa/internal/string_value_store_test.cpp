@@ -23,6 +23,8 @@
  *      Author: hendrik
  */
 
+#include <string>
+
 #include <boost/filesystem.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -52,6 +54,26 @@ BOOST_AUTO_TEST_CASE(minimization) {
   BOOST_CHECK_EQUAL(w, strings.AddValue("othervalue", &no_minimization));
 }
 
+BOOST_AUTO_TEST_CASE(deduplicationStatistics) {
+  StringValueStore strings(keyvi::util::parameters_t{{"dedup_memory_limit_mb", "10"}});
+
+  bool no_minimization = false;
+  for (size_t i = 0; i < 100; ++i) {
+    strings.AddValue("value-" + std::to_string(i % 60), &no_minimization);
+  }
+
+  ValueDeduplicationStatistics statistics = strings.GetDeduplicationStatistics();
+  BOOST_CHECK_EQUAL(100, statistics.lookups);
+  BOOST_CHECK_EQUAL(40, statistics.hits);
+  BOOST_CHECK_CLOSE(0.4, statistics.GetHitRate(), 0.001);
+  BOOST_CHECK_EQUAL(10 * 1024 * 1024, statistics.memory_limit);
+  BOOST_CHECK(statistics.peak_memory_usage > 0);
+  BOOST_CHECK(statistics.peak_memory_usage <= statistics.memory_limit);
+
+  strings.CloseFeeding();
+  BOOST_CHECK_EQUAL(statistics.peak_memory_usage, strings.GetDeduplicationStatistics().peak_memory_usage);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } /* namespace internal */
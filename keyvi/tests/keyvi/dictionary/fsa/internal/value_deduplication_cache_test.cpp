@@ -0,0 +1,105 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * value_deduplication_cache_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/fsa/internal/value_deduplication_cache.h"
+#include "keyvi/util/configuration.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+namespace {
+// compares against the value itself instead of a persistence
+class ValueForCompare final {
+ public:
+  explicit ValueForCompare(const std::string& value)
+      : value_(value), hashcode_(GetValueHashcode(value.data(), value.size())) {}
+
+  int32_t GetHashcode() const { return hashcode_; }
+
+  bool operator==(const RawPointer<>& l) const {
+    return l.GetHashcode() == hashcode_ && l.GetLength() == value_.size();
+  }
+
+ private:
+  std::string value_;
+  int32_t hashcode_;
+};
+}  // namespace
+
+BOOST_AUTO_TEST_SUITE(ValueDeduplicationCacheTests)
+
+BOOST_AUTO_TEST_CASE(Crc32c) {
+  // check value of CRC-32C
+  const std::string value = "123456789";
+  BOOST_CHECK_EQUAL(0xE3069283, internal::Crc32c(value.data(), value.size()));
+
+  BOOST_CHECK_EQUAL(0, internal::Crc32c("", 0));
+
+  // 8 byte blocks and a tail
+  const std::string long_value = "The quick brown fox jumps over the lazy dog";
+  BOOST_CHECK_EQUAL(0x22620404, internal::Crc32c(long_value.data(), long_value.size()));
+}
+
+BOOST_AUTO_TEST_CASE(MemoryLimit) {
+  BOOST_CHECK_EQUAL(DEFAULT_MEMORY_LIMIT_VALUE_STORE, ValueDeduplicationCache::GetMemoryLimit({}));
+  BOOST_CHECK_EQUAL(20 * 1024 * 1024, ValueDeduplicationCache::GetMemoryLimit({{MEMORY_LIMIT_KEY, "20971520"}}));
+  BOOST_CHECK_EQUAL(
+      5 * 1024 * 1024,
+      ValueDeduplicationCache::GetMemoryLimit({{MEMORY_LIMIT_KEY, "20971520"}, {"dedup_memory_limit_mb", "5"}}));
+}
+
+BOOST_AUTO_TEST_CASE(Statistics) {
+  ValueDeduplicationCache cache(keyvi::util::parameters_t{{"dedup_memory_limit_mb", "1"}});
+
+  for (size_t i = 0; i < 1000; ++i) {
+    const std::string value = "value-" + std::to_string(i % 500);
+    ValueForCompare compare(value);
+
+    if (cache.Get(compare).IsEmpty()) {
+      cache.Add(RawPointer<>(i + 1, compare.GetHashcode(), value.size()));
+    }
+  }
+
+  ValueDeduplicationStatistics statistics = cache.GetStatistics();
+  BOOST_CHECK_EQUAL(1000, statistics.lookups);
+  BOOST_CHECK_EQUAL(500, statistics.hits);
+  BOOST_CHECK_CLOSE(0.5, statistics.GetHitRate(), 0.001);
+  BOOST_CHECK_EQUAL(1024 * 1024, statistics.memory_limit);
+  BOOST_CHECK(statistics.peak_memory_usage > 0);
+  BOOST_CHECK(statistics.peak_memory_usage <= statistics.memory_limit);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
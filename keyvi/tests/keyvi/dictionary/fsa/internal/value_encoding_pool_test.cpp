@@ -0,0 +1,95 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * value_encoding_pool_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/fsa/internal/float_vector_value_store.h"
+#include "keyvi/dictionary/fsa/internal/json_value_store.h"
+#include "keyvi/dictionary/fsa/internal/value_encoding_pool.h"
+#include "keyvi/util/configuration.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+namespace internal {
+
+BOOST_AUTO_TEST_SUITE(ValueEncodingPoolTests)
+
+BOOST_AUTO_TEST_CASE(SameAsSequential) {
+  JsonValueStore sequential_store;
+  JsonValueStore parallel_store;
+  ValueEncodingPool<JsonValueStore> pool(&parallel_store, 3);
+
+  std::vector<std::string> values;
+  for (size_t i = 0; i < 1000; ++i) {
+    values.push_back("{\"id\":" + std::to_string(i % 77) + "}");
+  }
+
+  // several batches, not a multiple of the block size
+  for (size_t batch = 0; batch < 3; ++batch) {
+    std::vector<std::string> batch_values(values.begin(), values.begin() + 300 + batch * 31);
+    size_t expected_index = 0;
+
+    pool.AddValues(batch_values, [&](size_t i, uint64_t value_idx, bool no_minimization) {
+      BOOST_CHECK_EQUAL(expected_index++, i);
+
+      bool sequential_no_minimization = false;
+      BOOST_CHECK_EQUAL(sequential_store.AddValue(batch_values[i], &sequential_no_minimization), value_idx);
+      BOOST_CHECK_EQUAL(sequential_no_minimization, no_minimization);
+    });
+
+    BOOST_CHECK_EQUAL(batch_values.size(), expected_index);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(EncodingError) {
+  FloatVectorValueStore store(keyvi::util::parameters_t({{VECTOR_SIZE_KEY, "2"}}));
+  ValueEncodingPool<FloatVectorValueStore> pool(&store, 2);
+
+  std::vector<std::vector<float>> values(200, {1.0, 2.0});
+  values[150] = {1.0};
+  size_t added = 0;
+
+  BOOST_CHECK_THROW(pool.AddValues(values, [&](size_t i, uint64_t value_idx, bool no_minimization) { ++added; }),
+                    std::invalid_argument);
+  BOOST_CHECK_EQUAL(150, added);
+
+  // the pool can be used again
+  values[150] = {1.0, 2.0};
+  added = 0;
+  pool.AddValues(values, [&](size_t i, uint64_t value_idx, bool no_minimization) { ++added; });
+  BOOST_CHECK_EQUAL(200, added);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace internal */
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,129 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * segment_loser_tree_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/fsa/segment_loser_tree.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace fsa {
+
+BOOST_AUTO_TEST_SUITE(SegmentLoserTreeTests)
+
+BOOST_AUTO_TEST_CASE(NoSegments) {
+  SegmentLoserTree tree({});
+  BOOST_CHECK(tree.Empty());
+}
+
+BOOST_AUTO_TEST_CASE(EmptySegments) {
+  std::vector<std::string> test_data = {};
+  testing::TempDictionary dictionary(&test_data);
+
+  SegmentLoserTree tree({EntryIterator(dictionary.GetFsa()), EntryIterator(dictionary.GetFsa())});
+  BOOST_CHECK(tree.Empty());
+}
+
+BOOST_AUTO_TEST_CASE(Merge) {
+  std::vector<std::vector<std::string>> test_data = {
+      {"aaa", "aaaa", "aabc", "cdef", "ef", "prefix_prefix_1"},
+      {"bbb", "bcd", "cdag", "effffff", "prefix_prefix", "prefix_prefix_2"},
+      {},
+      {"aaa", "cdef", "prefix_prefix_1", "zzz"},
+      {"a", "ef", "prefix_prefix_0"}};
+
+  std::vector<std::unique_ptr<testing::TempDictionary>> dictionaries;
+  std::vector<EntryIterator> segments;
+  std::vector<std::pair<std::string, size_t>> expected;
+
+  for (size_t i = 0; i < test_data.size(); ++i) {
+    dictionaries.emplace_back(new testing::TempDictionary(&test_data[i]));
+    segments.emplace_back(dictionaries.back()->GetFsa());
+
+    for (const std::string& key : test_data[i]) {
+      expected.emplace_back(key, i);
+    }
+  }
+
+  // equal keys: the segment with the higher index comes first
+  std::sort(expected.begin(), expected.end(),
+            [](const std::pair<std::string, size_t>& a, const std::pair<std::string, size_t>& b) {
+              return a.first == b.first ? a.second > b.second : a.first < b.first;
+            });
+
+  SegmentLoserTree tree(segments);
+
+  for (const auto& key_segment : expected) {
+    BOOST_REQUIRE(!tree.Empty());
+    BOOST_CHECK_EQUAL(key_segment.first, tree.Top().GetKey());
+    BOOST_CHECK_EQUAL(key_segment.second, tree.TopSegment());
+    tree.Next();
+  }
+
+  BOOST_CHECK(tree.Empty());
+}
+
+BOOST_AUTO_TEST_CASE(ManySegments) {
+  const size_t number_of_segments = 13;
+  std::vector<std::vector<std::string>> test_data(number_of_segments);
+
+  for (size_t i = 0; i < 1000; ++i) {
+    test_data[(i * 7) % number_of_segments].push_back("key-" + std::to_string(i));
+  }
+
+  std::vector<std::unique_ptr<testing::TempDictionary>> dictionaries;
+  std::vector<EntryIterator> segments;
+  std::vector<std::string> expected;
+
+  for (auto& keys : test_data) {
+    dictionaries.emplace_back(new testing::TempDictionary(&keys));
+    segments.emplace_back(dictionaries.back()->GetFsa());
+    expected.insert(expected.end(), keys.begin(), keys.end());
+  }
+  std::sort(expected.begin(), expected.end());
+
+  SegmentLoserTree tree(segments);
+
+  for (const std::string& key : expected) {
+    BOOST_REQUIRE(!tree.Empty());
+    BOOST_CHECK_EQUAL(key, tree.Top().GetKey());
+    tree.Next();
+  }
+
+  BOOST_CHECK(tree.Empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace fsa */
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,231 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * normalized_matching_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/matching/normalized_matching.h"
+#include "keyvi/dictionary/util/normalization_transducer.h"
+#include "keyvi/stringdistance/levenshtein.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace matching {
+
+BOOST_AUTO_TEST_SUITE(NormalizedMatchingTests)
+
+std::vector<std::string> Collect(MatchIterator::MatchIteratorPair matches) {
+  std::vector<std::string> result;
+  for (auto m : matches) {
+    result.push_back(m.GetMatchedString());
+  }
+  return result;
+}
+
+util::normalization_transducer_t CaseAndDiacritics() {
+  auto normalization = std::make_shared<util::NormalizationTransducer>();
+  normalization->AddCaseFolding();
+  normalization->AddDiacriticStripping();
+  return normalization;
+}
+
+BOOST_AUTO_TEST_CASE(Get) {
+  std::vector<std::pair<std::string, uint32_t>> test_data = {
+      {"Koln", 1}, {"Köln", 2}, {"KÖLN", 3}, {"Kolner", 4}, {"Straße", 5}, {"strasse", 6}, {"Strasbourg", 7},
+  };
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+  util::normalization_transducer_t normalization = CaseAndDiacritics();
+
+  BOOST_CHECK((std::vector<std::string>{"Koln", "KÖLN", "Köln"}) ==
+              Collect(d->GetNormalized("köln", normalization)));
+  BOOST_CHECK((std::vector<std::string>{"Straße", "strasse"}) == Collect(d->GetNormalized("STRASSE", normalization)));
+  BOOST_CHECK(Collect(d->GetNormalized("Kol", normalization)).empty());
+
+  BOOST_CHECK(d->ContainsNormalized("kolner", normalization));
+  BOOST_CHECK(d->ContainsNormalized("straße", normalization));
+  BOOST_CHECK(!d->ContainsNormalized("strass", normalization));
+  BOOST_CHECK(!d->ContainsNormalized("kolnerin", normalization));
+
+  // matches are returned in byte order of the original keys, with their values
+  auto matches = d->GetNormalized("KÖLN", normalization);
+  auto it = matches.begin();
+  BOOST_CHECK_EQUAL("Koln", it->GetMatchedString());
+  BOOST_CHECK_EQUAL("1", it->GetValueAsString());
+  BOOST_CHECK_EQUAL(0, it->GetScore());
+}
+
+BOOST_AUTO_TEST_CASE(PrefixCompletion) {
+  std::vector<std::pair<std::string, uint32_t>> test_data = {
+      {"Koln", 1}, {"Köln", 2}, {"KÖLN", 3}, {"Kolner", 4}, {"Straße", 5}, {"strasse", 6}, {"Strasbourg", 7},
+  };
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+  util::normalization_transducer_t normalization = CaseAndDiacritics();
+
+  BOOST_CHECK((std::vector<std::string>{"Koln", "Kolner", "KÖLN", "Köln"}) ==
+              Collect(d->GetNormalizedPrefixCompletion("KÖL", normalization)));
+  BOOST_CHECK((std::vector<std::string>{"Strasbourg", "Straße", "strasse"}) ==
+              Collect(d->GetNormalizedPrefixCompletion("stras", normalization)));
+  // the prefix ends within the expansion of 'ß'
+  BOOST_CHECK((std::vector<std::string>{"Straße", "strasse"}) ==
+              Collect(d->GetNormalizedPrefixCompletion("strass", normalization)));
+  BOOST_CHECK_EQUAL(7, Collect(d->GetNormalizedPrefixCompletion("", normalization)).size());
+  BOOST_CHECK(Collect(d->GetNormalizedPrefixCompletion("x", normalization)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(Fuzzy) {
+  std::vector<std::pair<std::string, uint32_t>> test_data = {
+      {"Koln", 1}, {"Köln", 2}, {"KÖLN", 3}, {"Kolner", 4}, {"Straße", 5}, {"strasse", 6}, {"Strasbourg", 7},
+  };
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+  util::normalization_transducer_t normalization = CaseAndDiacritics();
+
+  BOOST_CHECK((std::vector<std::string>{"Koln", "KÖLN", "Köln"}) ==
+              Collect(d->GetNormalizedFuzzy("kloen", normalization, 2)));
+  BOOST_CHECK((std::vector<std::string>{"Koln", "Kolner", "KÖLN", "Köln"}) ==
+              Collect(d->GetNormalizedFuzzy("kolne", normalization, 1)));
+  BOOST_CHECK((std::vector<std::string>{"Straße", "strasse"}) ==
+              Collect(d->GetNormalizedFuzzy("STRAẞE", normalization, 1)));
+}
+
+BOOST_AUTO_TEST_CASE(FuzzyPrefixCompletionScore) {
+  std::vector<std::pair<std::string, uint32_t>> test_data = {{"abc", 1}, {"abcdef", 2}, {"abx", 3}, {"xbcd", 4}};
+
+  testing::TempDictionary dictionary(&test_data);
+  util::normalization_transducer_t normalization = CaseAndDiacritics();
+
+  // the score is the minimum over all prefixes, not the score of the first prefix within the edit distance
+  auto matcher = NormalizedMatching<>::FromSingleFsa(dictionary.GetFsa(), "ABC", normalization, 1, true);
+  std::vector<std::pair<std::string, int32_t>> matches;
+  for (Match m = matcher.NextMatch(); !m.IsEmpty(); m = matcher.NextMatch()) {
+    matches.emplace_back(m.GetMatchedString(), m.GetScore());
+  }
+
+  const std::vector<std::pair<std::string, int32_t>> expected = {{"abc", 0}, {"abcdef", 0}, {"abx", 1}, {"xbcd", 1}};
+  BOOST_CHECK(expected == matches);
+}
+
+BOOST_AUTO_TEST_CASE(CompareWithNormalizedKeys) {
+  std::vector<std::string> keys = {"abc",    "Abc",   "ÁBC",  "abd",  "abcd",    "ábcde", "bcd",  "Straße",
+                                   "strase", "ssa",   "sa",   "ßa",   "strasse", "STRASSE", "ǅ",  "café",
+                                   "CAFE",   "cafes", "cofe", "łódź", "Lodz",    "lodzianin"};
+  // e followed by a combining acute accent
+  keys.push_back("cafe\xcc\x81");
+
+  std::vector<std::string> queries = {"abc", "ABC", "ab",   "a",    "strasse", "STRAẞE",
+                                      "ss",  "s",   "cafe", "Café", "lodz",    ""};
+
+  std::vector<std::pair<std::string, uint32_t>> test_data;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    test_data.emplace_back(keys[i], i);
+  }
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+  util::normalization_transducer_t normalization = CaseAndDiacritics();
+
+  std::sort(keys.begin(), keys.end());
+
+  for (const std::string& query : queries) {
+    const std::vector<uint32_t> normalized_query = normalization->Normalize(query);
+
+    for (int32_t max_edit_distance = 0; max_edit_distance < 3; ++max_edit_distance) {
+      std::vector<std::string> expected;
+      for (const std::string& key : keys) {
+        const std::vector<uint32_t> normalized_key = normalization->Normalize(key);
+        const size_t length_difference = normalized_key.size() > normalized_query.size()
+                                             ? normalized_key.size() - normalized_query.size()
+                                             : normalized_query.size() - normalized_key.size();
+        if (length_difference > static_cast<size_t>(max_edit_distance)) {
+          continue;
+        }
+
+        stringdistance::Levenshtein metric(normalized_query, 20, max_edit_distance);
+        int32_t score = normalized_query.size();
+        for (size_t i = 0; i < normalized_key.size(); ++i) {
+          metric.Put(normalized_key[i], i);
+          score = metric.GetScore();
+        }
+
+        if (score <= max_edit_distance) {
+          expected.push_back(key);
+        }
+      }
+
+      BOOST_CHECK_MESSAGE(expected == Collect(d->GetNormalizedFuzzy(query, normalization, max_edit_distance)),
+                          "fuzzy " << query << " " << max_edit_distance);
+    }
+
+    std::vector<std::string> expected_exact;
+    std::vector<std::string> expected_prefix;
+    for (const std::string& key : keys) {
+      const std::vector<uint32_t> normalized_key = normalization->Normalize(key);
+      if (normalized_key == normalized_query) {
+        expected_exact.push_back(key);
+      }
+      if (normalized_key.size() >= normalized_query.size() &&
+          std::equal(normalized_query.begin(), normalized_query.end(), normalized_key.begin())) {
+        expected_prefix.push_back(key);
+      }
+    }
+
+    BOOST_CHECK_MESSAGE(expected_exact == Collect(d->GetNormalized(query, normalization)), "exact " << query);
+    BOOST_CHECK_MESSAGE(expected_prefix == Collect(d->GetNormalizedPrefixCompletion(query, normalization)),
+                        "prefix " << query);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Budget) {
+  std::vector<std::pair<std::string, uint32_t>> test_data;
+  for (size_t i = 0; i < 1000; ++i) {
+    test_data.emplace_back("Key" + std::to_string(i), i);
+  }
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  auto budget = std::make_shared<util::TraversalBudget>(10);
+  BOOST_CHECK(Collect(d->GetNormalizedPrefixCompletion("key", CaseAndDiacritics(), budget)).size() < 1000);
+  BOOST_CHECK(budget->IsTruncated());
+
+  BOOST_CHECK_EQUAL(1000, Collect(d->GetNormalizedPrefixCompletion("KEY", CaseAndDiacritics())).size());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace matching */
+} /* namespace dictionary */
+} /* namespace keyvi */
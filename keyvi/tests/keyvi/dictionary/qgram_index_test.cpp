@@ -0,0 +1,177 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * qgram_index_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/dictionary.h"
+#include "keyvi/dictionary/qgram_index.h"
+#include "keyvi/dictionary/qgram_index_compiler.h"
+#include "keyvi/testing/temp_dictionary.h"
+
+namespace keyvi {
+namespace dictionary {
+
+BOOST_AUTO_TEST_SUITE(QGramIndexTests)
+
+std::vector<std::string> Collect(MatchIterator::MatchIteratorPair matches) {
+  std::vector<std::string> keys;
+  for (auto m : matches) {
+    keys.push_back(m.GetMatchedString());
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+BOOST_AUTO_TEST_CASE(FuzzyMatching) {
+  std::vector<std::string> test_data = {"hauptstrasse 12 berlin",
+                                        "hauptstrase 12 berlin",
+                                        "hauptstrasse 21 berlin",
+                                        "hauptstrasse 12 bremen",
+                                        "bahnhofstrasse 1 essen",
+                                        "bahnhofstr 1 essen",
+                                        "m\xc3\xbcllerstra\xc3\x9f"
+                                        "e 3 k\xc3\xb6ln",
+                                        "muellerstrasse 3 koeln",
+                                        "abc",
+                                        "abd",
+                                        "xyz"};
+  for (size_t i = 0; i < 500; ++i) {
+    test_data.push_back("street " + std::to_string(i * 7) + " city " + std::to_string(i % 13));
+  }
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  const std::string file_name =
+      (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  QGramIndexCompiler compiler(dictionary.GetFsa(), 3);
+  compiler.Compile();
+  compiler.WriteToFile(file_name);
+
+  QGramIndex qgram_index(d, file_name);
+  BOOST_CHECK_EQUAL(3, qgram_index.GetQ());
+
+  // same result as traversal
+  for (const std::string query : {"hauptstrasse 12 berlin", "hauptsrtasse 12 berln", "bahnhofstrasse 1 esen",
+                                  "m\xc3\xbcllerstrasse 3 k\xc3\xb6ln", "street 70 city 10", "street 700 cty 9",
+                                  "nothing like this", "abc", "ab"}) {
+    for (int32_t max_edit_distance = 0; max_edit_distance <= 4; ++max_edit_distance) {
+      std::vector<std::string> expected = Collect(d->GetFuzzy(query, max_edit_distance, 0));
+      std::vector<std::string> matches = Collect(qgram_index.GetFuzzy(query, max_edit_distance));
+      BOOST_CHECK_MESSAGE(expected == matches, "query: " + query + " distance: " + std::to_string(max_edit_distance));
+    }
+  }
+
+  // matches are returned in lexicographic order with score and value
+  std::vector<std::string> keys;
+  for (auto m : qgram_index.GetFuzzy("hauptstrasse 12 berlin", 3)) {
+    keys.push_back(m.GetMatchedString());
+    if (m.GetMatchedString() == "hauptstrase 12 berlin") {
+      BOOST_CHECK_EQUAL(1, m.GetScore());
+    }
+  }
+  std::vector<std::string> expected_keys = {"hauptstrase 12 berlin", "hauptstrasse 12 berlin",
+                                            "hauptstrasse 12 bremen", "hauptstrasse 21 berlin"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(expected_keys.begin(), expected_keys.end(), keys.begin(), keys.end());
+
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(WrongDictionary) {
+  std::vector<std::string> test_data = {"aaaa", "aabb", "aabc"};
+  std::vector<std::string> other_test_data = {"aaaa", "aabb"};
+  testing::TempDictionary dictionary(&test_data);
+  testing::TempDictionary other_dictionary(&other_test_data);
+
+  const std::string file_name =
+      (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  QGramIndexCompiler compiler(dictionary.GetFsa());
+  compiler.Compile();
+  compiler.WriteToFile(file_name);
+
+  dictionary_t other(new Dictionary(other_dictionary.GetFsa()));
+  BOOST_CHECK_THROW(QGramIndex(other, file_name), std::invalid_argument);
+
+  // not a q-gram index
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+  BOOST_CHECK_THROW(QGramIndex(d, d), std::invalid_argument);
+
+  BOOST_CHECK_THROW(QGramIndexCompiler(dictionary.GetFsa(), 1), std::invalid_argument);
+  BOOST_CHECK_THROW(QGramIndexCompiler(dictionary.GetFsa(), 3, {{MEMORY_LIMIT_KEY, "1048576"}}), compiler_exception);
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(PartialPostings) {
+  std::vector<std::string> test_data;
+  for (size_t i = 0; i < 60000; ++i) {
+    test_data.push_back("street " + std::to_string(i * 7) + " city " + std::to_string(i % 101));
+  }
+
+  testing::TempDictionary dictionary(&test_data);
+  dictionary_t d(new Dictionary(dictionary.GetFsa()));
+
+  QGramIndexCompiler compiler(dictionary.GetFsa(), 3);
+  compiler.Compile();
+  std::stringstream stream;
+  compiler.Write(stream);
+  const std::string buffer = stream.str();
+  Dictionary qgrams(std::make_shared<fsa::Automata>(buffer.data(), buffer.size()));
+
+  // postings exceed the memory limit and get merged from partial postings
+  const std::string file_name =
+      (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path()).string();
+  QGramIndexCompiler limited_compiler(dictionary.GetFsa(), 3, {{MEMORY_LIMIT_KEY, std::to_string(2 * 1024 * 1024)}});
+  limited_compiler.Compile();
+  limited_compiler.WriteToFile(file_name);
+  dictionary_t limited_qgrams(new Dictionary(file_name));
+
+  BOOST_CHECK_EQUAL(qgrams.GetSize(), limited_qgrams->GetSize());
+  for (auto m : qgrams.GetAllItems()) {
+    BOOST_CHECK(m.GetValueAsString() == (*limited_qgrams)[m.GetMatchedString()].GetValueAsString());
+  }
+
+  QGramIndex qgram_index(d, limited_qgrams);
+  for (const std::string query : {"street 700 cty 9", "stret 4207 city 2", "street 419993 city 99"}) {
+    std::vector<std::string> expected = Collect(d->GetFuzzy(query, 2, 0));
+    std::vector<std::string> matches = Collect(qgram_index.GetFuzzy(query, 2));
+    BOOST_CHECK_MESSAGE(expected == matches, "query: " + query);
+  }
+
+  std::remove(file_name.c_str());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,89 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * key_arena_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/util/key_arena.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(KeyArenaTests)
+
+BOOST_AUTO_TEST_CASE(AppendAndGet) {
+  KeyArena arena(1024);
+  std::vector<std::string> keys;
+  std::vector<const char*> references;
+
+  for (size_t i = 0; i < 1000; ++i) {
+    keys.push_back("key" + std::to_string(i) + std::string(i % 300, 'x'));
+    references.push_back(arena.Append(keys.back()));
+  }
+
+  // large keys get their own block
+  keys.push_back(std::string(5000, 'y'));
+  references.push_back(arena.Append(keys.back()));
+  keys.push_back("");
+  references.push_back(arena.Append(keys.back()));
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    BOOST_CHECK_EQUAL(keys[i], std::string(KeyArena::GetKey(references[i])));
+  }
+
+  BOOST_CHECK(arena.GetAllocatedBytes() >= 5000 + 1000 * 4);
+  arena.Clear();
+  BOOST_CHECK_EQUAL(0, arena.GetAllocatedBytes());
+}
+
+BOOST_AUTO_TEST_CASE(Move) {
+  KeyArena arena(1024);
+  const char* reference = arena.Append("abc");
+
+  KeyArena moved(std::move(arena));
+  BOOST_CHECK_EQUAL("abc", std::string(KeyArena::GetKey(reference)));
+  BOOST_CHECK_EQUAL(1024, moved.GetAllocatedBytes());
+  BOOST_CHECK_EQUAL(0, arena.GetAllocatedBytes());
+
+  // the moved from arena starts over with a new block
+  const char* other_reference = arena.Append("def");
+  BOOST_CHECK_EQUAL("def", std::string(KeyArena::GetKey(other_reference)));
+  BOOST_CHECK_EQUAL("abc", std::string(KeyArena::GetKey(reference)));
+}
+
+BOOST_AUTO_TEST_CASE(EncodedSize) {
+  BOOST_CHECK_EQUAL(1, KeyArena::GetEncodedSize(""));
+  BOOST_CHECK_EQUAL(4, KeyArena::GetEncodedSize("abc"));
+  BOOST_CHECK_EQUAL(202, KeyArena::GetEncodedSize(std::string(200, 'a')));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
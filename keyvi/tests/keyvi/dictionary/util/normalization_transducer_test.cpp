@@ -0,0 +1,115 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * normalization_transducer_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/util/normalization_transducer.h"
+#include "utf8.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(NormalizationTransducerTests)
+
+std::string Normalize(const NormalizationTransducer& normalization, const std::string& input) {
+  std::vector<uint32_t> normalized = normalization.Normalize(input);
+  std::string output;
+  utf8::unchecked::utf32to8(normalized.begin(), normalized.end(), std::back_inserter(output));
+  return output;
+}
+
+BOOST_AUTO_TEST_CASE(Identity) {
+  NormalizationTransducer normalization;
+  BOOST_CHECK_EQUAL("Straße", Normalize(normalization, "Straße"));
+  BOOST_CHECK(normalization.Lookup('a') == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CaseFolding) {
+  NormalizationTransducer normalization;
+  normalization.AddCaseFolding();
+
+  BOOST_CHECK_EQUAL("hello world", Normalize(normalization, "Hello WORLD"));
+  BOOST_CHECK_EQUAL("ärger strasse", Normalize(normalization, "ÄRGER STRASSE"));
+  BOOST_CHECK_EQUAL("strasse", Normalize(normalization, "Straße"));
+  BOOST_CHECK_EQUAL("łódź", Normalize(normalization, "ŁÓDŹ"));
+  BOOST_CHECK_EQUAL("αθήνα", Normalize(normalization, "ΑΘήΝΑ"));
+  BOOST_CHECK_EQUAL("москва", Normalize(normalization, "МОСКВА"));
+  BOOST_CHECK_EQUAL("1 × 2", Normalize(normalization, "1 × 2"));
+}
+
+BOOST_AUTO_TEST_CASE(DiacriticStripping) {
+  NormalizationTransducer normalization;
+  normalization.AddDiacriticStripping();
+
+  BOOST_CHECK_EQUAL("Arger", Normalize(normalization, "Ärger"));
+  BOOST_CHECK_EQUAL("Lodz", Normalize(normalization, "Łódź"));
+  BOOST_CHECK_EQUAL("AEsir oeuvre", Normalize(normalization, "Æsir œuvre"));
+  // e followed by a combining acute accent
+  BOOST_CHECK_EQUAL("cafe", Normalize(normalization, "cafe\xcc\x81"));
+  BOOST_CHECK_EQUAL("Straße", Normalize(normalization, "Straße"));
+}
+
+BOOST_AUTO_TEST_CASE(Composition) {
+  NormalizationTransducer normalization;
+  normalization.AddCaseFolding();
+  normalization.AddDiacriticStripping();
+
+  BOOST_CHECK_EQUAL("arger", Normalize(normalization, "ÄRGER"));
+  BOOST_CHECK_EQUAL("aesir", Normalize(normalization, "ÆSIR"));
+
+  // a mapping added later rewrites the output of the earlier rules, it applies to 'Ö' via case folding
+  NormalizationTransducer german;
+  german.AddCaseFolding();
+  german.AddMapping("ö", "oe");
+  german.AddDiacriticStripping();
+
+  BOOST_CHECK_EQUAL("koeln", Normalize(german, "KÖLN"));
+  BOOST_CHECK_EQUAL("koeln", Normalize(german, "Köln"));
+  BOOST_CHECK_EQUAL("munchen", Normalize(german, "München"));
+}
+
+BOOST_AUTO_TEST_CASE(Mappings) {
+  NormalizationTransducer normalization;
+  normalization.AddMapping("-", " ");
+  normalization.AddMapping("'", "");
+
+  BOOST_CHECK_EQUAL("rock n roll", Normalize(normalization, "rock-n'-roll"));
+  BOOST_CHECK_EQUAL(0, normalization.Lookup('\'')->size());
+
+  BOOST_CHECK_THROW(normalization.AddMapping("ab", "c"), std::invalid_argument);
+  BOOST_CHECK_THROW(normalization.AddMapping("", "c"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,144 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * pattern_automaton_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <stdexcept>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/util/pattern_automaton.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(PatternAutomatonTests)
+
+bool Matches(PatternAutomaton* pattern, const std::string& key) {
+  int32_t state = pattern->GetStartState();
+  for (const char c : key) {
+    state = pattern->Step(state, c);
+  }
+  return pattern->IsAccepting(state);
+}
+
+BOOST_AUTO_TEST_CASE(Regex) {
+  PatternAutomaton p = PatternAutomaton::FromRegex("[a-z]{3}-\\d+");
+  BOOST_CHECK(Matches(&p, "abc-1"));
+  BOOST_CHECK(Matches(&p, "xyz-1234"));
+  BOOST_CHECK(!Matches(&p, "abc-"));
+  BOOST_CHECK(!Matches(&p, "ab-1"));
+  BOOST_CHECK(!Matches(&p, "abcd-1"));
+  BOOST_CHECK(!Matches(&p, "abc-1x"));
+
+  p = PatternAutomaton::FromRegex("^(foo|ba[rz])?x*$");
+  BOOST_CHECK(Matches(&p, ""));
+  BOOST_CHECK(Matches(&p, "foo"));
+  BOOST_CHECK(Matches(&p, "bazxxx"));
+  BOOST_CHECK(Matches(&p, "xx"));
+  BOOST_CHECK(!Matches(&p, "fooba"));
+
+  p = PatternAutomaton::FromRegex("a{2,3}b{1,}c{0,1}");
+  BOOST_CHECK(Matches(&p, "aab"));
+  BOOST_CHECK(Matches(&p, "aaabbbc"));
+  BOOST_CHECK(!Matches(&p, "ab"));
+  BOOST_CHECK(!Matches(&p, "aaaab"));
+  BOOST_CHECK(!Matches(&p, "aabcc"));
+
+  p = PatternAutomaton::FromRegex("a\\.b\\*");
+  BOOST_CHECK(Matches(&p, "a.b*"));
+  BOOST_CHECK(!Matches(&p, "axb*"));
+}
+
+BOOST_AUTO_TEST_CASE(RegexUtf8) {
+  PatternAutomaton p = PatternAutomaton::FromRegex("m.n");
+  BOOST_CHECK(Matches(&p, "man"));
+  BOOST_CHECK(Matches(&p, "m\xc3\xa4n"));
+  BOOST_CHECK(Matches(&p, "m\xe9\x94\xaen"));
+  BOOST_CHECK(!Matches(&p, "maan"));
+
+  p = PatternAutomaton::FromRegex("st[\xc3\xb6o]re+");
+  BOOST_CHECK(Matches(&p, "st\xc3\xb6re"));
+  BOOST_CHECK(Matches(&p, "storee"));
+  BOOST_CHECK(!Matches(&p, "stare"));
+
+  // quantifiers apply to the whole code point
+  p = PatternAutomaton::FromRegex("\xc3\xa4+");
+  BOOST_CHECK(Matches(&p, "\xc3\xa4\xc3\xa4"));
+  BOOST_CHECK(!Matches(&p, "\xc3\xa4\xa4"));
+
+  p = PatternAutomaton::FromRegex("[^a-c]\\D");
+  BOOST_CHECK(Matches(&p, "xy"));
+  BOOST_CHECK(Matches(&p, "\xc3\xa4y"));
+  BOOST_CHECK(!Matches(&p, "ay"));
+  BOOST_CHECK(!Matches(&p, "x1"));
+}
+
+BOOST_AUTO_TEST_CASE(Glob) {
+  PatternAutomaton p = PatternAutomaton::FromGlob("foo*bar");
+  BOOST_CHECK(Matches(&p, "foobar"));
+  BOOST_CHECK(Matches(&p, "foo-x-bar"));
+  BOOST_CHECK(!Matches(&p, "foo-x-baz"));
+
+  p = PatternAutomaton::FromGlob("file?.[ch]");
+  BOOST_CHECK(Matches(&p, "file1.c"));
+  BOOST_CHECK(Matches(&p, "file\xc3\xa4.h"));
+  BOOST_CHECK(!Matches(&p, "file1xc"));
+  BOOST_CHECK(!Matches(&p, "file12.c"));
+
+  p = PatternAutomaton::FromGlob("[!a]\\*(x)");
+  BOOST_CHECK(Matches(&p, "b*(x)"));
+  BOOST_CHECK(!Matches(&p, "a*(x)"));
+  BOOST_CHECK(!Matches(&p, "bb(x)"));
+}
+
+BOOST_AUTO_TEST_CASE(LiteralPrefix) {
+  BOOST_CHECK_EQUAL("foo", PatternAutomaton::FromGlob("foo*bar").GetLiteralPrefix());
+  BOOST_CHECK_EQUAL("ab", PatternAutomaton::FromRegex("ab(c|d)").GetLiteralPrefix());
+  BOOST_CHECK_EQUAL("abab", PatternAutomaton::FromRegex("(ab){2,}").GetLiteralPrefix());
+  BOOST_CHECK_EQUAL("", PatternAutomaton::FromRegex("a*").GetLiteralPrefix());
+  BOOST_CHECK_EQUAL("\xc3", PatternAutomaton::FromRegex("[\xc3\xa4\xc3\xb6]").GetLiteralPrefix());
+}
+
+BOOST_AUTO_TEST_CASE(InvalidPatterns) {
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("(ab"), std::invalid_argument);
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("ab)"), std::invalid_argument);
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("*a"), std::invalid_argument);
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("[a-"), std::invalid_argument);
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("a{3,2}"), std::invalid_argument);
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("a{5000}"), std::invalid_argument);
+  // every quantifier is within bounds, but nested they multiply
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("(a{1000}){1000}"), std::invalid_argument);
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("((a{100}){100}){100}"), std::invalid_argument);
+  PatternAutomaton::FromRegex("(a{10}){100}");
+  BOOST_CHECK_THROW(PatternAutomaton::FromRegex("(a)\\1"), std::invalid_argument);
+  BOOST_CHECK_THROW(PatternAutomaton::FromGlob("[ab"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,121 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/*
+ * string_radix_sort_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/util/string_radix_sort.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(StringRadixSortTests)
+
+void CheckSort(const std::vector<std::string>& keys, const size_t threads) {
+  // pair of key and insertion order, to check stability
+  std::vector<std::pair<std::string, size_t>> items;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    items.emplace_back(keys[i], i);
+  }
+
+  std::vector<std::pair<std::string, size_t>> expected = items;
+  std::stable_sort(expected.begin(), expected.end(),
+                   [](const std::pair<std::string, size_t>& a, const std::pair<std::string, size_t>& b) {
+                     return a.first < b.first;
+                   });
+
+  std::vector<size_t> lcp;
+  StringRadixSort::Sort(
+      &items, [](const std::pair<std::string, size_t>& item) -> const std::string& { return item.first; }, &lcp,
+      threads);
+
+  BOOST_CHECK(expected == items);
+  BOOST_REQUIRE_EQUAL(items.size(), lcp.size());
+
+  for (size_t i = 0; i < items.size(); ++i) {
+    size_t expected_lcp = 0;
+    if (i > 0) {
+      const std::string& a = items[i - 1].first;
+      const std::string& b = items[i].first;
+      while (expected_lcp < a.size() && expected_lcp < b.size() && a[expected_lcp] == b[expected_lcp]) {
+        ++expected_lcp;
+      }
+    }
+    BOOST_CHECK_EQUAL(expected_lcp, lcp[i]);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Simple) {
+  CheckSort({}, 1);
+  CheckSort({"a"}, 1);
+  CheckSort({"b", "a", "ab", "", "aa", "a", "abc", "\xff", "\x01", "ab"}, 1);
+}
+
+BOOST_AUTO_TEST_CASE(RandomKeys) {
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> length_distribution(0, 12);
+  std::uniform_int_distribution<int> char_distribution(0, 255);
+  std::uniform_int_distribution<int> small_char_distribution('a', 'd');
+
+  std::vector<std::string> keys;
+  for (size_t i = 0; i < 20000; ++i) {
+    std::string key;
+    const int length = length_distribution(generator);
+    for (int j = 0; j < length; ++j) {
+      key.push_back(static_cast<char>(i % 2 ? char_distribution(generator) : small_char_distribution(generator)));
+    }
+    keys.push_back(key);
+  }
+
+  CheckSort(keys, 1);
+  CheckSort(keys, 4);
+}
+
+BOOST_AUTO_TEST_CASE(LongSharedPrefixes) {
+  std::mt19937 generator(7);
+  std::uniform_int_distribution<int> distribution(0, 2000);
+
+  std::vector<std::string> keys;
+  const std::string prefix = "https://www.example.com/" + std::string(3000, 'x') + "/";
+  for (size_t i = 0; i < 5000; ++i) {
+    keys.push_back(prefix + std::to_string(distribution(generator)) + "/" + std::to_string(distribution(generator)));
+  }
+  keys.push_back(prefix);
+  keys.push_back(prefix);
+
+  CheckSort(keys, 1);
+  CheckSort(keys, 3);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
@@ -0,0 +1,90 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * traversal_budget_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <chrono>  // NOLINT
+#include <cstdint>
+
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/dictionary/util/traversal_budget.h"
+
+namespace keyvi {
+namespace dictionary {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(TraversalBudgetTests)
+
+BOOST_AUTO_TEST_CASE(Unlimited) {
+  TraversalBudget budget;
+  for (size_t i = 0; i < 10000; ++i) {
+    BOOST_CHECK(budget.VisitState());
+  }
+  BOOST_CHECK(!budget.IsTruncated());
+  BOOST_CHECK_EQUAL(10000, budget.GetVisitedStates());
+}
+
+BOOST_AUTO_TEST_CASE(MaxStates) {
+  TraversalBudget budget(3);
+  BOOST_CHECK(budget.VisitState());
+  BOOST_CHECK(budget.VisitState());
+  BOOST_CHECK(budget.VisitState());
+  BOOST_CHECK(!budget.IsTruncated());
+  BOOST_CHECK(!budget.VisitState());
+  BOOST_CHECK(budget.IsTruncated());
+
+  // stays exhausted
+  BOOST_CHECK(!budget.VisitState());
+  BOOST_CHECK_EQUAL(4, budget.GetVisitedStates());
+}
+
+BOOST_AUTO_TEST_CASE(Deadline) {
+  TraversalBudget budget;
+  budget.SetDeadline(std::chrono::steady_clock::now() - std::chrono::seconds(1));
+
+  // the deadline is checked on the first visit
+  BOOST_CHECK(!budget.VisitState());
+  BOOST_CHECK(budget.IsTruncated());
+
+  TraversalBudget budget_with_timeout(UINT64_MAX, std::chrono::hours(1));
+  for (size_t i = 0; i < 1000; ++i) {
+    BOOST_CHECK(budget_with_timeout.VisitState());
+  }
+  BOOST_CHECK(!budget_with_timeout.IsTruncated());
+
+  // expires while traversing, detected at the next check interval at the latest
+  budget_with_timeout.SetDeadline(std::chrono::steady_clock::now());
+  size_t visited = 0;
+  while (budget_with_timeout.VisitState()) {
+    ++visited;
+  }
+  BOOST_CHECK(budget_with_timeout.IsTruncated());
+  BOOST_CHECK_LE(visited, TRAVERSAL_BUDGET_DEADLINE_CHECK_INTERVAL);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace util */
+} /* namespace dictionary */
+} /* namespace keyvi */
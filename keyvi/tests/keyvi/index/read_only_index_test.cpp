@@ -229,6 +229,57 @@ BOOST_AUTO_TEST_CASE(fuzzyMatchingExactPrefix) {
   testFuzzyMatching(&reader_1, "ap", 1, 1, {"a"}, {"\"{a:1}\""});
 }
 
+void testPatternMatching(ReadOnlyIndex* reader, const std::string& pattern, const bool glob,
+                         const std::vector<std::string>& expected_matches,
+                         const std::vector<std::string>& expected_values) {
+  auto expected_matches_it = expected_matches.begin();
+  auto expected_values_it = expected_values.begin();
+
+  BOOST_CHECK_EQUAL(expected_matches.size(), expected_values.size());
+
+  auto matcher = glob ? reader->GetGlob(pattern) : reader->GetRegex(pattern);
+  for (auto m : matcher) {
+    BOOST_REQUIRE(expected_matches_it != expected_matches.end());
+    BOOST_CHECK_EQUAL(*expected_matches_it++, m.GetMatchedString());
+    BOOST_CHECK_EQUAL(*expected_values_it++, m.GetValueAsString());
+  }
+  BOOST_CHECK(expected_matches_it == expected_matches.end());
+}
+
+BOOST_AUTO_TEST_CASE(patternMatching) {
+  testing::IndexMock index;
+
+  std::vector<std::pair<std::string, std::string>> test_data = {{"abc", "{a:1}"},   {"abbc", "{b:2}"},
+                                                                {"abbcd", "{c:3}"}, {"abcde", "{a:1}"},
+                                                                {"abdd", "{b:3}"},  {"bbdd", "{f:2}"}};
+  index.AddSegment(&test_data);
+  std::vector<std::pair<std::string, std::string>> test_data_2 = {
+      {"abbcd", "{c:6}"}, {"abcde", "{x:1}"},  {"babc", "{a:1}"},
+      {"babbc", "{b:2}"}, {"babcde", "{a:1}"}, {"babdd", "{g:2}"},
+  };
+
+  index.AddSegment(&test_data_2);
+  ReadOnlyIndex reader_1(index.GetIndexFolder(), {{"refresh_interval", "400"}});
+
+  testPatternMatching(&reader_1, "ab*", true, {"abbc", "abbcd", "abc", "abcde", "abdd"},
+                      {"\"{b:2}\"", "\"{c:6}\"", "\"{a:1}\"", "\"{x:1}\"", "\"{b:3}\""});
+  testPatternMatching(&reader_1, "*dd", true, {"abdd", "babdd", "bbdd"}, {"\"{b:3}\"", "\"{g:2}\"", "\"{f:2}\""});
+  testPatternMatching(&reader_1, "b?b[cd]*", true, {"babc", "babcde", "babdd"},
+                      {"\"{a:1}\"", "\"{a:1}\"", "\"{g:2}\""});
+  testPatternMatching(&reader_1, "ab+c", false, {"abbc", "abc"}, {"\"{b:2}\"", "\"{a:1}\""});
+  testPatternMatching(&reader_1, "abc", false, {"abc"}, {"\"{a:1}\""});
+  testPatternMatching(&reader_1, "c.*", false, {}, {});
+
+  index.AddDeletedKeys({"abbcd", "abcde", "babbc"}, 1);
+  index.AddDeletedKeys({"abbcd", "bbdd"}, 0);
+
+  ReadOnlyIndex reader_2(index.GetIndexFolder(), {{"refresh_interval", "400"}});
+
+  testPatternMatching(&reader_2, "ab*", true, {"abbc", "abc", "abdd"}, {"\"{b:2}\"", "\"{a:1}\"", "\"{b:3}\""});
+  testPatternMatching(&reader_2, "*dd", true, {"abdd", "babdd"}, {"\"{b:3}\"", "\"{g:2}\""});
+  testPatternMatching(&reader_2, "bab+c", false, {"babc"}, {"\"{a:1}\""});
+}
+
 void testNearMatching(ReadOnlyIndex* reader, const std::string& query, const size_t minimum_exact_prefix,
                       const bool greedy, const std::vector<std::string>& expected_matches,
                       const std::vector<std::string>& expected_values) {
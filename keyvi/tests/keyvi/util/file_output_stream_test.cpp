@@ -0,0 +1,83 @@
+//
+// keyvi - A key value store.
+//
+// Copyright 2026 The keyvi authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+/*
+ * file_output_stream_test.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: keyvi authors
+ */
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "keyvi/util/file_output_stream.h"
+
+namespace keyvi {
+namespace util {
+
+BOOST_AUTO_TEST_SUITE(FileOutputStreamTests)
+
+BOOST_AUTO_TEST_CASE(AppendFile) {
+  boost::filesystem::path path = boost::filesystem::temp_directory_path();
+  path /= boost::filesystem::unique_path("file-output-stream-unittest-%%%%-%%%%-%%%%-%%%%");
+  boost::filesystem::create_directory(path);
+
+  boost::filesystem::path source = path / "source";
+  {
+    std::ofstream source_stream(source.native(), std::ios::binary);
+    source_stream << "0123456789";
+  }
+
+  boost::filesystem::path target = path / "target";
+  {
+    FileOutputStream out_stream(target.string());
+    BOOST_CHECK_EQUAL(target.string(), out_stream.GetFilename());
+
+    out_stream << "abc";
+    if (!out_stream.AppendFile(source, 5)) {
+      // in-kernel copy not supported, write it as caller would do
+      out_stream << "01234";
+    }
+    BOOST_CHECK_EQUAL(8, out_stream.tellp());
+
+    BOOST_CHECK(out_stream.AppendFile(source, 0));
+    out_stream << "xyz";
+  }
+
+  std::ifstream in_stream(target.native(), std::ios::binary);
+  std::stringstream content;
+  content << in_stream.rdbuf();
+  BOOST_CHECK_EQUAL("abc01234xyz", content.str());
+
+  boost::filesystem::remove_all(path);
+}
+
+BOOST_AUTO_TEST_CASE(OpenFails) {
+  BOOST_CHECK_THROW(FileOutputStream("/non/existing/directory/file"), std::invalid_argument);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} /* namespace util */
+} /* namespace keyvi */
@@ -26,6 +26,8 @@
 #include <cmath>
 #include <limits>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 
@@ -38,6 +40,94 @@ namespace util {
 
 BOOST_AUTO_TEST_SUITE(JsonValueTests)
 
+namespace {
+// the former encoding path: parse into a document and walk it
+std::string EncodeWithDocument(const std::string& raw_value, bool single_precision_float) {
+  msgpack::sbuffer msgpack_buffer;
+  rapidjson::Document json_document;
+  json_document.Parse<rapidjson::kParseNanAndInfFlag>(raw_value.c_str());
+
+  if (!json_document.HasParseError()) {
+    msgpack::packer<msgpack::sbuffer> packer(&msgpack_buffer);
+    JsonToMsgPack(json_document, &packer, single_precision_float);
+  } else {
+    msgpack::pack(&msgpack_buffer, raw_value);
+  }
+
+  return std::string(msgpack_buffer.data(), msgpack_buffer.size());
+}
+
+std::string EncodeWithHandler(const std::string& raw_value, bool single_precision_float) {
+  msgpack::sbuffer msgpack_buffer;
+  compression::buffer_t buffer;
+
+  // no compression, to compare the msgpack output
+  EncodeJsonValue(static_cast<void (*)(compression::buffer_t*, const char*, size_t)>(
+                      &compression::RawCompressionStrategy::DoCompress),
+                  static_cast<void (*)(compression::buffer_t*, const char*, size_t)>(
+                      &compression::RawCompressionStrategy::DoCompress),
+                  &msgpack_buffer, &buffer, raw_value, single_precision_float);
+
+  return std::string(msgpack_buffer.data(), msgpack_buffer.size());
+}
+
+std::string JsonArray(size_t size, const std::string& element) {
+  std::string json = "[";
+  for (size_t i = 0; i < size; ++i) {
+    json += (i > 0 ? "," : "") + element;
+  }
+  return json + "]";
+}
+
+std::string JsonObject(size_t size, const std::string& value) {
+  std::string json = "{";
+  for (size_t i = 0; i < size; ++i) {
+    json += (i > 0 ? ",\"k" : "\"k") + std::to_string(i) + "\":" + value;
+  }
+  return json + "}";
+}
+}  // namespace
+
+BOOST_AUTO_TEST_CASE(SameBytesAsDocument) {
+  std::vector<std::string> inputs = {
+      "{\"hello\":\"world\",\"t\":true,\"f\":false,\"n\":null,\"i\":123,\"j\":-123,\"pi\":3.14159}",
+      "{\"a\":{\"b\":{\"c\":[[],{},[{}],\"\\u00e4\\n\"]}},\"a\":2}",
+      "[0,-1,2147483647,2147483648,-2147483649,4294967296,9223372036854775807,-9223372036854775808]",
+      "[18446744073709551615,18446744073709551616,1e400,-1e400,1.0,-0.0,1e-40,-1.5,3.5e38,3.4e38]",
+      "[NaN,Inf,-Infinity,1.17549435e-38,1.1754942e-38]",
+      "42",
+      "-7",
+      "2.5",
+      "\"a string\"",
+      "true",
+      "null",
+      "  {\"x\" : [ 1 , 2 ] }  ",
+      // no json
+      "",
+      "a string",
+      "{\"a\":1",
+      "[1,2] trailing",
+      "{\"a\":[1,2,{\"b\":",
+      JsonArray(15, "1"),
+      JsonArray(16, "1"),
+      JsonArray(65535, "1"),
+      JsonArray(65536, "1"),
+      JsonObject(15, "\"v\""),
+      JsonObject(16, "\"v\""),
+      JsonObject(65536, "true"),
+      JsonArray(20, JsonObject(20, JsonArray(17, "0.5"))),
+      "[" + JsonArray(70000, "1") + "," + JsonObject(3, JsonArray(16, "null")) + "]",
+      "[" + JsonArray(70000, "1") + ",1,2",
+  };
+
+  for (const std::string& input : inputs) {
+    for (bool single_precision_float : {false, true}) {
+      BOOST_CHECK(EncodeWithDocument(input, single_precision_float) ==
+                  EncodeWithHandler(input, single_precision_float));
+    }
+  }
+}
+
 BOOST_AUTO_TEST_CASE(EncodeDecodeTest) {
   std::string input =
       "{\"hello\":\"world\",\"t\":true,\"f\":false,\"n\":null,\"i\":123,\"j\":-123,\"pi\":3.1415998935699463,\"a\":[1,"
@@ -18,7 +18,14 @@ cdef extern from "keyvi/dictionary/dictionary.h" namespace "keyvi::dictionary":
         populate_lazy, # load data lazy but ask the OS to read ahead if possible (does not block)
         lazy_no_readahead, # disable any read-ahead (for cases when index > x * main memory)
         lazy_no_readahead_value_part, # disable read-ahead only for the value part
-        populate_key_part_no_readahead_value_part # populate the key part, but disable read ahead value part
+        populate_key_part_no_readahead_value_part, # populate the key part, but disable read ahead value part
+        lazy_access_profile, # load data lazy, but read ahead the pages recorded in the page access profile (if available)
+        populate_background, # load data lazy, but populate everything on background threads (does not block)
+        populate_key_part_locked, # populate the key part and lock it in memory (mlock), load value part lazy
+        populate_locked, # populate key and value part and lock both in memory (mlock)
+        anonymous_key_part, # copy the key part into anonymous memory placed according to the numa_node parameter
+        pread_value_part, # load the key part lazy, read the value part using pread through a page cache
+        pread # read the key part into memory using pread, read the value part through a page cache
         
     cdef cppclass Dictionary:
         # wrap-doc:
@@ -37,6 +44,8 @@ cdef extern from "keyvi/dictionary/dictionary.h" namespace "keyvi::dictionary":
         _MatchIteratorPair GetNear (libcpp_utf8_string key, size_t minimum_prefix_length, bool greedy) except + # wrap-as:match_near
         _MatchIteratorPair GetFuzzy (libcpp_utf8_string key, int32_t max_edit_distance) except + # wrap-as:match_fuzzy
         _MatchIteratorPair GetFuzzy (libcpp_utf8_string key, int32_t max_edit_distance, size_t minimum_exact_prefix) except + # wrap-as:match_fuzzy
+        _MatchIteratorPair GetRegex (libcpp_utf8_string pattern) except + # wrap-as:match_regex
+        _MatchIteratorPair GetGlob (libcpp_utf8_string pattern) except + # wrap-as:match_glob
         _MatchIteratorPair GetPrefixCompletion (libcpp_utf8_string key) except + # wrap-as:complete_prefix
         # wrap-doc:
         #  Complete the given key to full matches(prefix matching)
@@ -17,6 +17,8 @@ cdef extern from "keyvi/index/index.h" namespace "keyvi::index":
         _MatchIteratorPair GetNear (libcpp_utf8_string, size_t minimum_prefix_length) except +
         _MatchIteratorPair GetNear (libcpp_utf8_string, size_t minimum_prefix_length, bool greedy) except +
         _MatchIteratorPair GetFuzzy(libcpp_utf8_string, int32_t max_edit_distance, size_t minimum_exact_prefix) except +
+        _MatchIteratorPair GetRegex(libcpp_utf8_string) except +
+        _MatchIteratorPair GetGlob(libcpp_utf8_string) except +
         void Delete(libcpp_utf8_string) except+
         void Flush() except+
         void Flush(bool) except+